@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/async_file_writer.hpp"
+#include <cstdlib>
+#include <thread>
+
+// Usage: bench_async_file_writer [disk bandwidth in MiB/s]
+
+static std::size_t const RECORD_SIZE = 256;
+static std::size_t const RECORD_COUNT = 20000;
+
+/**
+ * Emulates slow disk: each write call costs fixed latency plus transfer time
+ * at the configured bandwidth. Data is discarded.
+ */
+class throttled_device : public pfs::io::basic_device
+{
+    double _bytes_per_second;
+    std::chrono::microseconds _latency;
+
+public:
+    throttled_device (double bytes_per_second, std::chrono::microseconds latency)
+        : _bytes_per_second(bytes_per_second)
+        , _latency(latency)
+    {}
+
+    pfs::io::device_type type () const noexcept override
+    {
+        return pfs::io::device_type::file;
+    }
+
+    pfs::io::open_mode_flags open_mode () const noexcept override
+    {
+        return pfs::io::write_only;
+    }
+
+    bool has_pending_data () noexcept override
+    {
+        return false;
+    }
+
+    ssize_t read (char *, size_t, pfs::io::error_code & ec) noexcept override
+    {
+        ec = pfs::io::make_error_code(pfs::io::errc::invalid_argument);
+        return -1;
+    }
+
+    ssize_t write (char const *, size_t n, pfs::io::error_code &) noexcept override
+    {
+        std::this_thread::sleep_for(_latency
+            + std::chrono::microseconds{static_cast<long>(n * 1e6 / _bytes_per_second)});
+        return static_cast<ssize_t>(n);
+    }
+
+    ssize_t writev (pfs::io::io_vector const * iov, int iovcnt, pfs::io::error_code & ec) noexcept override
+    {
+        size_t n = 0;
+
+        for (int i = 0; i < iovcnt; i++)
+            n += iov[i].iov_len;
+
+        // Single request regardless of number of buffers
+        return write(nullptr, n, ec);
+    }
+
+    pfs::io::error_code close () override
+    {
+        return pfs::io::error_code{};
+    }
+
+    bool opened () const noexcept override
+    {
+        return true;
+    }
+};
+
+template <typename Write>
+static void bench_producer (std::string const & name, Write && write)
+{
+    std::string record(RECORD_SIZE, 'x');
+    record.back() = '\n';
+
+    std::vector<double> latencies;
+    latencies.reserve(RECORD_COUNT);
+    auto start = bench_clock::now();
+
+    for (std::size_t i = 0; i < RECORD_COUNT; i++) {
+        auto t0 = bench_clock::now();
+        write(record);
+        latencies.push_back(elapsed_seconds(t0) * 1e6);
+
+        // Producer does some work between records
+        std::this_thread::sleep_for(std::chrono::microseconds{10});
+    }
+
+    report(name + " producer total", elapsed_seconds(start) * 1e3, "ms");
+    report(name + " write latency p50", percentile(latencies, 0.5), "us");
+    report(name + " write latency p99", percentile(latencies, 0.99), "us");
+    report(name + " write latency max", percentile(latencies, 1.0), "us");
+}
+
+int main (int argc, char * argv[])
+{
+    double mib_per_second = argc > 1 ? std::strtod(argv[1], nullptr) : 20;
+    double bandwidth = mib_per_second * 1024 * 1024;
+    auto latency = std::chrono::microseconds{200};
+
+    {
+        throttled_device d {bandwidth, latency};
+        pfs::io::error_code ec;
+
+        bench_producer("synchronous", [& d, & ec] (std::string const & r) {
+            d.write(r.data(), r.size(), ec);
+        });
+    }
+
+    for (auto policy: {pfs::io::overflow_policy::block, pfs::io::overflow_policy::drop}) {
+        pfs::io::async_writer_options options;
+        options.buffer_size = 64 * 1024;
+        options.buffer_count = 4;
+        options.policy = policy;
+
+        auto name = std::string{"async ("}
+            + (policy == pfs::io::overflow_policy::block ? "block" : "drop") + ")";
+
+        pfs::io::async_file_writer w {
+              pfs::io::device{new throttled_device{bandwidth, latency}}
+            , options};
+
+        bench_producer(name, [& w] (std::string const & r) {
+            pfs::io::error_code ec;
+            w.write(r.data(), r.size(), ec);
+        });
+
+        w.close();
+        report(name + " dropped", static_cast<double>(w.dropped_bytes()), "bytes");
+    }
+
+    return 0;
+}
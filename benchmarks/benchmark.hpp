@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+
+// Keeps the optimizer from discarding a value computed by benchmarked code
+template <typename T>
+inline void do_not_optimize (T const & value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline double elapsed_seconds (bench_clock::time_point start)
+{
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+/**
+ * Calls @a f @a iterations times and returns mean time per call in nanoseconds.
+ */
+template <typename F>
+inline double measure_ns_per_call (std::size_t iterations, F && f)
+{
+    auto start = bench_clock::now();
+
+    for (std::size_t i = 0; i < iterations; i++)
+        f();
+
+    return elapsed_seconds(start) * 1e9 / static_cast<double>(iterations);
+}
+
+/**
+ * Returns @a p-th percentile (0.0 .. 1.0) of @a samples.
+ */
+inline double percentile (std::vector<double> samples, double p)
+{
+    if (samples.empty())
+        return 0;
+
+    auto index = static_cast<std::size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+inline void report (std::string const & name, double value, char const * unit)
+{
+    std::printf("%-48s %14.2f %s\n", name.c_str(), value, unit);
+}
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/binary_stream.hpp"
+#include "pfs/io/buffer.hpp"
+#include "pfs/io/file.hpp"
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// Usage: bench_binary_stream [message count]
+
+struct order
+{
+    std::uint32_t id;
+    std::uint64_t timestamp;
+    double price;
+    std::int64_t delta;
+    std::uint32_t quantity;
+    std::string symbol;
+};
+
+/**
+ * Discards written data, counts bytes.
+ */
+class sink_device : public pfs::io::basic_device
+{
+public:
+    std::size_t bytes {0};
+
+    pfs::io::device_type type () const noexcept override
+    {
+        return pfs::io::device_type::buffer;
+    }
+
+    pfs::io::open_mode_flags open_mode () const noexcept override
+    {
+        return pfs::io::write_only;
+    }
+
+    bool has_pending_data () noexcept override
+    {
+        return false;
+    }
+
+    ssize_t read (char *, size_t, pfs::io::error_code & ec) noexcept override
+    {
+        ec = pfs::io::make_error_code(pfs::io::errc::invalid_argument);
+        return -1;
+    }
+
+    ssize_t write (char const * data, size_t n, pfs::io::error_code &) noexcept override
+    {
+        do_not_optimize(data);
+        bytes += n;
+        return static_cast<ssize_t>(n);
+    }
+
+    pfs::io::error_code close () override
+    {
+        return pfs::io::error_code{};
+    }
+
+    bool opened () const noexcept override
+    {
+        return true;
+    }
+};
+
+static std::uint64_t to_be64 (std::uint64_t v)
+{
+    return (static_cast<std::uint64_t>(htonl(static_cast<std::uint32_t>(v))) << 32)
+        | htonl(static_cast<std::uint32_t>(v >> 32));
+}
+
+// What callers do now: convert each field and write it to device
+static void write_hand_rolled (pfs::io::device & d, order const & o, pfs::io::error_code & ec)
+{
+    std::uint32_t u32 = htonl(o.id);
+    d.write(reinterpret_cast<char const *>(& u32), 4, ec);
+
+    std::uint64_t u64 = to_be64(o.timestamp);
+    d.write(reinterpret_cast<char const *>(& u64), 8, ec);
+
+    std::memcpy(& u64, & o.price, 8);
+    u64 = to_be64(u64);
+    d.write(reinterpret_cast<char const *>(& u64), 8, ec);
+
+    u64 = to_be64(static_cast<std::uint64_t>(o.delta));
+    d.write(reinterpret_cast<char const *>(& u64), 8, ec);
+
+    u32 = htonl(o.quantity);
+    d.write(reinterpret_cast<char const *>(& u32), 4, ec);
+
+    u32 = htonl(static_cast<std::uint32_t>(o.symbol.size()));
+    d.write(reinterpret_cast<char const *>(& u32), 4, ec);
+    d.write(o.symbol.data(), o.symbol.size(), ec);
+}
+
+// Fields are serialized into a string stream, message is written at once
+static void write_iostream (pfs::io::device & d, std::ostringstream & os
+    , order const & o, pfs::io::error_code & ec)
+{
+    os.str(std::string{});
+
+    std::uint32_t u32 = htonl(o.id);
+    os.write(reinterpret_cast<char const *>(& u32), 4);
+
+    std::uint64_t u64 = to_be64(o.timestamp);
+    os.write(reinterpret_cast<char const *>(& u64), 8);
+
+    std::memcpy(& u64, & o.price, 8);
+    u64 = to_be64(u64);
+    os.write(reinterpret_cast<char const *>(& u64), 8);
+
+    u64 = to_be64(static_cast<std::uint64_t>(o.delta));
+    os.write(reinterpret_cast<char const *>(& u64), 8);
+
+    u32 = htonl(o.quantity);
+    os.write(reinterpret_cast<char const *>(& u32), 4);
+
+    u32 = htonl(static_cast<std::uint32_t>(o.symbol.size()));
+    os.write(reinterpret_cast<char const *>(& u32), 4);
+    os.write(o.symbol.data(), o.symbol.size());
+
+    auto s = os.str();
+    d.write(s.data(), s.size(), ec);
+}
+
+template <typename Writer>
+static void write_binary_writer (Writer & w, order const & o, pfs::io::error_code & ec)
+{
+    w.write(o.id)
+        .write(o.timestamp)
+        .write(o.price)
+        .write_zigzag(o.delta)
+        .write_varint(o.quantity)
+        .write_string(o.symbol)
+        .flush(ec);
+}
+
+static void read_binary_reader (pfs::io::binary_reader & r, order & o)
+{
+    std::uint64_t quantity = 0;
+    r.read(o.id);
+    r.read(o.timestamp);
+    r.read(o.price);
+    r.read_zigzag(o.delta);
+    r.read_varint(quantity);
+    r.read_string(o.symbol);
+    o.quantity = static_cast<std::uint32_t>(quantity);
+}
+
+static void read_hand_rolled (pfs::io::device & d, order & o, pfs::io::error_code & ec)
+{
+    std::uint32_t u32 = 0;
+    std::uint64_t u64 = 0;
+
+    d.read(reinterpret_cast<char *>(& u32), 4, ec);
+    o.id = ntohl(u32);
+
+    d.read(reinterpret_cast<char *>(& u64), 8, ec);
+    o.timestamp = to_be64(u64);
+
+    d.read(reinterpret_cast<char *>(& u64), 8, ec);
+    u64 = to_be64(u64);
+    std::memcpy(& o.price, & u64, 8);
+
+    d.read(reinterpret_cast<char *>(& u64), 8, ec);
+    o.delta = static_cast<std::int64_t>(to_be64(u64));
+
+    d.read(reinterpret_cast<char *>(& u32), 4, ec);
+    o.quantity = ntohl(u32);
+
+    d.read(reinterpret_cast<char *>(& u32), 4, ec);
+    o.symbol.resize(ntohl(u32));
+    d.read(& o.symbol[0], o.symbol.size(), ec);
+}
+
+template <typename F>
+static void bench (std::string const & name, std::size_t count, F && f)
+{
+    auto start = bench_clock::now();
+
+    for (std::size_t i = 0; i < count; i++)
+        f(i);
+
+    auto seconds = elapsed_seconds(start);
+    report(name, count / seconds / 1e6, "M msg/s");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+
+    order o {42, 1700000000000ULL, 101.25, -3, 100, "AAPL"};
+    pfs::io::error_code ec;
+
+    // Every device write is a system call
+    {
+        auto d = pfs::io::make_file("/dev/null", pfs::io::write_only, ec);
+
+        bench("hand-rolled (/dev/null)", count / 10, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_hand_rolled(d, o, ec);
+        });
+    }
+
+    {
+        auto d = pfs::io::make_file("/dev/null", pfs::io::write_only, ec);
+        pfs::io::binary_writer w {d};
+
+        bench("binary_writer (/dev/null)", count / 10, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_binary_writer(w, o, ec);
+        });
+    }
+
+    // Serialization cost only
+    {
+        pfs::io::device d {new sink_device};
+
+        bench("hand-rolled (write per field)", count, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_hand_rolled(d, o, ec);
+        });
+    }
+
+    {
+        pfs::io::device d {new sink_device};
+        std::ostringstream os;
+
+        bench("std::ostringstream (write per message)", count, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_iostream(d, os, o, ec);
+        });
+    }
+
+    {
+        pfs::io::device d {new sink_device};
+        pfs::io::binary_writer w {d};
+
+        bench("binary_writer (device)", count, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_binary_writer(w, o, ec);
+        });
+    }
+
+    {
+        sink_device d;
+        pfs::io::basic_binary_writer<sink_device> w {d};
+
+        bench("binary_writer (static type)", count, [&] (std::size_t i) {
+            o.id = static_cast<std::uint32_t>(i);
+            write_binary_writer(w, o, ec);
+        });
+    }
+
+    // Reading
+    {
+        std::string data;
+
+        {
+            auto d = pfs::io::make_buffer(data, pfs::io::write_only);
+
+            for (std::size_t i = 0; i < count; i++)
+                write_hand_rolled(d, o, ec);
+        }
+
+        auto d = pfs::io::make_buffer(data, pfs::io::read_only);
+        order result;
+
+        bench("hand-rolled read (read per field)", count, [&] (std::size_t) {
+            read_hand_rolled(d, result, ec);
+            do_not_optimize(result.id);
+        });
+    }
+
+    {
+        std::string data;
+
+        {
+            auto d = pfs::io::make_buffer(data, pfs::io::write_only);
+            pfs::io::binary_writer w {d};
+
+            for (std::size_t i = 0; i < count; i++)
+                write_binary_writer(w, o, ec);
+        }
+
+        auto d = pfs::io::make_buffer(data, pfs::io::read_only);
+        pfs::io::binary_reader r {d};
+        order result;
+
+        bench("binary_reader", count, [&] (std::size_t) {
+            read_binary_reader(r, result);
+            do_not_optimize(result.id);
+        });
+    }
+
+    return 0;
+}
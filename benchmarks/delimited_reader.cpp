@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "utils.hpp"
+#include "pfs/io/delimited_reader.hpp"
+#include <cstdlib>
+#include <cstring>
+
+// Usage: bench_delimited_reader [total size in MiB]
+
+/**
+ * Endless loremipsum: serves the fixture repeatedly until the total size is
+ * reached, so the scaled input does not have to be kept in memory.
+ */
+class repeat_device : public pfs::io::basic_device
+{
+    std::string _pattern;
+    std::size_t _remain;
+    std::size_t _pos {0};
+
+public:
+    repeat_device (std::string const & sample, std::size_t total)
+        : _remain(total)
+    {
+        // Large pattern makes memcpy chunks long
+        while (_pattern.size() < 1024 * 1024)
+            _pattern += sample;
+    }
+
+    pfs::io::device_type type () const noexcept override
+    {
+        return pfs::io::device_type::buffer;
+    }
+
+    pfs::io::open_mode_flags open_mode () const noexcept override
+    {
+        return pfs::io::read_only;
+    }
+
+    bool has_pending_data () noexcept override
+    {
+        return _remain > 0;
+    }
+
+    ssize_t read (char * bytes, size_t n, pfs::io::error_code &) noexcept override
+    {
+        n = std::min(std::min(n, _remain), _pattern.size() - _pos);
+        std::memcpy(bytes, _pattern.data() + _pos, n);
+        _pos = (_pos + n) % _pattern.size();
+        _remain -= n;
+        return static_cast<ssize_t>(n);
+    }
+
+    ssize_t write (char const *, size_t, pfs::io::error_code & ec) noexcept override
+    {
+        ec = pfs::io::make_error_code(pfs::io::errc::invalid_argument);
+        return -1;
+    }
+
+    pfs::io::error_code close () override
+    {
+        return pfs::io::error_code{};
+    }
+
+    bool opened () const noexcept override
+    {
+        return true;
+    }
+};
+
+// What the parsers do now: read a block and scan it byte by byte
+static void bench_naive (std::size_t total)
+{
+    pfs::io::device d {new repeat_device{loremipsum, total}};
+    std::vector<char> buf(64 * 1024);
+    std::string partial;
+    std::size_t records = 0;
+    std::size_t bytes = 0;
+    pfs::io::error_code ec;
+    auto start = bench_clock::now();
+    ssize_t n = 0;
+
+    while ((n = d.read(buf.data(), buf.size(), ec)) > 0) {
+        std::size_t begin = 0;
+
+        for (ssize_t i = 0; i < n; i++) {
+            if (buf[i] == '\n') {
+                partial.append(buf.data() + begin, i - begin);
+                bytes += partial.size();
+                do_not_optimize(partial.data());
+                partial.clear();
+                records++;
+                begin = i + 1;
+            }
+        }
+
+        partial.append(buf.data() + begin, n - begin);
+    }
+
+    auto seconds = elapsed_seconds(start);
+    do_not_optimize(bytes);
+    report("naive loop", total / seconds / 1e9, "GB/s");
+    report("naive loop records", static_cast<double>(records), "");
+}
+
+static void bench_reader (std::string const & name, pfs::io::simd_isa isa, std::size_t total)
+{
+    pfs::io::device d {new repeat_device{loremipsum, total}};
+    pfs::io::delimited_reader_options options;
+    options.isa = isa;
+
+    pfs::io::delimited_reader reader {d, options};
+    pfs::io::bytes_view record;
+    std::size_t records = 0;
+    std::size_t bytes = 0;
+    auto start = bench_clock::now();
+
+    while (reader.read_record(record)) {
+        bytes += record.size();
+        do_not_optimize(record.data());
+        records++;
+    }
+
+    auto seconds = elapsed_seconds(start);
+    do_not_optimize(bytes);
+    report("delimited_reader (" + name + ")", total / seconds / 1e9, "GB/s");
+    report("delimited_reader (" + name + ") records", static_cast<double>(records), "");
+}
+
+// Kernel alone over in-memory data
+static void bench_kernel (std::string const & name, pfs::io::simd_isa isa, std::size_t total)
+{
+    std::string data;
+
+    while (data.size() < 16 * 1024 * 1024)
+        data += loremipsum;
+
+    auto find = pfs::io::details::select_find_byte(isa);
+    std::size_t found = 0;
+    std::size_t scanned = 0;
+    auto start = bench_clock::now();
+
+    while (scanned < total) {
+        char const * first = data.data();
+        auto last = first + data.size();
+
+        while ((first = find(first, last, '\n')) != last) {
+            found++;
+            first++;
+        }
+
+        scanned += data.size();
+    }
+
+    auto seconds = elapsed_seconds(start);
+    do_not_optimize(found);
+    report("find_byte (" + name + ")", scanned / seconds / 1e9, "GB/s");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t total_mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    std::size_t total = total_mib * 1024 * 1024;
+
+    struct {
+        char const * name;
+        pfs::io::simd_isa isa;
+    } variants[] = {
+          {"scalar", pfs::io::simd_isa::scalar}
+        , {"sse2"  , pfs::io::simd_isa::sse2}
+        , {"avx2"  , pfs::io::simd_isa::avx2}
+    };
+
+    bench_naive(total);
+
+    for (auto const & v: variants) {
+        if (!pfs::io::simd_isa_supported(v.isa))
+            continue;
+
+        bench_reader(v.name, v.isa, total);
+    }
+
+    for (auto const & v: variants) {
+        if (!pfs::io::simd_isa_supported(v.isa))
+            continue;
+
+        bench_kernel(v.name, v.isa, total);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "utils.hpp"
+#include "pfs/io/aligned_allocator.hpp"
+#include "pfs/io/file.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <sys/mman.h>
+
+// Usage: bench_direct_io [total size in MiB]
+
+static std::size_t const CHUNK_SIZE = 1024 * 1024;
+
+// Returns fraction of file pages resident in page cache
+static double page_cache_residency (std::string const & path)
+{
+    auto d = pfs::io::make_file(path, pfs::io::read_only);
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    pfs::io::error_code ec;
+    auto size = static_cast<std::size_t>(f->seek(0, pfs::io::seek_origin::end, ec));
+
+    if (size == 0)
+        return 0;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    void * addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (addr == MAP_FAILED)
+        return -1;
+
+    auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> pages((size + page_size - 1) / page_size);
+    std::size_t resident = 0;
+
+    if (::mincore(addr, size, pages.data()) == 0) {
+        for (auto p: pages)
+            resident += p & 1;
+    }
+
+    ::munmap(addr, size);
+    return static_cast<double>(resident) / pages.size();
+}
+
+static void bench_write (std::string const & name
+    , std::string const & path
+    , pfs::io::open_mode_flags oflags
+    , std::size_t total)
+{
+    pfs::io::error_code ec;
+    auto d = pfs::io::make_file(path, pfs::io::write_only | pfs::io::truncate | oflags
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::data_sync
+        , ec);
+
+    if (ec) {
+        std::cerr << "ERROR: " << name << ": " << path << ": " << ec.message() << "\n";
+        return;
+    }
+
+    pfs::io::aligned_buffer<4096> chunk(CHUNK_SIZE, 'x');
+    auto start = bench_clock::now();
+
+    for (std::size_t written = 0; written < total; written += CHUNK_SIZE) {
+        if (d.write(chunk.data(), chunk.size(), ec) < 0) {
+            std::cerr << "ERROR: " << name << ": write: " << ec.message() << "\n";
+            return;
+        }
+    }
+
+    // Include flush time, otherwise buffered writes only measure memcpy
+    d.close();
+
+    auto seconds = elapsed_seconds(start);
+    report(name + " throughput", total / seconds / (1024 * 1024), "MiB/s");
+    report(name + " page cache residency", 100 * page_cache_residency(path), "%");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t total_mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    std::size_t total = total_mib * 1024 * 1024;
+    std::string path = tmp_dir() + "/pfs_bench_direct_io.bin";
+
+    bench_write("buffered write", path, 0, total);
+    bench_write("direct write", path, pfs::io::direct, total);
+
+    ::unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/fec.hpp"
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Usage: bench_fec [packets in thousands]
+
+static void bench_kernels ()
+{
+    std::size_t const size = 1200;
+    std::size_t const rounds = 200000;
+    std::string src(size, 'x');
+    std::string dst(size, 'y');
+
+    struct {
+        char const * name;
+        pfs::io::simd_isa isa;
+    } variants[] = {
+          {"scalar", pfs::io::simd_isa::scalar}
+        , {"ssse3" , pfs::io::simd_isa::ssse3}
+        , {"avx2"  , pfs::io::simd_isa::avx2}
+    };
+
+    for (auto const & v: variants) {
+        if (!pfs::io::simd_isa_supported(v.isa))
+            continue;
+
+        auto kernels = pfs::io::details::select_gf256_kernels(v.isa);
+        auto start = bench_clock::now();
+
+        for (std::size_t i = 0; i < rounds; i++)
+            kernels.mul_add_region(static_cast<std::uint8_t>(i | 2), & src[0], & dst[0], size);
+
+        auto seconds = elapsed_seconds(start);
+        do_not_optimize(dst.data());
+        report(std::string{"GF(2^8) multiply-add ("} + v.name + ")", rounds * size / seconds / 1e9, "GB/s");
+    }
+}
+
+static void bench_code (char const * name, std::size_t source_count, std::size_t repair_count
+    , std::size_t count)
+{
+    pfs::io::fec_options options;
+    options.source_count = source_count;
+    options.repair_count = repair_count;
+
+    std::string payload(options.max_payload, 'p');
+    std::vector<std::string> packets;
+    packets.reserve(count + count / source_count * repair_count + repair_count);
+    pfs::io::error_code ec;
+
+    pfs::io::fec_encoder encoder {options};
+    auto send = [& packets] (char const * data, std::size_t n, pfs::io::error_code &) {
+        packets.emplace_back(data, n);
+        return true;
+    };
+
+    // Encoding includes packet copies made by the callback
+    auto start = bench_clock::now();
+
+    for (std::size_t i = 0; i < count; i++)
+        encoder.encode(payload.data(), payload.size(), send, ec);
+
+    auto seconds = elapsed_seconds(start);
+    report(std::string{name} + ": encode", count * payload.size() / seconds / 1e6, "MB/s");
+
+    for (double loss: {0.01, 0.05, 0.1}) {
+        std::mt19937 gen {7};
+        std::bernoulli_distribution drop {loss};
+        std::vector<std::string const *> lossy;
+        std::size_t lost = 0;
+
+        for (std::size_t i = 0; i < packets.size(); i++) {
+            if (drop(gen)) {
+                if (i % (source_count + repair_count) < source_count)
+                    lost++;
+            } else {
+                lossy.push_back(& packets[i]);
+            }
+        }
+
+        pfs::io::fec_decoder decoder {options};
+        std::size_t delivered = 0;
+        auto deliver = [& delivered] (char const *, std::size_t n) { delivered += n; };
+
+        start = bench_clock::now();
+
+        for (auto p: lossy)
+            decoder.decode(p->data(), p->size(), deliver, ec);
+
+        seconds = elapsed_seconds(start);
+
+        auto percent = std::to_string(static_cast<int>(loss * 100)) + "% loss";
+        report(std::string{name} + ": decode (" + percent + ")", delivered / seconds / 1e6, "MB/s");
+        report(std::string{name} + ": recovered losses (" + percent + ")"
+            , lost > 0 ? 100.0 * decoder.stats().recovered / lost : 100, "%");
+    }
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200) * 1000;
+
+    bench_kernels();
+    bench_code("XOR 8+1", 8, 1, count);
+    bench_code("Reed-Solomon 10+4", 10, 4, count);
+    bench_code("Reed-Solomon 20+4", 20, 4, count);
+    return 0;
+}
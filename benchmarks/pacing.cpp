@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/pacing.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Usage: bench_pacing [milliseconds per run]
+//
+// Kernel modes pace only with fq queueing discipline on the interface
+// (loopback has none by default, try `tc qdisc replace dev lo root fq`),
+// otherwise they send bursts bounded by kernel_horizon.
+
+static std::size_t const datagram_size = 1200;
+
+struct variant
+{
+    char const * name;
+    pfs::io::pacing_mode mode;
+    std::size_t burst;
+};
+
+static void bench (variant const & v, std::uint64_t rate, std::size_t millis, std::uint16_t port)
+{
+    auto count = static_cast<std::size_t>(rate * millis / 1000 / datagram_size);
+    auto server = pfs::io::make_udp_server("127.0.0.1", port, false);
+    auto client = pfs::io::make_static_udp_socket("127.0.0.1", port, false);
+    std::vector<bench_clock::time_point> arrivals;
+    arrivals.reserve(count);
+
+    // Receiver stops after one second of silence
+    std::thread receiver {[&] {
+        char buf[2048];
+        pfs::io::error_code ec;
+
+        while (arrivals.size() < count && server.wait_for_read(std::chrono::milliseconds{1000}, ec)) {
+            if (server.read(buf, sizeof(buf), ec) > 0)
+                arrivals.push_back(bench_clock::now());
+        }
+    }};
+
+    pfs::io::pacing_options options;
+    options.rate = rate;
+    options.burst = v.burst;
+    options.mode = v.mode;
+
+    pfs::io::basic_paced_device<pfs::io::udp_socket> paced {client.underlying(), options};
+    std::string datagram(datagram_size, 'p');
+    pfs::io::error_code ec;
+
+    auto start = bench_clock::now();
+
+    for (std::size_t i = 0; i < count; i++)
+        paced.write(datagram.data(), datagram.size(), ec);
+
+    auto send_seconds = elapsed_seconds(start);
+    receiver.join();
+
+    auto name = std::string{v.name} + " " + std::to_string(rate / 1000000) + " MB/s";
+
+    if (paced.mode() != v.mode)
+        name += " (fallback)";
+
+    report(name + ": send rate", (count - 1) * datagram_size / send_seconds / 1e6, "MB/s");
+
+    if (arrivals.size() < 2) {
+        report(name + ": received", 100.0 * arrivals.size() / count, "%");
+        return;
+    }
+
+    auto receive_seconds = std::chrono::duration<double>(arrivals.back() - arrivals.front()).count();
+    auto ideal = static_cast<double>(datagram_size) / rate;
+    std::vector<double> jitter;
+    jitter.reserve(arrivals.size());
+
+    for (std::size_t i = 1; i < arrivals.size(); i++) {
+        auto interval = std::chrono::duration<double>(arrivals[i] - arrivals[i - 1]).count();
+        jitter.push_back(std::fabs(interval - ideal) * 1e6);
+    }
+
+    report(name + ": receive rate", (arrivals.size() - 1) * datagram_size / receive_seconds / 1e6, "MB/s");
+    report(name + ": received", 100.0 * arrivals.size() / count, "%");
+    report(name + ": interval jitter p50", percentile(jitter, 0.5), "us");
+    report(name + ": interval jitter p99", percentile(jitter, 0.99), "us");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t millis = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    std::uint16_t port = 42110;
+
+    variant variants[] = {
+          {"userspace, burst 1"  , pfs::io::pacing_mode::userspace      , datagram_size}
+        , {"userspace"           , pfs::io::pacing_mode::userspace      , 0}
+        , {"userspace, burst 16" , pfs::io::pacing_mode::userspace      , 16 * datagram_size}
+        , {"SO_MAX_PACING_RATE"  , pfs::io::pacing_mode::max_pacing_rate, 0}
+        , {"SO_TXTIME"           , pfs::io::pacing_mode::txtime         , 0}
+    };
+
+    for (std::uint64_t rate: {1000000ull, 10000000ull, 100000000ull}) {
+        for (auto const & v: variants)
+            bench(v, rate, millis, port++);
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/rudp.hpp"
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Usage: bench_rudp [megabytes per run]
+
+static std::string const SERVER_ADDR {"127.0.0.1"};
+
+static pfs::io::rudp_options make_options (double loss, std::uint32_t seed)
+{
+    pfs::io::rudp_options options;
+    options.impairment.loss = loss;
+    options.impairment.seed = seed;
+    return options;
+}
+
+static std::string loss_name (double loss)
+{
+    return std::to_string(static_cast<int>(loss * 100)) + "% loss";
+}
+
+// One-way bulk transfer, goodput is measured by receiver
+static void bench_goodput (double loss, std::size_t total_bytes, std::uint16_t port)
+{
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, port, make_options(loss, 1));
+    double seconds = 0;
+    std::size_t received = 0;
+
+    std::thread receiver {[&] {
+        auto d = server.accept(std::chrono::milliseconds{5000});
+        std::vector<char> buf(64 * 1024);
+        pfs::io::error_code ec;
+        auto start = bench_clock::now();
+
+        for (;;) {
+            auto n = d.read(buf.data(), buf.size(), ec);
+
+            if (n <= 0)
+                break;
+
+            received += static_cast<std::size_t>(n);
+        }
+
+        seconds = elapsed_seconds(start);
+    }};
+
+    pfs::io::rudp_stats stats;
+
+    {
+        auto d = pfs::io::make_rudp_socket(SERVER_ADDR, port, make_options(loss, 2));
+        std::string chunk(16 * 1024, 'x');
+        pfs::io::error_code ec;
+
+        for (std::size_t sent = 0; sent < total_bytes; sent += chunk.size())
+            d.write(chunk.data(), chunk.size(), ec);
+
+        d.close();
+        stats = pfs::io::underlying_device<pfs::io::rudp_socket>(d)->stats();
+    }
+
+    receiver.join();
+
+    if (received < total_bytes)
+        std::printf("ERROR: %zu of %zu bytes received\n", received, total_bytes);
+
+    report("goodput (" + loss_name(loss) + ")", received / seconds / 1e6, "MB/s");
+    report("retransmitted packets (" + loss_name(loss) + ")"
+        , stats.packets_sent > 0 ? 100.0 * stats.packets_retransmitted / stats.packets_sent : 0, "%");
+}
+
+// Request/response round trip of small messages
+static void bench_latency (double loss, int rounds, std::uint16_t port)
+{
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, port, make_options(loss, 3));
+
+    std::thread echo {[&] {
+        auto d = server.accept(std::chrono::milliseconds{5000});
+        auto s = pfs::io::underlying_device<pfs::io::rudp_socket>(d);
+        std::string message;
+        pfs::io::error_code ec;
+
+        while (s->read_message(message, ec))
+            d.write(message.data(), message.size(), ec);
+    }};
+
+    auto d = pfs::io::make_rudp_socket(SERVER_ADDR, port, make_options(loss, 4));
+    auto s = pfs::io::underlying_device<pfs::io::rudp_socket>(d);
+    std::string request(64, 'r');
+    std::string response;
+    std::vector<double> latencies;
+    pfs::io::error_code ec;
+
+    for (int i = 0; i < rounds; i++) {
+        auto start = bench_clock::now();
+        d.write(request.data(), request.size(), ec);
+        s->read_message(response, ec);
+        latencies.push_back(elapsed_seconds(start) * 1e6);
+    }
+
+    d.close();
+    echo.join();
+
+    report("round trip p50 (" + loss_name(loss) + ")", percentile(latencies, 0.5), "us");
+    report("round trip p99 (" + loss_name(loss) + ")", percentile(latencies, 0.99), "us");
+    report("round trip max (" + loss_name(loss) + ")", percentile(latencies, 1.0), "us");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50;
+    std::uint16_t port = 42080;
+
+    for (double loss: {0.0, 0.01, 0.05}) {
+        bench_goodput(loss, megabytes * 1000000, port++);
+        bench_latency(loss, 2000, port++);
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/session_table.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Usage: bench_session_table [peers in thousands]
+
+using host_address = pfs::io::udp_socket::host_address;
+using time_point = std::chrono::steady_clock::time_point;
+
+struct session
+{
+    time_point last_seen;
+    std::uint64_t datagrams {0};
+};
+
+// Large blocks (table arrays) are allocated by mmap()
+static std::size_t heap_bytes ()
+{
+    auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static std::vector<host_address> make_peers (std::size_t count)
+{
+    std::vector<host_address> peers(count);
+    std::mt19937 gen {3};
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto & a = peers[i].addr.addr4;
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl(0x0A000000 + static_cast<std::uint32_t>(i / 16));
+        a.sin_port = htons(static_cast<std::uint16_t>(20000 + i % 16));
+    }
+
+    std::shuffle(peers.begin(), peers.end(), gen);
+    return peers;
+}
+
+// Touch/Lookup/Sweep are run for every container, lookups go in other order
+// than insertions
+template <typename Touch, typename Sweep>
+static void bench (std::string const & name, std::vector<host_address> const & peers
+    , Touch && touch, Sweep && sweep)
+{
+    auto lookups = peers;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937{5});
+    time_point now;
+
+    auto heap = heap_bytes();
+    auto start = bench_clock::now();
+
+    for (auto const & peer: peers)
+        touch(peer, now);
+
+    auto seconds = elapsed_seconds(start);
+    report(name + ": insert", seconds * 1e9 / peers.size(), "ns/peer");
+    report(name + ": memory", static_cast<double>(heap_bytes() - heap) / peers.size(), "bytes/peer");
+
+    start = bench_clock::now();
+
+    for (auto const & peer: lookups)
+        touch(peer, now + std::chrono::seconds{1});
+
+    seconds = elapsed_seconds(start);
+    report(name + ": lookup", seconds * 1e9 / peers.size(), "ns/datagram");
+
+    start = bench_clock::now();
+    auto removed = sweep(now + std::chrono::seconds{120});
+    seconds = elapsed_seconds(start);
+
+    if (removed != peers.size())
+        std::printf("ERROR: %zu of %zu sessions expired\n", removed, peers.size());
+
+    report(name + ": expire", seconds * 1e9 / peers.size(), "ns/peer");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000) * 1000;
+    auto peers = make_peers(count);
+    auto idle_timeout = std::chrono::seconds{60};
+
+    {
+        pfs::io::session_table<session> table {idle_timeout};
+
+        bench("session_table", peers
+            , [&] (host_address const & peer, time_point now) {
+                table.touch(peer, now).first->datagrams++;
+            }
+            , [&] (time_point now) { return table.expire(now); });
+    }
+
+    {
+        std::unordered_map<host_address, session> table;
+
+        bench("std::unordered_map<host_address>", peers
+            , [&] (host_address const & peer, time_point now) {
+                auto & s = table[peer];
+                s.last_seen = now;
+                s.datagrams++;
+            }
+            , [&] (time_point now) {
+                std::size_t removed = 0;
+
+                for (auto pos = table.begin(); pos != table.end();) {
+                    if (now - pos->second.last_seen > idle_timeout) {
+                        pos = table.erase(pos);
+                        removed++;
+                    } else {
+                        ++pos;
+                    }
+                }
+
+                return removed;
+            });
+    }
+
+    {
+        // Common ad hoc approach: textual peer address as a key
+        std::map<std::string, session> table;
+
+        bench("std::map<std::string>", peers
+            , [&] (host_address const & peer, time_point now) {
+                auto & s = table[to_string(peer)];
+                s.last_seen = now;
+                s.datagrams++;
+            }
+            , [&] (time_point now) {
+                std::size_t removed = 0;
+
+                for (auto pos = table.begin(); pos != table.end();) {
+                    if (now - pos->second.last_seen > idle_timeout) {
+                        pos = table.erase(pos);
+                        removed++;
+                    } else {
+                        ++pos;
+                    }
+                }
+
+                return removed;
+            });
+    }
+
+    return 0;
+}
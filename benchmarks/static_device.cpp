@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "utils.hpp"
+#include "pfs/io/buffer.hpp"
+#include "pfs/io/local_server.hpp"
+#include "pfs/io/local_socket.hpp"
+#include <iostream>
+
+static std::size_t const CHUNK_SIZE = 8;
+static std::size_t const BUFFER_SIZE = 64 * 1024 * 1024;
+static std::size_t const SOCKET_ITERATIONS = 200000;
+
+template <typename Device>
+static double bench_buffer_read (Device & d)
+{
+    char buf[CHUNK_SIZE];
+    pfs::io::error_code ec;
+
+    return measure_ns_per_call(BUFFER_SIZE / CHUNK_SIZE, [& d, & buf, & ec] {
+        do_not_optimize(d.read(buf, CHUNK_SIZE, ec));
+    });
+}
+
+template <typename Device>
+static double bench_buffer_write (Device & d)
+{
+    char buf[CHUNK_SIZE] = {0};
+    pfs::io::error_code ec;
+
+    return measure_ns_per_call(BUFFER_SIZE / CHUNK_SIZE, [& d, & buf, & ec] {
+        do_not_optimize(d.write(buf, CHUNK_SIZE, ec));
+    });
+}
+
+template <typename Device>
+static double bench_socket_ping (Device & client, pfs::io::device & peer)
+{
+    char buf[64] = {0};
+    pfs::io::error_code ec;
+
+    return measure_ns_per_call(SOCKET_ITERATIONS, [& client, & peer, & buf, & ec] {
+        client.write(buf, sizeof(buf), ec);
+        do_not_optimize(peer.read(buf, sizeof(buf), ec));
+    });
+}
+
+int main ()
+{
+    std::string source(BUFFER_SIZE, 'x');
+    std::string sink;
+
+    {
+        auto d = pfs::io::make_buffer(source, pfs::io::read_only);
+        report("buffer<> read (device)", bench_buffer_read(d), "ns/call");
+    }
+
+    {
+        auto d = pfs::io::make_static_buffer(source, pfs::io::read_only);
+        report("buffer<> read (static_device)", bench_buffer_read(d), "ns/call");
+    }
+
+    sink.reserve(BUFFER_SIZE);
+
+    {
+        auto d = pfs::io::make_buffer(sink, pfs::io::write_only);
+        report("buffer<> write (device)", bench_buffer_write(d), "ns/call");
+    }
+
+    sink.clear();
+
+    {
+        auto d = pfs::io::make_static_buffer(sink, pfs::io::write_only);
+        report("buffer<> write (static_device)", bench_buffer_write(d), "ns/call");
+    }
+
+    std::string server_name = tmp_dir() + "/pfs_bench_static_device";
+    auto server = pfs::io::make_local_server(server_name, false);
+
+    {
+        auto client = pfs::io::make_local_socket(server_name, false);
+        pfs::io::error_code ec;
+        auto peer = server.accept(ec);
+
+        if (ec) {
+            std::cerr << "ERROR: accept: " << ec.message() << "\n";
+            return 1;
+        }
+
+        report("local_socket write+read (device)"
+            , bench_socket_ping(client, peer), "ns/call");
+    }
+
+    {
+        auto client = pfs::io::make_static_local_socket(server_name, false);
+        pfs::io::error_code ec;
+        auto peer = server.accept(ec);
+
+        if (ec) {
+            std::cerr << "ERROR: accept: " << ec.message() << "\n";
+            return 1;
+        }
+
+        report("local_socket write+read (static_device)"
+            , bench_socket_ping(client, peer), "ns/call");
+    }
+
+    return 0;
+}
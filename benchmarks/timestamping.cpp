@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/tcp_server.hpp"
+#include "pfs/io/tcp_socket.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Usage: bench_timestamping [messages in thousands]
+//
+// One-way loopback latency measured by clock calls around write() and
+// read() versus kernel transmit and receive timestamps.
+
+using std::chrono::nanoseconds;
+
+static nanoseconds realtime ()
+{
+    return std::chrono::duration_cast<nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+}
+
+struct latencies
+{
+    std::vector<double> user;
+    std::vector<double> kernel;
+    std::size_t missing {0};
+};
+
+static void report_latencies (std::string const & name, latencies const & l)
+{
+    for (double p: {0.5, 0.99, 0.999}) {
+        auto label = std::string{" p"} + (p == 0.5 ? "50" : p == 0.99 ? "99" : "99.9");
+        report(name + ": clock around write/read" + label, percentile(l.user, p), "us");
+        report(name + ": kernel timestamps" + label, percentile(l.kernel, p), "us");
+    }
+
+    if (l.missing > 0)
+        report(name + ": messages without timestamps", static_cast<double>(l.missing), "");
+}
+
+template <typename Sender, typename Receiver>
+static latencies measure (Sender & sender, Receiver & receiver, std::size_t count)
+{
+    latencies l;
+    l.user.reserve(count);
+    l.kernel.reserve(count);
+
+    std::string message(64, 'm');
+    char buf[128];
+    pfs::io::error_code ec;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto before = realtime();
+
+        if (sender.write(message.data(), message.size(), ec) < 0)
+            break;
+
+        pfs::io::packet_timestamps rx;
+        ssize_t n = 0;
+
+        while (n == 0)
+            n = receiver.read(buf, sizeof(buf), rx, ec);
+
+        auto after = realtime();
+
+        if (n < 0)
+            break;
+
+        std::uint32_t id = 0;
+        pfs::io::packet_timestamps tx;
+
+        if (!sender.read_tx_timestamp(id, tx, ec) || rx.software.count() == 0) {
+            l.missing++;
+            continue;
+        }
+
+        l.user.push_back((after - before).count() / 1e3);
+        l.kernel.push_back((rx.software - tx.software).count() / 1e3);
+    }
+
+    return l;
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100) * 1000;
+
+    {
+        auto server = pfs::io::make_udp_server("127.0.0.1", 42130, true);
+        auto client = pfs::io::make_static_udp_socket("127.0.0.1", 42130, false);
+
+        server.enable_timestamping(pfs::io::rx_software_timestamp);
+        client.underlying().enable_timestamping(pfs::io::tx_software_timestamp);
+
+        // Kernel starts taking receive timestamps asynchronously
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        report_latencies("UDP", measure(client.underlying(), server, count));
+    }
+
+    {
+        auto server = pfs::io::make_tcp_server("127.0.0.1", 42131, false);
+        auto client = pfs::io::make_static_tcp_socket("127.0.0.1", 42131, false);
+        pfs::io::error_code ec;
+        auto peer = server.accept(ec);
+
+        if (ec) {
+            std::printf("ERROR: %s\n", ec.message().c_str());
+            return 1;
+        }
+
+        auto receiver = pfs::io::underlying_device<pfs::io::tcp_peer>(peer);
+        auto & sender = client.underlying();
+
+        receiver->enable_timestamping(pfs::io::rx_software_timestamp);
+        sender.enable_timestamping(pfs::io::tx_software_timestamp);
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        report_latencies("TCP", measure(sender, *receiver, count));
+    }
+
+    return 0;
+}
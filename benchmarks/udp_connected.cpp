@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <cstdlib>
+#include <string>
+
+// Usage: bench_udp_connected [datagrams in thousands]
+
+static std::size_t const burst = 64;
+
+// Sender and receiver alternate in one thread, so nothing is dropped
+static void bench (bool connected, std::size_t size, std::size_t count, std::uint16_t port)
+{
+    auto receiver = pfs::io::make_udp_server("127.0.0.1", port, true);
+    auto sender = pfs::io::make_static_udp_socket("127.0.0.1", port, false);
+    std::string datagram(size, 'x');
+    char buf[2048];
+    pfs::io::error_code ec;
+
+    if (connected)
+        sender.underlying().connect();
+
+    // Receiver learns sender address
+    sender.write(datagram.data(), datagram.size(), ec);
+
+    pfs::io::udp_server::host_address sender_addr;
+
+    while (receiver.read_from(buf, sizeof(buf), & sender_addr, ec) == 0)
+        ;
+
+    if (connected)
+        receiver.connect(sender_addr);
+
+    double send_seconds = 0;
+    auto start = bench_clock::now();
+
+    for (std::size_t sent = 0; sent < count; sent += burst) {
+        auto send_start = bench_clock::now();
+
+        for (std::size_t i = 0; i < burst; i++)
+            sender.write(datagram.data(), datagram.size(), ec);
+
+        send_seconds += elapsed_seconds(send_start);
+
+        for (std::size_t i = 0; i < burst;) {
+            auto n = receiver.read(buf, sizeof(buf), ec);
+
+            if (n < 0) {
+                std::printf("ERROR: %s\n", ec.message().c_str());
+                return;
+            }
+
+            i += n > 0 ? 1 : 0;
+        }
+    }
+
+    auto seconds = elapsed_seconds(start);
+    auto name = std::string{connected ? "connected" : "unconnected"}
+        + " (" + std::to_string(size) + " bytes)";
+
+    report(name + ": write + read", seconds * 1e9 / count, "ns/datagram");
+    report(name + ": write", send_seconds * 1e9 / count, "ns/datagram");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000) * 1000;
+    std::uint16_t port = 42100;
+
+    for (std::size_t size: {64, 1200}) {
+        bench(false, size, count, port++);
+        bench(true, size, count, port++);
+    }
+
+    return 0;
+}
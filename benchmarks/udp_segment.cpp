@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Usage: bench_udp_segment [megabytes per run]
+
+static std::size_t const segment_size = 1200;
+
+// Datagrams sent before the receiver drains the socket (fits into default
+// receive buffer and into one segmentation offload send)
+static std::size_t const burst = 48;
+
+enum class mode { datagrams, gso, gso_gro };
+
+// Sender and receiver alternate in one thread, so nothing is dropped and
+// time of both sides is accounted
+static void bench (mode m, std::size_t total_bytes, std::uint16_t port)
+{
+    char const * name = m == mode::datagrams ? "write_to() + read()"
+        : m == mode::gso ? "write_segments() + read()"
+        : "write_segments() + read_segments()";
+
+    auto receiver = pfs::io::make_udp_server("127.0.0.1", port, true);
+
+    if (m == mode::gso_gro && receiver.enable_receive_offload()) {
+        std::printf("%s: receive offload is not available\n", name);
+        return;
+    }
+
+    auto sender = pfs::io::make_static_udp_socket("127.0.0.1", port, false);
+    auto & s = sender.underlying();
+    std::string chunk(burst * segment_size, 'x');
+    std::vector<char> buf(64 * 1024);
+    std::size_t received = 0;
+    std::size_t reads = 0;
+    double send_seconds = 0;
+    pfs::io::error_code ec;
+
+    auto start = bench_clock::now();
+
+    for (std::size_t sent = 0; sent < total_bytes; sent += chunk.size()) {
+        auto send_start = bench_clock::now();
+
+        if (m == mode::datagrams) {
+            for (std::size_t offset = 0; offset < chunk.size(); offset += segment_size)
+                s.write_to(chunk.data() + offset, segment_size, & s.address(), ec);
+        } else {
+            s.write_segments(chunk.data(), chunk.size(), segment_size, ec);
+        }
+
+        send_seconds += elapsed_seconds(send_start);
+
+        for (std::size_t n = 0; n < chunk.size();) {
+            std::size_t size = 0;
+            auto rc = m == mode::gso_gro
+                ? receiver.read_segments(buf.data(), buf.size(), size, ec)
+                : receiver.read(buf.data(), buf.size(), ec);
+
+            if (rc < 0) {
+                std::printf("ERROR: %s\n", ec.message().c_str());
+                return;
+            }
+
+            n += static_cast<std::size_t>(rc);
+            received += static_cast<std::size_t>(rc);
+            reads += rc > 0 ? 1 : 0;
+        }
+    }
+
+    auto seconds = elapsed_seconds(start);
+
+    if (m != mode::datagrams && !s.segmentation_offload())
+        std::printf("%s: segmentation offload is not available\n", name);
+
+    report(std::string{name} + ": throughput", received / seconds / 1e6, "MB/s");
+    report(std::string{name} + ": throughput", received / segment_size / seconds / 1e6, "M datagrams/s");
+    report(std::string{name} + ": send only", received / send_seconds / 1e6, "MB/s");
+    report(std::string{name} + ": datagrams per read"
+        , reads > 0 ? static_cast<double>(received) / segment_size / reads : 0, "");
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    std::uint16_t port = 42090;
+
+    for (auto m: {mode::datagrams, mode::gso, mode::gso_gro})
+        bench(m, megabytes * 1000000, port++);
+
+    return 0;
+}
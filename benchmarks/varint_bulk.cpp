@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "pfs/io/varint_bulk.hpp"
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Usage: bench_varint_bulk [values in millions]
+
+static std::vector<std::uint64_t> make_values (std::string const & distribution, std::size_t count)
+{
+    std::mt19937_64 gen {1};
+    std::vector<std::uint64_t> values(count);
+
+    for (auto & v: values) {
+        if (distribution == "uniform 32-bit") {
+            v = gen() & 0xFFFFFFFFULL;
+        } else if (distribution == "uniform length") {
+            auto bits = 1 + gen() % 64;
+            v = gen() >> (64 - bits);
+        } else {
+            // Skewed: mostly small ids and counters
+            auto r = gen() % 100;
+            v = r < 80 ? gen() % 128
+                : r < 95 ? gen() % 16384
+                : gen() & 0xFFFFFFFFULL;
+        }
+    }
+
+    return values;
+}
+
+static void bench_distribution (std::string const & distribution, std::size_t count)
+{
+    auto values = make_values(distribution, count);
+    std::vector<char> encoded(count * pfs::io::varint_max_size);
+    std::vector<std::uint64_t> decoded(count);
+
+    auto n = pfs::io::details::encode_varints_scalar(values.data(), values.size(), encoded.data());
+    report(distribution + ": bytes per value", static_cast<double>(n) / count, "");
+
+    // What parsers do now: one value at a time
+    {
+        auto start = bench_clock::now();
+        char const * first = encoded.data();
+        char const * last = first + n;
+
+        for (std::size_t i = 0; i < count; i++)
+            first += pfs::io::decode_varint(first, last, decoded[i]);
+
+        auto seconds = elapsed_seconds(start);
+        do_not_optimize(decoded.data());
+        report(distribution + ": decode_varint loop", count / seconds / 1e6, "M values/s");
+    }
+
+    struct {
+        char const * name;
+        pfs::io::simd_isa isa;
+    } variants[] = {
+          {"scalar", pfs::io::simd_isa::scalar}
+        , {"sse4.1", pfs::io::simd_isa::sse41}
+        , {"avx2"  , pfs::io::simd_isa::avx2}
+    };
+
+    for (auto const & v: variants) {
+        if (!pfs::io::simd_isa_supported(v.isa))
+            continue;
+
+        auto kernels = pfs::io::details::select_varint_kernels(v.isa);
+        pfs::io::error_code ec;
+
+        auto start = bench_clock::now();
+        char const * first = encoded.data();
+        auto decoded_count = kernels.decode(first, encoded.data() + n, decoded.data(), count, ec);
+        auto seconds = elapsed_seconds(start);
+
+        if (decoded_count != count || decoded != values)
+            std::printf("ERROR: %s decoder mismatch\n", v.name);
+
+        report(distribution + ": decode (" + v.name + ")", count / seconds / 1e6, "M values/s");
+
+        start = bench_clock::now();
+        auto m = kernels.encode(values.data(), count, encoded.data());
+        seconds = elapsed_seconds(start);
+
+        if (m != n)
+            std::printf("ERROR: %s encoder mismatch\n", v.name);
+
+        report(distribution + ": encode (" + v.name + ")", count / seconds / 1e6, "M values/s");
+    }
+}
+
+static void bench_zigzag (std::size_t count)
+{
+    std::mt19937_64 gen {2};
+    std::vector<std::int64_t> values(count);
+    std::vector<std::uint64_t> encoded(count);
+    std::vector<std::int64_t> decoded(count);
+
+    for (auto & v: values)
+        v = static_cast<std::int64_t>(gen()) >> (gen() % 64);
+
+    struct {
+        char const * name;
+        pfs::io::simd_isa isa;
+    } variants[] = {
+          {"scalar", pfs::io::simd_isa::scalar}
+        , {"sse4.1", pfs::io::simd_isa::sse41}
+        , {"avx2"  , pfs::io::simd_isa::avx2}
+    };
+
+    for (auto const & v: variants) {
+        if (!pfs::io::simd_isa_supported(v.isa))
+            continue;
+
+        auto kernels = pfs::io::details::select_varint_kernels(v.isa);
+
+        auto start = bench_clock::now();
+        kernels.zigzag_encode(values.data(), count, encoded.data());
+        kernels.zigzag_decode(encoded.data(), count, decoded.data());
+        auto seconds = elapsed_seconds(start);
+
+        if (decoded != values)
+            std::printf("ERROR: %s zigzag mismatch\n", v.name);
+
+        report(std::string{"zigzag encode+decode ("} + v.name + ")", count / seconds / 1e6, "M values/s");
+    }
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20) * 1000000;
+
+    for (auto distribution: {"uniform 32-bit", "uniform length", "skewed"})
+        bench_distribution(distribution, count);
+
+    bench_zigzag(count);
+    return 0;
+}
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "benchmark.hpp"
+#include "utils.hpp"
+#include "pfs/io/wal.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+// Usage: bench_wal [records per writer]
+
+static std::size_t const RECORD_SIZE = 128;
+
+static void clear_dir (std::string const & dir)
+{
+    std::vector<std::string> names;
+
+    if (!pfs::io::platform::file::list_directory(dir, names)) {
+        for (auto const & n: names)
+            pfs::io::platform::file::remove_file(dir + "/" + n);
+    }
+}
+
+static void bench_append (int writers, std::size_t records_per_writer)
+{
+    auto dir = tmp_dir() + "/pfs_bench_wal";
+    clear_dir(dir);
+
+    pfs::io::error_code ec;
+    auto w = pfs::io::make_wal_writer(dir, pfs::io::wal_options{}, ec);
+
+    if (ec) {
+        std::cerr << "ERROR: " << dir << ": " << ec.message() << "\n";
+        return;
+    }
+
+    std::mutex mtx;
+    std::vector<double> latencies;
+    std::vector<std::thread> threads;
+    auto start = bench_clock::now();
+
+    for (int t = 0; t < writers; t++) {
+        threads.emplace_back([& w, & mtx, & latencies, records_per_writer] {
+            std::string record(RECORD_SIZE, 'w');
+            std::vector<double> local;
+            local.reserve(records_per_writer);
+
+            for (std::size_t i = 0; i < records_per_writer; i++) {
+                auto t0 = bench_clock::now();
+                pfs::io::error_code ec;
+                w->append(record.data(), record.size(), ec);
+
+                if (ec) {
+                    std::cerr << "ERROR: append: " << ec.message() << "\n";
+                    return;
+                }
+
+                local.push_back(elapsed_seconds(t0) * 1e6);
+            }
+
+            std::lock_guard<std::mutex> lk(mtx);
+            latencies.insert(latencies.end(), local.begin(), local.end());
+        });
+    }
+
+    for (auto & th: threads)
+        th.join();
+
+    auto seconds = elapsed_seconds(start);
+    auto prefix = std::to_string(writers) + " writer(s)";
+
+    report(prefix + " throughput", latencies.size() / seconds, "records/s");
+    report(prefix + " commit latency p50", percentile(latencies, 0.5), "us");
+    report(prefix + " commit latency p99", percentile(latencies, 0.99), "us");
+    report(prefix + " records per flush"
+        , static_cast<double>(latencies.size()) / w->commit_count(), "");
+
+    w.reset();
+    clear_dir(dir);
+}
+
+int main (int argc, char * argv[])
+{
+    std::size_t records = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+
+    for (int writers: {1, 8, 64})
+        bench_append(writers, records);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "operationsystem.h"
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+/**
+ * @brief Allocator returning memory aligned to @a Alignment bytes.
+ *
+ * Suitable for buffers used with files opened in direct I/O mode.
+ */
+template <typename T, std::size_t Alignment = 4096>
+class aligned_allocator
+{
+    static_assert(Alignment >= sizeof(void *) && (Alignment & (Alignment - 1)) == 0
+        , "Alignment must be a power of two not less than pointer size");
+
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using reference = T &;
+    using const_reference = T const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr std::size_t alignment = Alignment;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+public:
+    aligned_allocator () noexcept {}
+
+    template <typename U>
+    aligned_allocator (aligned_allocator<U, Alignment> const &) noexcept {}
+
+    T * allocate (std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc{};
+
+        void * p = nullptr;
+
+        if (::posix_memalign(& p, Alignment, n * sizeof(T)) != 0)
+            throw std::bad_alloc{};
+
+        return static_cast<T *>(p);
+    }
+
+    void deallocate (T * p, std::size_t) noexcept
+    {
+        std::free(p);
+    }
+};
+
+template <typename T, std::size_t Alignment>
+constexpr std::size_t aligned_allocator<T, Alignment>::alignment;
+
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator == (aligned_allocator<T, Alignment> const &
+    , aligned_allocator<U, Alignment> const &) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+inline bool operator != (aligned_allocator<T, Alignment> const &
+    , aligned_allocator<U, Alignment> const &) noexcept
+{
+    return false;
+}
+
+/**
+ * Byte buffer suitable for direct I/O.
+ */
+template <std::size_t Alignment = 4096>
+using aligned_buffer = std::vector<char, aligned_allocator<char, Alignment>>;
+
+}} // pfs::io
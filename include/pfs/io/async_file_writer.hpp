@@ -0,0 +1,394 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Producer lacking capacity wakes up background thread
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+/**
+ * Behavior of async_file_writer::write() when all buffers are full.
+ */
+enum class overflow_policy
+{
+      block /**< Wait until background thread frees a buffer */
+    , drop  /**< Discard the data and return immediately */
+};
+
+struct async_writer_options
+{
+    // Size of each buffer
+    size_t buffer_size {1024 * 1024};
+
+    // Number of buffers (at least two), memory usage is bounded by
+    // buffer_size * buffer_count
+    size_t buffer_count {2};
+
+    overflow_policy policy {overflow_policy::block};
+
+    // Partially filled buffer is written out after this interval
+    std::chrono::milliseconds flush_interval {100};
+};
+
+/**
+ * @brief Writes to device from a background thread.
+ *
+ * Producers copy data into the current buffer under a short lock. Full
+ * buffers are handed to the background thread that writes all of them with a
+ * single writev() call, so producers never wait for the device unless all
+ * buffers are full and policy is overflow_policy::block.
+ *
+ * Data of a single write() call is never split by dropping: it is either
+ * accepted entirely or dropped entirely.
+ */
+class async_file_writer
+{
+    struct buffer_type
+    {
+        std::vector<char> data;
+        size_t size;
+    };
+
+    device _d;
+    async_writer_options _options;
+
+    std::mutex _mtx;
+    std::condition_variable _producer_cv;
+    std::condition_variable _consumer_cv;
+
+    buffer_type * _active {nullptr};
+    std::vector<buffer_type> _buffers;
+    std::vector<buffer_type *> _free;
+    std::vector<buffer_type *> _full;
+
+    std::uint64_t _accepted_bytes {0};
+    std::uint64_t _written_bytes {0};
+    std::uint64_t _dropped_bytes {0};
+    bool _flush_requested {false};
+    bool _stop {false};
+    bool _closed {false};
+    error_code _failure; // sticky
+
+    std::thread _worker;
+
+private:
+    // Must be called with locked mutex, requires a free buffer
+    void rotate ()
+    {
+        _full.push_back(_active);
+        _active = _free.back();
+        _free.pop_back();
+        _active->size = 0;
+        _consumer_cv.notify_one();
+    }
+
+    error_code write_batch (std::vector<buffer_type *> const & batch)
+    {
+        std::vector<io_vector> iov;
+        iov.reserve(batch.size());
+
+        for (auto b: batch) {
+            if (b->size > 0)
+                iov.push_back(io_vector{b->data.data(), b->size});
+        }
+
+        error_code ec;
+        auto first = iov.begin();
+
+        // Device may accept only part of data
+        while (first != iov.end()) {
+            auto n = _d.writev(& *first, static_cast<int>(iov.end() - first), ec);
+
+            if (n < 0)
+                return ec;
+
+            // Non-blocking device is not ready
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            while (first != iov.end() && static_cast<size_t>(n) >= first->iov_len) {
+                n -= first->iov_len;
+                ++first;
+            }
+
+            if (first != iov.end()) {
+                first->iov_base = static_cast<char *>(first->iov_base) + n;
+                first->iov_len -= n;
+            }
+        }
+
+        return ec;
+    }
+
+    void run ()
+    {
+        std::unique_lock<std::mutex> lk(_mtx);
+        std::vector<buffer_type *> batch;
+
+        for (;;) {
+            if (_full.empty() && !_stop && !_flush_requested) {
+                _consumer_cv.wait_for(lk, _options.flush_interval);
+
+                // Timeout or flush request: write out partially filled buffer
+                if (_full.empty() && _active->size > 0)
+                    rotate();
+            } else if (_active->size > 0 && (_stop || _flush_requested) && !_free.empty()) {
+                rotate();
+            }
+
+            if (_full.empty()) {
+                _flush_requested = false;
+                _producer_cv.notify_all();
+
+                if (_stop)
+                    break;
+
+                continue;
+            }
+
+            batch.swap(_full);
+            std::uint64_t bytes = 0;
+
+            for (auto b: batch)
+                bytes += b->size;
+
+            lk.unlock();
+            auto ec = _failure ? error_code{} : write_batch(batch);
+            lk.lock();
+
+            if (ec && !_failure)
+                _failure = ec;
+
+            if (!_failure)
+                _written_bytes += bytes;
+
+            _free.insert(_free.end(), batch.begin(), batch.end());
+            batch.clear();
+            _producer_cv.notify_all();
+        }
+    }
+
+public:
+    /**
+     * Takes ownership of opened device @a d (usually a file opened for
+     * writing) and starts background thread.
+     */
+    async_file_writer (device && d, async_writer_options const & options = async_writer_options{})
+        : _d(std::move(d))
+        , _options(options)
+    {
+        _options.buffer_count = std::max(_options.buffer_count, size_t{2});
+        _options.buffer_size = std::max(_options.buffer_size, size_t{1});
+        _buffers.resize(_options.buffer_count);
+
+        for (auto & b: _buffers) {
+            b.data.resize(_options.buffer_size);
+            b.size = 0;
+            _free.push_back(& b);
+        }
+
+        _active = _free.back();
+        _free.pop_back();
+        _worker = std::thread{& async_file_writer::run, this};
+    }
+
+    async_file_writer (async_file_writer const &) = delete;
+    async_file_writer & operator = (async_file_writer const &) = delete;
+
+    ~async_file_writer ()
+    {
+        close();
+    }
+
+    /**
+     * Copies @a n bytes into buffers. Data larger than total buffer capacity
+     * is always rejected with errc::invalid_argument.
+     *
+     * @return @a n if data accepted, 0 if it is dropped, or -1 on error
+     *         (including error of previous background write).
+     */
+    ssize_t write (char const * bytes, size_t n, error_code & ec)
+    {
+        if (n > _options.buffer_size * _options.buffer_count) {
+            ec = make_error_code(errc::invalid_argument);
+            return -1;
+        }
+
+        std::unique_lock<std::mutex> lk(_mtx);
+
+        for (;;) {
+            if (_closed || _failure) {
+                ec = _closed ? make_error_code(errc::bad_file_descriptor) : _failure;
+                return -1;
+            }
+
+            auto capacity = _options.buffer_size - _active->size
+                + _free.size() * _options.buffer_size;
+
+            if (capacity >= n)
+                break;
+
+            if (_options.policy == overflow_policy::drop) {
+                _dropped_bytes += n;
+                return 0;
+            }
+
+            // Wake up the consumer: it may be waiting for flush interval while
+            // partially filled active buffer holds the capacity
+            if (_active->size > 0 && !_free.empty())
+                rotate();
+            else
+                _consumer_cv.notify_one();
+
+            _producer_cv.wait(lk);
+        }
+
+        size_t copied = 0;
+
+        while (copied < n) {
+            if (_active->size == _options.buffer_size)
+                rotate();
+
+            auto chunk = std::min(n - copied, _options.buffer_size - _active->size);
+            std::memcpy(_active->data.data() + _active->size, bytes + copied, chunk);
+            _active->size += chunk;
+            copied += chunk;
+        }
+
+        if (_active->size == _options.buffer_size && !_free.empty())
+            rotate();
+
+        _accepted_bytes += n;
+        return static_cast<ssize_t>(n);
+    }
+
+    ssize_t write (char const * bytes, size_t n)
+    {
+        error_code ec;
+        auto r = write(bytes, n, ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Waits until all accepted data is written to device.
+     */
+    error_code flush ()
+    {
+        std::unique_lock<std::mutex> lk(_mtx);
+        auto target = _accepted_bytes;
+
+        while (_written_bytes < target && !_failure && !_stop) {
+            _flush_requested = true;
+            _consumer_cv.notify_one();
+            _producer_cv.wait(lk);
+        }
+
+        return _failure;
+    }
+
+    /**
+     * Writes out all accepted data, stops background thread and closes
+     * device.
+     */
+    error_code close ()
+    {
+        {
+            std::lock_guard<std::mutex> lk(_mtx);
+
+            if (_closed)
+                return _failure;
+
+            _closed = true;
+            _stop = true;
+            _consumer_cv.notify_one();
+        }
+
+        if (_worker.joinable())
+            _worker.join();
+
+        auto ec = _d.opened() ? _d.close() : error_code{};
+
+        std::lock_guard<std::mutex> lk(_mtx);
+
+        if (ec && !_failure)
+            _failure = ec;
+
+        return _failure;
+    }
+
+    /**
+     * Number of bytes discarded due to overflow_policy::drop.
+     */
+    std::uint64_t dropped_bytes ()
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _dropped_bytes;
+    }
+
+    /**
+     * Number of bytes passed to device.
+     */
+    std::uint64_t written_bytes ()
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _written_bytes;
+    }
+};
+
+/**
+ * Opens file @a path for writing and creates asynchronous writer for it.
+ * File durability policy is applied on close().
+ */
+inline unique_ptr<async_file_writer> make_async_file_writer (std::string const & path
+    , open_mode_flags oflags
+    , permissions perms
+    , durability policy
+    , async_writer_options const & options
+    , error_code & ec)
+{
+    auto d = make_file(path, write_only | oflags, perms, policy, ec);
+
+    if (ec)
+        return unique_ptr<async_file_writer>{};
+
+    return unique_ptr<async_file_writer>{new async_file_writer{std::move(d), options}};
+}
+
+inline unique_ptr<async_file_writer> make_async_file_writer (std::string const & path
+    , async_writer_options const & options
+    , error_code & ec)
+{
+    return make_async_file_writer(path, truncate, owner_read | owner_write
+        , durability::full_sync, options, ec);
+}
+
+inline unique_ptr<async_file_writer> make_async_file_writer (std::string const & path
+    , async_writer_options const & options = async_writer_options{})
+{
+    error_code ec;
+    auto w = make_async_file_writer(path, options, ec);
+    if (ec) throw exception(ec);
+    return w;
+}
+
+}} // pfs::io
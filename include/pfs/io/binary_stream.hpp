@@ -0,0 +1,564 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Added bulk varint fields
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "bytes_view.hpp"
+#include "device.hpp"
+#include "varint.hpp"
+#include "varint_bulk.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+enum class endian
+{
+      little
+    , big
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    , native = little
+#else
+    , native = big
+#endif
+};
+
+namespace details {
+
+template <size_t Size> struct byte_swap;
+
+template <> struct byte_swap<1>
+{
+    using type = std::uint8_t;
+    static type apply (type v) noexcept { return v; }
+};
+
+template <> struct byte_swap<2>
+{
+    using type = std::uint16_t;
+    static type apply (type v) noexcept { return __builtin_bswap16(v); }
+};
+
+template <> struct byte_swap<4>
+{
+    using type = std::uint32_t;
+    static type apply (type v) noexcept { return __builtin_bswap32(v); }
+};
+
+template <> struct byte_swap<8>
+{
+    using type = std::uint64_t;
+    static type apply (type v) noexcept { return __builtin_bswap64(v); }
+};
+
+} // details
+
+/**
+ * Fixed-width field codec. Defined for arithmetic types, byte order is
+ * resolved at compile time (native order is a plain copy).
+ */
+template <typename T, endian E, typename = void>
+struct field_codec;
+
+template <typename T, endian E>
+struct field_codec<T, E, typename std::enable_if<std::is_arithmetic<T>::value
+    && !std::is_same<T, bool>::value>::type>
+{
+    enum { size = sizeof(T) };
+
+    using swap_type = details::byte_swap<sizeof(T)>;
+    using uint_type = typename swap_type::type;
+
+    static void encode (T value, char * out) noexcept
+    {
+        uint_type u;
+        std::memcpy(& u, & value, sizeof(u));
+
+        if (E != endian::native)
+            u = swap_type::apply(u);
+
+        std::memcpy(out, & u, sizeof(u));
+    }
+
+    static T decode (char const * in) noexcept
+    {
+        uint_type u;
+        std::memcpy(& u, in, sizeof(u));
+
+        if (E != endian::native)
+            u = swap_type::apply(u);
+
+        T value;
+        std::memcpy(& value, & u, sizeof(u));
+        return value;
+    }
+};
+
+template <endian E>
+struct field_codec<bool, E>
+{
+    enum { size = 1 };
+
+    static void encode (bool value, char * out) noexcept
+    {
+        *out = value ? 1 : 0;
+    }
+
+    static bool decode (char const * in) noexcept
+    {
+        return *in != 0;
+    }
+};
+
+/**
+ * @brief Serializes fields into internal buffer and sends them with a single
+ *        write per message.
+ *
+ * Fields are appended by write*() calls; flush() ends the message and sends
+ * it. Strings and byte sequences are prefixed with varint length.
+ *
+ * @tparam Device @c device, @c static_device or any type with write().
+ * @tparam E Byte order of fixed-width fields.
+ */
+template <typename Device = device, endian E = endian::big>
+class basic_binary_writer
+{
+    Device * _d {nullptr};
+    std::vector<char> _buf;
+    size_t _size {0}; // end of serialized data
+    size_t _sent {0}; // data before this position is already sent
+
+private:
+    char * reserve (size_t n)
+    {
+        if (_buf.size() - _size < n)
+            _buf.resize(std::max(_size + n, _buf.size() * 2));
+
+        return _buf.data() + _size;
+    }
+
+public:
+    basic_binary_writer (Device & d, size_t initial_capacity = 256)
+        : _d(& d)
+        , _buf(std::max(initial_capacity, varint_max_size))
+    {}
+
+    /**
+     * Appends fixed-width field.
+     */
+    template <typename T>
+    basic_binary_writer & write (T value)
+    {
+        using codec = field_codec<T, E>;
+        codec::encode(value, reserve(codec::size));
+        _size += codec::size;
+        return *this;
+    }
+
+    basic_binary_writer & write_varint (std::uint64_t value)
+    {
+        _size += encode_varint(value, reserve(varint_max_size));
+        return *this;
+    }
+
+    /**
+     * Appends @a count varints using bulk encoder.
+     */
+    basic_binary_writer & write_varints (std::uint64_t const * values, size_t count)
+    {
+        _size += encode_varints(values, count, reserve(count * varint_max_size));
+        return *this;
+    }
+
+    /**
+     * Appends signed value as zigzag-mapped varint.
+     */
+    basic_binary_writer & write_zigzag (std::int64_t value)
+    {
+        return write_varint(zigzag_encode(value));
+    }
+
+    /**
+     * Appends raw bytes without length prefix.
+     */
+    basic_binary_writer & write_bytes (char const * data, size_t n)
+    {
+        if (n > 0) {
+            std::memcpy(reserve(n), data, n);
+            _size += n;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Appends varint length followed by bytes.
+     */
+    basic_binary_writer & write_string (char const * data, size_t n)
+    {
+        write_varint(n);
+        return write_bytes(data, n);
+    }
+
+    basic_binary_writer & write_string (bytes_view s)
+    {
+        return write_string(s.data(), s.size());
+    }
+
+    basic_binary_writer & write_string (std::string const & s)
+    {
+        return write_string(s.data(), s.size());
+    }
+
+    /**
+     * @return Size of unsent data.
+     */
+    size_t size () const noexcept
+    {
+        return _size - _sent;
+    }
+
+    /**
+     * Discards unsent data.
+     */
+    void clear () noexcept
+    {
+        _size = _sent = 0;
+    }
+
+    /**
+     * Sends accumulated message. After partial write (e.g. nonblocking
+     * device) unsent rest is kept and sent by the next call.
+     *
+     * @return Number of bytes sent by this call or -1 on error.
+     */
+    ssize_t flush (error_code & ec)
+    {
+        ssize_t total = 0;
+
+        while (_sent < _size) {
+            auto n = _d->write(_buf.data() + _sent, _size - _sent, ec);
+
+            if (n < 0)
+                return -1;
+
+            if (n == 0) {
+                ec = make_error_code(errc::operation_would_block);
+                return -1;
+            }
+
+            _sent += static_cast<size_t>(n);
+            total += n;
+        }
+
+        _size = _sent = 0;
+        return total;
+    }
+
+    ssize_t flush ()
+    {
+        error_code ec;
+        auto r = flush(ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+};
+
+struct binary_reader_options
+{
+    // Initial buffer size
+    size_t buffer_size {64 * 1024};
+
+    // Longer strings are rejected with errc::message_size
+    size_t max_string_size {16 * 1024 * 1024};
+};
+
+/**
+ * @brief Deserializes fields written by basic_binary_writer.
+ *
+ * Data is read from device in large blocks, fields are decoded from the
+ * internal buffer.
+ *
+ * Read methods return @c false at the end of stream, on error (@a ec is set)
+ * or if nonblocking device has no complete field for now (nothing is
+ * consumed in this case). Stream ending in the middle of a field results in
+ * errc::bad_message.
+ *
+ * @tparam Device @c device, @c static_device or any type with read() and
+ *         is_nonblocking().
+ * @tparam E Byte order of fixed-width fields.
+ */
+template <typename Device = device, endian E = endian::big>
+class basic_binary_reader
+{
+    Device * _d {nullptr};
+    size_t _max_string_size;
+    std::vector<char> _buf;
+    size_t _begin {0};
+    size_t _end {0};
+    bool _eof {false};
+
+private:
+    bool ensure (size_t n, error_code & ec)
+    {
+        while (_end - _begin < n) {
+            if (_eof) {
+                if (_begin != _end)
+                    ec = make_error_code(errc::bad_message);
+
+                return false;
+            }
+
+            if (_buf.size() - _begin < n || _end == _buf.size()) {
+                std::memmove(_buf.data(), _buf.data() + _begin, _end - _begin);
+                _end -= _begin;
+                _begin = 0;
+
+                if (_buf.size() < n)
+                    _buf.resize(std::max(n, _buf.size() * 2));
+            }
+
+            auto r = _d->read(_buf.data() + _end, _buf.size() - _end, ec);
+
+            if (r < 0)
+                return false;
+
+            if (r == 0) {
+                if (_d->is_nonblocking())
+                    return false;
+
+                _eof = true;
+                continue;
+            }
+
+            _end += static_cast<size_t>(r);
+        }
+
+        return true;
+    }
+
+    // Decodes varint without consuming it.
+    // Returns encoded size or zero on failure.
+    size_t peek_varint (std::uint64_t & value, error_code & ec)
+    {
+        for (;;) {
+            auto n = decode_varint(_buf.data() + _begin, _buf.data() + _end, value);
+
+            if (n > 0)
+                return static_cast<size_t>(n);
+
+            if (n < 0) {
+                ec = make_error_code(errc::bad_message);
+                return 0;
+            }
+
+            if (!ensure(_end - _begin + 1, ec))
+                return 0;
+        }
+    }
+
+    // Makes the whole string available, consumes its length prefix
+    bool read_string_head (size_t & n, error_code & ec)
+    {
+        std::uint64_t len = 0;
+        auto hlen = peek_varint(len, ec);
+
+        if (hlen == 0)
+            return false;
+
+        if (len > _max_string_size) {
+            ec = make_error_code(errc::message_size);
+            return false;
+        }
+
+        if (!ensure(hlen + static_cast<size_t>(len), ec))
+            return false;
+
+        _begin += hlen;
+        n = static_cast<size_t>(len);
+        return true;
+    }
+
+public:
+    basic_binary_reader (Device & d
+        , binary_reader_options const & options = binary_reader_options{})
+        : _d(& d)
+        , _max_string_size(options.max_string_size)
+        , _buf(std::max(options.buffer_size, varint_max_size))
+    {}
+
+    template <typename T>
+    bool read (T & value, error_code & ec)
+    {
+        using codec = field_codec<T, E>;
+
+        if (!ensure(codec::size, ec))
+            return false;
+
+        value = codec::decode(_buf.data() + _begin);
+        _begin += codec::size;
+        return true;
+    }
+
+    template <typename T>
+    bool read (T & value)
+    {
+        error_code ec;
+        auto r = read(value, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    bool read_varint (std::uint64_t & value, error_code & ec)
+    {
+        auto n = peek_varint(value, ec);
+        _begin += n;
+        return n > 0;
+    }
+
+    bool read_varint (std::uint64_t & value)
+    {
+        error_code ec;
+        auto r = read_varint(value, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Reads up to @a count varints using bulk decoder.
+     *
+     * @return Number of values read, less than @a count at the end of
+     *         stream, on error or if nonblocking device has no more data.
+     */
+    size_t read_varints (std::uint64_t * out, size_t count, error_code & ec)
+    {
+        size_t done = 0;
+
+        while (done < count) {
+            char const * first = _buf.data() + _begin;
+            done += decode_varints(first, _buf.data() + _end, out + done, count - done, ec);
+            _begin = static_cast<size_t>(first - _buf.data());
+
+            if (ec)
+                break;
+
+            // Incomplete value at the end of buffer
+            if (done < count && !ensure(_end - _begin + 1, ec))
+                break;
+        }
+
+        return done;
+    }
+
+    size_t read_varints (std::uint64_t * out, size_t count)
+    {
+        error_code ec;
+        auto r = read_varints(out, count, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    bool read_zigzag (std::int64_t & value, error_code & ec)
+    {
+        std::uint64_t u = 0;
+
+        if (!read_varint(u, ec))
+            return false;
+
+        value = zigzag_decode(u);
+        return true;
+    }
+
+    bool read_zigzag (std::int64_t & value)
+    {
+        error_code ec;
+        auto r = read_zigzag(value, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Reads @a n raw bytes.
+     */
+    bool read_bytes (char * data, size_t n, error_code & ec)
+    {
+        if (!ensure(n, ec))
+            return false;
+
+        if (n > 0)
+            std::memcpy(data, _buf.data() + _begin, n);
+
+        _begin += n;
+        return true;
+    }
+
+    bool read_bytes (char * data, size_t n)
+    {
+        error_code ec;
+        auto r = read_bytes(data, n, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Reads length-prefixed string as a view into internal buffer, valid
+     * until the next read call.
+     */
+    bool read_string (bytes_view & s, error_code & ec)
+    {
+        size_t n = 0;
+
+        if (!read_string_head(n, ec))
+            return false;
+
+        s = bytes_view{_buf.data() + _begin, n};
+        _begin += n;
+        return true;
+    }
+
+    bool read_string (std::string & s, error_code & ec)
+    {
+        bytes_view view;
+
+        if (!read_string(view, ec))
+            return false;
+
+        s.assign(view.data(), view.size());
+        return true;
+    }
+
+    template <typename String>
+    bool read_string (String & s)
+    {
+        error_code ec;
+        auto r = read_string(s, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * @return @c true if device reached end of stream and all data are
+     *         consumed.
+     */
+    bool at_end () const noexcept
+    {
+        return _eof && _begin == _end;
+    }
+};
+
+using binary_writer = basic_binary_writer<device>;
+using binary_reader = basic_binary_reader<device>;
+
+}} // pfs::io
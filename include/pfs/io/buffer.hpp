@@ -85,6 +85,94 @@ public:
         _c->append(bytes, n);
         return static_cast<ssize_t>(n);
     }
+
+    /**
+     * Reads up to @a n bytes starting at @a offset without changing the read
+     * position.
+     *
+     * @return Number of bytes read or -1 on error.
+     */
+    ssize_t read_at (char * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) const noexcept
+    {
+        if (!(_oflags & read_only) || offset < 0) {
+            ec = make_error_code(errc::invalid_argument);
+            return -1;
+        }
+
+        auto pos = static_cast<size_t>(offset);
+
+        if (pos >= _c->size())
+            return 0;
+
+        n = std::min(n, _c->size() - pos);
+        _c->copy(bytes, n, pos);
+
+        return static_cast<ssize_t>(n);
+    }
+
+    /**
+     * Overwrites bytes starting at @a offset, extending the container if
+     * needed. Writing past the end of the container is an error since there
+     * is no notion of holes for a buffer.
+     *
+     * @return Number of bytes written or -1 on error.
+     */
+    ssize_t write_at (char const * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) noexcept
+    {
+        if (!(_oflags & write_only) || offset < 0
+                || static_cast<size_t>(offset) > _c->size()) {
+            ec = make_error_code(errc::invalid_argument);
+            return -1;
+        }
+
+        auto pos = static_cast<size_t>(offset);
+
+        if (n > _c->max_size() - pos) {
+            ec = make_error_code(errc::device_too_large);
+            return -1;
+        }
+
+        _c->replace(pos, std::min(n, _c->size() - pos), bytes, n);
+        return static_cast<ssize_t>(n);
+    }
+
+    /**
+     * Sets read position.
+     *
+     * @return Resulting position or -1 on error.
+     */
+    offset_type seek (offset_type offset, seek_origin origin, error_code & ec) noexcept
+    {
+        offset_type base = 0;
+
+        switch (origin) {
+            case seek_origin::begin  : base = 0; break;
+            case seek_origin::current: base = static_cast<offset_type>(_pos); break;
+            case seek_origin::end    : base = static_cast<offset_type>(_c->size()); break;
+        }
+
+        if (base + offset < 0) {
+            ec = make_error_code(errc::invalid_argument);
+            return -1;
+        }
+
+        _pos = static_cast<size_t>(base + offset);
+        return static_cast<offset_type>(_pos);
+    }
+
+    /**
+     * @return Current read position.
+     */
+    offset_type tell (error_code &) const noexcept
+    {
+        return static_cast<offset_type>(_pos);
+    }
 };
 
 template <typename ContiguousContainer>
@@ -93,4 +181,13 @@ inline device make_buffer (ContiguousContainer & container, open_mode_flags ofla
     return device(new buffer<ContiguousContainer>{container, oflags});
 }
 
+template <typename ContiguousContainer>
+inline static_device<buffer<ContiguousContainer>> make_static_buffer (
+          ContiguousContainer & container
+        , open_mode_flags oflags)
+{
+    return static_device<buffer<ContiguousContainer>>{
+        buffer<ContiguousContainer>{container, oflags}};
+}
+
 }} // pfs::io
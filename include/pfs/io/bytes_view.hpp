@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace pfs {
+namespace io {
+
+/**
+ * @brief Non-owning view of a contiguous byte sequence (C++11 substitute for
+ *        std::string_view).
+ */
+class bytes_view
+{
+    char const * _data {nullptr};
+    size_t _size {0};
+
+public:
+    using const_iterator = char const *;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    constexpr bytes_view () noexcept {}
+
+    constexpr bytes_view (char const * data, size_t n) noexcept
+        : _data(data)
+        , _size(n)
+    {}
+
+    bytes_view (std::string const & s) noexcept
+        : _data(s.data())
+        , _size(s.size())
+    {}
+
+    constexpr char const * data () const noexcept
+    {
+        return _data;
+    }
+
+    constexpr size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    constexpr bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    constexpr char operator [] (size_t i) const noexcept
+    {
+        return _data[i];
+    }
+
+    constexpr const_iterator begin () const noexcept
+    {
+        return _data;
+    }
+
+    constexpr const_iterator end () const noexcept
+    {
+        return _data + _size;
+    }
+
+    /**
+     * View of at most @a n bytes starting at @a pos (clamped to the view).
+     */
+    bytes_view substr (size_t pos, size_t n = npos) const noexcept
+    {
+        pos = std::min(pos, _size);
+        return bytes_view{_data + pos, std::min(n, _size - pos)};
+    }
+
+    std::string to_string () const
+    {
+        return std::string(_data, _size);
+    }
+};
+
+inline bool operator == (bytes_view const & a, bytes_view const & b) noexcept
+{
+    return a.size() == b.size()
+        && (a.size() == 0 || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator != (bytes_view const & a, bytes_view const & b) noexcept
+{
+    return !(a == b);
+}
+
+}} // pfs::io
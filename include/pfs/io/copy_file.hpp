@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Copying file onto itself is rejected
+//      2026.10.19 Truncated source is reported, empty in-kernel copy falls
+//                 back to buffered one
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+namespace platform {
+namespace file {
+
+#if defined(PFS_OS_LINUX)
+    using unix_ns::file::is_same_file;
+    using unix_ns::file::clone;
+    using unix_ns::file::copy_range;
+    using unix_ns::file::send_range;
+#endif
+
+}} // platform::file
+
+/**
+ * Method used to copy file data, from the fastest to the slowest.
+ */
+enum class copy_method
+{
+      none            /**< Nothing copied (source has no data or error occurred) */
+    , reflink         /**< Extents shared with source (copy-on-write clone) */
+    , copy_file_range /**< In-kernel copy, may be offloaded to storage */
+    , sendfile        /**< In-kernel copy through page cache */
+    , buffered        /**< Read/write loop through userspace buffer */
+};
+
+struct copy_options
+{
+    bool allow_reflink {true};
+    bool allow_copy_file_range {true};
+    bool allow_sendfile {true};
+
+    // Copy data regions only and recreate holes in destination
+    bool preserve_sparse {true};
+
+    // Buffer size for buffered copy, also limits size of a single in-kernel
+    // copy request
+    size_t buffer_size {1024 * 1024};
+
+    // Permissions for destination file if it does not exist
+    permissions perms {owner_read | owner_write};
+};
+
+namespace details {
+
+inline bool method_unsupported (error_code const & ec)
+{
+    return ec == std::errc::function_not_supported
+        || ec == std::errc::operation_not_supported
+        || ec == std::errc::cross_device_link
+        || ec == std::errc::inappropriate_io_control_operation
+        || ec == make_error_code(errc::operation_not_supported)
+        || ec == make_error_code(errc::invalid_argument)
+        || ec == make_error_code(errc::bad_file_descriptor);
+}
+
+/**
+ * Copies range [offset, offset + len) with specified method. In-kernel copy
+ * that transfers nothing (e.g. file system does not support it for the file)
+ * is replaced with buffered one, @a method is updated in this case.
+ *
+ * @return Number of bytes copied or -1 on error. Source file truncated while
+ *         copying is reported with errc::unexpected_end_of_file.
+ */
+inline offset_type copy_extent (file & src
+    , file & dest
+    , offset_type offset
+    , offset_type len
+    , copy_method & method
+    , std::vector<char> & buffer
+    , error_code & ec)
+{
+    offset_type total = 0;
+
+    if (method == copy_method::sendfile) {
+        if (dest.seek(offset, seek_origin::begin, ec) < 0)
+            return -1;
+    }
+
+    while (total < len) {
+        auto chunk = static_cast<size_t>(std::min<offset_type>(len - total
+            , static_cast<offset_type>(buffer.size())));
+        auto pos = offset + total;
+        ssize_t n = 0;
+
+        switch (method) {
+            case copy_method::copy_file_range:
+                n = platform::file::copy_range(& src.handle(), pos
+                    , & dest.handle(), pos, chunk, ec);
+                break;
+
+            case copy_method::sendfile:
+                n = platform::file::send_range(& src.handle(), pos
+                    , & dest.handle(), chunk, ec);
+                break;
+
+            default: {
+                n = src.read_at(buffer.data(), chunk, pos, ec);
+
+                for (ssize_t written = 0; n > 0 && written < n; ) {
+                    auto w = dest.write_at(buffer.data() + written
+                        , static_cast<size_t>(n - written)
+                        , pos + written
+                        , ec);
+
+                    if (w < 0)
+                        return total > 0 ? total : -1;
+
+                    written += w;
+                }
+
+                break;
+            }
+        }
+
+        if (n < 0)
+            return total > 0 ? total : -1;
+
+        if (n == 0) {
+            if (method != copy_method::buffered) {
+                method = copy_method::buffered;
+                continue;
+            }
+
+            // Source file was truncated while copying
+            ec = make_error_code(errc::unexpected_end_of_file);
+            return total > 0 ? total : -1;
+        }
+
+        total += n;
+    }
+
+    return total;
+}
+
+} // details
+
+/**
+ * Copies regular file @a src_path to @a dest_path (destination is created or
+ * truncated). Destination referring to the source itself (the same path,
+ * symbolic or hard link) is rejected with errc::invalid_argument.
+ *
+ * Tries to clone file (reflink) first, then in-kernel copy
+ * (copy_file_range(), then sendfile()) and falls back to buffered copy.
+ * If @a options.preserve_sparse is set, only data regions of the source are
+ * copied, so holes are preserved.
+ *
+ * @return Method used for copying (the last one if copying fell back to
+ *         slower method), copy_method::none if source has no data or on
+ *         error (@a ec is set). Source truncated while copying is reported
+ *         with errc::unexpected_end_of_file.
+ */
+inline copy_method copy_file (std::string const & src_path
+    , std::string const & dest_path
+    , copy_options const & options
+    , error_code & ec)
+{
+    auto src = make_static_file(src_path, read_only, permission_none
+        , durability::none, ec);
+
+    if (ec)
+        return copy_method::none;
+
+    // Truncating destination would destroy the source
+    if (platform::file::is_same_file(& src.underlying().handle(), dest_path)) {
+        ec = make_error_code(errc::invalid_argument);
+        return copy_method::none;
+    }
+
+    auto dest = make_static_file(dest_path, write_only | truncate, options.perms
+        , durability::none, ec);
+
+    if (ec)
+        return copy_method::none;
+
+    auto & src_file = src.underlying();
+    auto & dest_file = dest.underlying();
+    auto size = src_file.size(ec);
+
+    if (ec)
+        return copy_method::none;
+
+    if (options.allow_reflink) {
+        ec = platform::file::clone(& src_file.handle(), & dest_file.handle());
+
+        if (!ec)
+            return copy_method::reflink;
+
+        if (!details::method_unsupported(ec))
+            return copy_method::none;
+
+        ec.clear();
+    }
+
+    std::vector<std::pair<offset_type, offset_type>> extents;
+
+    if (options.preserve_sparse) {
+        ec = src_file.for_each_data_extent([& extents] (offset_type offset
+                , offset_type len) {
+            extents.emplace_back(offset, len);
+        });
+
+        // SEEK_DATA/SEEK_HOLE unsupported, copy whole file
+        if (ec) {
+            ec.clear();
+            extents.clear();
+            extents.emplace_back(0, size);
+        }
+    } else {
+        extents.emplace_back(0, size);
+    }
+
+    copy_method method = options.allow_copy_file_range
+        ? copy_method::copy_file_range
+        : options.allow_sendfile
+            ? copy_method::sendfile
+            : copy_method::buffered;
+
+    copy_method used = copy_method::none;
+    std::vector<char> buffer(std::max(options.buffer_size, size_t{4096}));
+
+    for (auto const & extent: extents) {
+        auto offset = extent.first;
+        auto len = extent.second;
+
+        while (len > 0) {
+            auto n = details::copy_extent(src_file, dest_file, offset, len
+                , method, buffer, ec);
+
+            if (n > 0)
+                used = method;
+
+            if (ec) {
+                if (method == copy_method::buffered || !details::method_unsupported(ec))
+                    return copy_method::none;
+
+                // Fall down to the next method for the rest of data
+                ec.clear();
+                method = method == copy_method::copy_file_range && options.allow_sendfile
+                    ? copy_method::sendfile
+                    : copy_method::buffered;
+
+                if (n > 0) {
+                    offset += n;
+                    len -= n;
+                }
+
+                continue;
+            }
+
+            offset += n;
+            len -= n;
+        }
+    }
+
+    // Restore size (file may end with a hole)
+    ec = dest_file.resize(size);
+
+    return ec ? copy_method::none : used;
+}
+
+inline copy_method copy_file (std::string const & src_path
+    , std::string const & dest_path
+    , error_code & ec)
+{
+    return copy_file(src_path, dest_path, copy_options{}, ec);
+}
+
+inline copy_method copy_file (std::string const & src_path
+    , std::string const & dest_path
+    , copy_options const & options)
+{
+    error_code ec;
+    auto method = copy_file(src_path, dest_path, options, ec);
+    if (ec) throw exception(ec);
+    return method;
+}
+
+inline copy_method copy_file (std::string const & src_path
+    , std::string const & dest_path)
+{
+    return copy_file(src_path, dest_path, copy_options{});
+}
+
+}} // pfs::io
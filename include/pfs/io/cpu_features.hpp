@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// SIMD kernels are compiled with function target attributes, so no special
+// compiler flags are needed and the library still runs on CPUs without them.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define PFS_IO_X86_SIMD 1
+#   define PFS_IO_TARGET(isa) __attribute__((target(isa)))
+#   include <immintrin.h>
+#endif
+
+namespace pfs {
+namespace io {
+
+/**
+ * Instruction set extensions used by SIMD kernels, in ascending order.
+ */
+enum class simd_isa
+{
+      scalar
+    , sse2
+    , ssse3
+    , sse41
+    , avx2
+};
+
+struct cpu_features
+{
+    bool sse2 {false};
+    bool ssse3 {false};
+    bool sse41 {false};
+    bool sse42 {false};
+    bool avx2 {false};
+};
+
+inline cpu_features const & get_cpu_features ()
+{
+    static cpu_features const features = [] {
+        cpu_features f;
+#if defined(PFS_IO_X86_SIMD)
+        __builtin_cpu_init();
+        f.sse2  = __builtin_cpu_supports("sse2");
+        f.ssse3 = __builtin_cpu_supports("ssse3");
+        f.sse41 = __builtin_cpu_supports("sse4.1");
+        f.sse42 = __builtin_cpu_supports("sse4.2");
+        f.avx2  = __builtin_cpu_supports("avx2");
+#endif
+        return f;
+    }();
+
+    return features;
+}
+
+inline bool simd_isa_supported (simd_isa isa)
+{
+    auto const & f = get_cpu_features();
+
+    switch (isa) {
+        case simd_isa::scalar: return true;
+        case simd_isa::sse2:   return f.sse2;
+        case simd_isa::ssse3:  return f.ssse3;
+        case simd_isa::sse41:  return f.sse41;
+        case simd_isa::avx2:   return f.avx2;
+    }
+
+    return false;
+}
+
+/**
+ * Best instruction set supported by the CPU.
+ */
+inline simd_isa best_simd_isa ()
+{
+    return simd_isa_supported(simd_isa::avx2)  ? simd_isa::avx2
+        : simd_isa_supported(simd_isa::sse41) ? simd_isa::sse41
+        : simd_isa_supported(simd_isa::ssse3) ? simd_isa::ssse3
+        : simd_isa_supported(simd_isa::sse2)  ? simd_isa::sse2
+        : simd_isa::scalar;
+}
+
+}} // pfs::io
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//
+// References:
+//      1. [RFC 3720, B.4. CRC Examples](https://tools.ietf.org/html/rfc3720#appendix-B.4)
+//      2. [Slicing-by-8](https://create.stephan-brumme.com/crc32/#slicing-by-8-overview)
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace pfs {
+namespace io {
+
+namespace details {
+
+struct crc32c_table
+{
+    std::uint32_t t[8][256];
+
+    crc32c_table ()
+    {
+        // Reversed Castagnoli polynomial
+        std::uint32_t const poly = 0x82F63B78;
+
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t crc = i;
+
+            for (int j = 0; j < 8; j++)
+                crc = (crc >> 1) ^ (poly & (0 - (crc & 1)));
+
+            t[0][i] = crc;
+        }
+
+        for (std::uint32_t i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++)
+                t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+        }
+    }
+};
+
+inline crc32c_table const & get_crc32c_table ()
+{
+    static crc32c_table instance;
+    return instance;
+}
+
+} // details
+
+/**
+ * Computes CRC-32C (Castagnoli) checksum, continuing from @a crc (zero for
+ * the first block).
+ */
+inline std::uint32_t crc32c (std::uint32_t crc, char const * data, std::size_t n)
+{
+    auto const & t = details::get_crc32c_table().t;
+    auto p = reinterpret_cast<unsigned char const *>(data);
+
+    crc = ~crc;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Slicing-by-8 (relies on little-endian layout of 32-bit words)
+    while (n >= 8) {
+        std::uint32_t lo, hi;
+        std::memcpy(& lo, p, 4);
+        std::memcpy(& hi, p + 4, 4);
+        lo ^= crc;
+
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF]
+            ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF]
+            ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+
+        p += 8;
+        n -= 8;
+    }
+#endif
+
+    while (n--)
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+
+    return ~crc;
+}
+
+inline std::uint32_t crc32c (char const * data, std::size_t n)
+{
+    return crc32c(0, data, n);
+}
+
+}} // pfs::io
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "bytes_view.hpp"
+#include "cpu_features.hpp"
+#include "device.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+namespace details {
+
+using find_byte_func = char const * (*) (char const * first, char const * last, char c);
+
+/**
+ * Word-at-a-time search.
+ *
+ * @return Pointer to the first occurrence of @a c in [first, last) or @a last.
+ */
+inline char const * find_byte_scalar (char const * first, char const * last, char c)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::uint64_t const ones = 0x0101010101010101ULL;
+    std::uint64_t const highs = 0x8080808080808080ULL;
+    std::uint64_t const pattern = ones * static_cast<unsigned char>(c);
+
+    while (last - first >= 8) {
+        std::uint64_t w;
+        std::memcpy(& w, first, 8);
+        w ^= pattern;
+
+        // Lowest set bit marks the first zero byte (higher bytes may give
+        // false positives only after a real zero byte)
+        auto zero = (w - ones) & ~w & highs;
+
+        if (zero)
+            return first + (__builtin_ctzll(zero) >> 3);
+
+        first += 8;
+    }
+#endif
+
+    for (; first < last; ++first) {
+        if (*first == c)
+            return first;
+    }
+
+    return last;
+}
+
+#if defined(PFS_IO_X86_SIMD)
+
+PFS_IO_TARGET("sse2")
+inline char const * find_byte_sse2 (char const * first, char const * last, char c)
+{
+    __m128i const pattern = _mm_set1_epi8(c);
+
+    // 64 bytes per iteration, masks are combined only when a match found
+    while (last - first >= 64) {
+        auto p = reinterpret_cast<__m128i const *>(first);
+        __m128i m0 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 0), pattern);
+        __m128i m1 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 1), pattern);
+        __m128i m2 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 2), pattern);
+        __m128i m3 = _mm_cmpeq_epi8(_mm_loadu_si128(p + 3), pattern);
+        __m128i any = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+
+        if (_mm_movemask_epi8(any)) {
+            std::uint64_t mask = static_cast<std::uint64_t>(_mm_movemask_epi8(m0) & 0xFFFF)
+                | static_cast<std::uint64_t>(_mm_movemask_epi8(m1) & 0xFFFF) << 16
+                | static_cast<std::uint64_t>(_mm_movemask_epi8(m2) & 0xFFFF) << 32
+                | static_cast<std::uint64_t>(_mm_movemask_epi8(m3) & 0xFFFF) << 48;
+            return first + __builtin_ctzll(mask);
+        }
+
+        first += 64;
+    }
+
+    while (last - first >= 16) {
+        __m128i m = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(first)), pattern);
+        int mask = _mm_movemask_epi8(m);
+
+        if (mask)
+            return first + __builtin_ctz(mask);
+
+        first += 16;
+    }
+
+    return find_byte_scalar(first, last, c);
+}
+
+PFS_IO_TARGET("avx2")
+inline char const * find_byte_avx2 (char const * first, char const * last, char c)
+{
+    __m256i const pattern = _mm256_set1_epi8(c);
+
+    while (last - first >= 64) {
+        auto p = reinterpret_cast<__m256i const *>(first);
+        __m256i m0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p + 0), pattern);
+        __m256i m1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(p + 1), pattern);
+
+        if (!_mm256_testz_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m0, m1))) {
+            std::uint64_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m0))
+                | static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m1))) << 32;
+            return first + __builtin_ctzll(mask);
+        }
+
+        first += 64;
+    }
+
+    while (last - first >= 32) {
+        __m256i m = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(first)), pattern);
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+
+        if (mask)
+            return first + __builtin_ctz(mask);
+
+        first += 32;
+    }
+
+    return find_byte_sse2(first, last, c);
+}
+
+#endif // PFS_IO_X86_SIMD
+
+/**
+ * Selects the best byte search kernel not exceeding @a isa and supported by
+ * the CPU.
+ */
+inline find_byte_func select_find_byte (simd_isa isa)
+{
+#if defined(PFS_IO_X86_SIMD)
+    if (isa >= simd_isa::avx2 && simd_isa_supported(simd_isa::avx2))
+        return find_byte_avx2;
+
+    if (isa >= simd_isa::sse2 && simd_isa_supported(simd_isa::sse2))
+        return find_byte_sse2;
+#else
+    (void)isa;
+#endif
+
+    return find_byte_scalar;
+}
+
+} // details
+
+/**
+ * Finds first occurrence of byte @a c in [first, last) using the best
+ * kernel for the CPU.
+ *
+ * @return Pointer to the byte found or @a last.
+ */
+inline char const * find_byte (char const * first, char const * last, char c)
+{
+    static details::find_byte_func const f = details::select_find_byte(best_simd_isa());
+    return f(first, last, c);
+}
+
+struct delimited_reader_options
+{
+    // Record delimiter, one or more bytes
+    std::string delimiter {"\n"};
+
+    // Initial buffer size
+    size_t buffer_size {64 * 1024};
+
+    // Buffer grows up to this size to fit a long record
+    size_t max_record_size {16 * 1024 * 1024};
+
+    // Upper bound for instruction set used to scan for delimiter
+    simd_isa isa {best_simd_isa()};
+};
+
+/**
+ * @brief Splits data read from device into delimited records.
+ *
+ * Records are returned as views into internal buffer without copying. A view
+ * remains valid until the next call of read_record().
+ *
+ * @tparam Device @c device, @c static_device or any type with read() and
+ *         is_nonblocking().
+ */
+template <typename Device = device>
+class basic_delimited_reader
+{
+    Device * _d {nullptr};
+    std::string _delimiter;
+    size_t _max_record_size;
+    details::find_byte_func _find;
+
+    std::vector<char> _buf;
+    size_t _begin {0}; // start of unconsumed data
+    size_t _scan {0};  // data before this position contains no delimiter
+    size_t _end {0};   // end of data
+    bool _eof {false};
+
+private:
+    char const * find_delimiter (char const * first, char const * last) const
+    {
+        auto dlen = _delimiter.size();
+        char const dfirst = _delimiter[0];
+
+        if (static_cast<size_t>(last - first) < dlen)
+            return nullptr;
+
+        // Candidate positions end where the rest of delimiter does not fit
+        auto candidates_last = last - (dlen - 1);
+
+        while (first < candidates_last) {
+            auto p = _find(first, candidates_last, dfirst);
+
+            if (p == candidates_last)
+                return nullptr;
+
+            if (dlen == 1 || std::memcmp(p + 1, _delimiter.data() + 1, dlen - 1) == 0)
+                return p;
+
+            first = p + 1;
+        }
+
+        return nullptr;
+    }
+
+public:
+    basic_delimited_reader (Device & d
+        , delimited_reader_options const & options = delimited_reader_options{})
+        : _d(& d)
+        , _delimiter(options.delimiter.empty() ? std::string{"\n"} : options.delimiter)
+        , _max_record_size(std::max(options.max_record_size, _delimiter.size()))
+        , _find(details::select_find_byte(options.isa))
+        , _buf(std::max(std::min(options.buffer_size, _max_record_size), size_t{1}))
+    {}
+
+    /**
+     * Reads next record (without delimiter). Last record of the stream may
+     * have no delimiter.
+     *
+     * @return @c true if record is available, @c false at the end of stream,
+     *         on error (@a ec is set) or if nonblocking device has no more
+     *         data for now.
+     */
+    bool read_record (bytes_view & record, error_code & ec)
+    {
+        for (;;) {
+            auto data = _buf.data();
+            auto p = find_delimiter(data + _scan, data + _end);
+
+            if (p) {
+                record = bytes_view{data + _begin, static_cast<size_t>(p - (data + _begin))};
+                _begin = static_cast<size_t>(p - data) + _delimiter.size();
+                _scan = _begin;
+                return true;
+            }
+
+            // Tail shorter than delimiter may be the beginning of it
+            _scan = std::max(_begin, _end - std::min(_end, _delimiter.size() - 1));
+
+            if (_eof) {
+                if (_begin == _end)
+                    return false;
+
+                record = bytes_view{data + _begin, _end - _begin};
+                _begin = _scan = _end;
+                return true;
+            }
+
+            if (_end == _buf.size()) {
+                if (_begin > 0) {
+                    std::memmove(data, data + _begin, _end - _begin);
+                    _end -= _begin;
+                    _scan -= _begin;
+                    _begin = 0;
+                } else if (_buf.size() < _max_record_size + _delimiter.size()) {
+                    _buf.resize(std::min(_buf.size() * 2, _max_record_size + _delimiter.size()));
+                } else {
+                    ec = make_error_code(errc::message_size);
+                    return false;
+                }
+            }
+
+            auto n = _d->read(_buf.data() + _end, _buf.size() - _end, ec);
+
+            if (n < 0)
+                return false;
+
+            if (n == 0) {
+                // Nothing available for now
+                if (_d->is_nonblocking())
+                    return false;
+
+                _eof = true;
+                continue;
+            }
+
+            _end += static_cast<size_t>(n);
+        }
+    }
+
+    bool read_record (bytes_view & record)
+    {
+        error_code ec;
+        auto r = read_record(record, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * @return @c true if device reached end of stream and all records are
+     *         consumed.
+     */
+    bool at_end () const noexcept
+    {
+        return _eof && _begin == _end;
+    }
+};
+
+using delimited_reader = basic_delimited_reader<device>;
+
+}} // pfs::io
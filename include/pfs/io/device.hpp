@@ -5,15 +5,32 @@
 //
 // Changelog:
 //      2019.08.22 Initial version
+//      2026.10.18 Added statically typed device (static_device)
+//      2026.10.18 Added offset_type, seek_origin and io_vector
+//      2026.10.18 Added durability policy
+//      2026.10.18 Added direct open mode
+//      2026.10.18 Added access advice
+//      2026.10.18 Added vectored write (writev)
+//      2026.10.18 Added rudp_socket device type
+//      2026.10.18 Added packet timestamps
+//      2026.10.19 Added error codes for framing, protocol and unsupported
+//                 operation errors
+//      2026.10.19 Added data corruption error code
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "operationsystem.h"
+#include <chrono>
 #include <exception>
 #include <memory>
 #include <string>
 #include <system_error>
+#include <utility>
 #include <cstdint>
 
+#if defined(PFS_OS_LINUX)
+#   include <sys/uio.h>
+#endif
+
 namespace pfs {
 namespace io {
 
@@ -31,10 +48,85 @@ enum open_mode_enum
     , write_read   = read_write              /**< Synonym for read_write */
     , non_blocking = 0x0004                  /**< Open device in non-blocking mode */
     , truncate     = 0x0010                  /**< Create device (only for regular file device) */
+    , direct       = 0x0020                  /**< Bypass page cache (only for regular file device) */
 };
 
 using open_mode_flags = std::underlying_type<open_mode_enum>::type;
 
+/**
+ * Durability policy of a file device: how data is flushed on close() or by
+ * explicit sync().
+ */
+enum class durability
+{
+      none       /**< Leave flushing to the operating system */
+    , data_sync  /**< Flush data and metadata needed to read it back (fdatasync) */
+    , full_sync  /**< Flush data and all metadata (fsync) */
+    , writeback  /**< Initiate writeback of dirty pages without waiting (sync_file_range) */
+};
+
+/**
+ * Expected access pattern of a file device, used to tune kernel readahead
+ * and page cache behaviour.
+ */
+enum class access_advice
+{
+      normal     /**< No special treatment */
+    , sequential /**< Data will be read sequentially (aggressive readahead) */
+    , random     /**< Data will be read in random order (no readahead) */
+    , willneed   /**< Data will be accessed in the near future */
+    , dontneed   /**< Data will not be accessed in the near future */
+    , noreuse    /**< Data will be accessed only once */
+};
+
+/**
+ * Packet timestamps taken by socket devices (see udp_socket and tcp_socket
+ * enable_timestamping()).
+ */
+enum timestamping_enum
+{
+      rx_software_timestamp = 0x0001 /**< Received packets, by the kernel */
+    , rx_hardware_timestamp = 0x0002 /**< Received packets, by the network adapter */
+    , tx_software_timestamp = 0x0004 /**< Sent packets, when passed to the driver */
+    , tx_hardware_timestamp = 0x0008 /**< Sent packets, by the network adapter */
+};
+
+using timestamping_flags = std::underlying_type<timestamping_enum>::type;
+
+struct packet_timestamps
+{
+    // Since epoch of system (realtime) clock, zero if not taken
+    std::chrono::nanoseconds software {0};
+
+    // Network adapter clock, zero if not taken
+    std::chrono::nanoseconds hardware {0};
+};
+
+/**
+ * Offset (position) inside a random access device (file, buffer).
+ */
+using offset_type = std::int64_t;
+
+enum class seek_origin
+{
+      begin   /**< Offset is relative to the beginning of the device */
+    , current /**< Offset is relative to the current position */
+    , end     /**< Offset is relative to the end of the device */
+};
+
+/**
+ * Element of scatter/gather array for vectored I/O.
+ */
+#if defined(PFS_OS_LINUX)
+using io_vector = ::iovec;
+#else
+struct io_vector
+{
+    void * iov_base;
+    size_t iov_len;
+};
+#endif
+
 enum class device_type
 {
       unknown = 0
@@ -47,6 +139,7 @@ enum class device_type
     , tcp_socket
     , tcp_peer
     , udp_socket
+    , rudp_socket
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +173,29 @@ enum class errc
     , device_too_large
     , stream
     , timedout
+
+    // The operation is not supported by the device, kernel or platform.
+    , operation_not_supported
+
+    // Nonblocking device accepted no data, the operation must be repeated
+    // when the device becomes writable.
+    , operation_would_block
+    , operation_canceled
+
+    // The message is too long (e.g. frame exceeds the limit).
+    , message_size
+
+    // Malformed data (e.g. frame, record or packet) received.
+    , bad_message
+    , connection_reset
+    , connection_aborted
+    , broken_pipe
+
+    // File ended earlier than expected (e.g. truncated while copying).
+    , unexpected_end_of_file
+
+    // Stored data failed integrity check (e.g. corrupted log record).
+    , data_corruption
 };
 
 class error_category : public std::error_category
@@ -135,6 +251,36 @@ public:
             case static_cast<int>(errc::timedout):
                 return std::string{"timed out"};
 
+            case static_cast<int>(errc::operation_not_supported):
+                return std::string{"operation not supported"};
+
+            case static_cast<int>(errc::operation_would_block):
+                return std::string{"operation would block"};
+
+            case static_cast<int>(errc::operation_canceled):
+                return std::string{"operation canceled"};
+
+            case static_cast<int>(errc::message_size):
+                return std::string{"message too long"};
+
+            case static_cast<int>(errc::bad_message):
+                return std::string{"bad message"};
+
+            case static_cast<int>(errc::connection_reset):
+                return std::string{"connection reset"};
+
+            case static_cast<int>(errc::connection_aborted):
+                return std::string{"connection aborted"};
+
+            case static_cast<int>(errc::broken_pipe):
+                return std::string{"broken pipe"};
+
+            case static_cast<int>(errc::unexpected_end_of_file):
+                return std::string{"unexpected end of file"};
+
+            case static_cast<int>(errc::data_corruption):
+                return std::string{"data corruption"};
+
             default: return std::string{"unknown I/O error"};
         }
     }
@@ -172,7 +318,7 @@ inline std::error_code make_error_code_from_errno (int e)
 
         default: break;
     }
-    return error_code(errno, std::generic_category());
+    return error_code(e, std::generic_category());
 }
 #endif
 
@@ -210,6 +356,31 @@ public:
 
     virtual ssize_t write (char const * bytes, size_t n, error_code & ec) noexcept = 0;
 
+    /**
+     * Gathers data from @a iovcnt buffers. Default implementation writes
+     * buffers one by one, devices override it with a single system call.
+     *
+     * @return Number of bytes written or -1 on error.
+     */
+    virtual ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept
+    {
+        ssize_t total = 0;
+
+        for (int i = 0; i < iovcnt; i++) {
+            auto n = write(static_cast<char const *>(iov[i].iov_base), iov[i].iov_len, ec);
+
+            if (n < 0)
+                return total > 0 ? total : -1;
+
+            total += n;
+
+            if (static_cast<size_t>(n) < iov[i].iov_len)
+                break;
+        }
+
+        return total;
+    }
+
     virtual error_code close () = 0;
 
     virtual bool opened () const noexcept = 0;
@@ -303,6 +474,11 @@ public:
         return _d->write(bytes, n, ec);
     }
 
+    inline ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept
+    {
+        return _d->writev(iov, iovcnt, ec);
+    }
+
     inline void swap (device & rhs)
     {
         _d.swap(rhs._d);
@@ -481,4 +657,136 @@ inline UnderlyingDevice const * underlying_device (device const & dev)
             : nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Statically typed device
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Statically typed counterpart of @c device.
+ *
+ * Holds the underlying device by value and calls its methods with qualified
+ * names, so there is no virtual dispatch and no heap indirection on the
+ * read/write path and platform wrappers can be inlined. Use @c device when
+ * devices of different types must be handled uniformly.
+ */
+template <typename Impl>
+class static_device
+{
+public:
+    using underlying_type = Impl;
+
+private:
+    Impl _d;
+
+public:
+    static_device () {}
+    explicit static_device (Impl && d) : _d(std::move(d)) {}
+    static_device (static_device &&) = default;
+    static_device & operator = (static_device &&) = default;
+
+    static_device (static_device const &) = delete;
+    static_device & operator = (static_device const &) = delete;
+
+    ~static_device () {
+        if (opened())
+            close();
+    }
+
+    /**
+     * Static device always owns the underlying device, so it is considered
+     * null while the underlying device is not opened.
+     */
+    inline bool is_null () const noexcept
+    {
+        return !opened();
+    }
+
+    inline device_type type () const noexcept
+    {
+        return _d.Impl::type();
+    }
+
+    inline open_mode_flags open_mode () const noexcept
+    {
+        return _d.Impl::open_mode();
+    }
+
+    inline bool has_pending_data () noexcept
+    {
+        return _d.Impl::has_pending_data();
+    }
+
+    inline bool is_readable () const noexcept
+    {
+        return open_mode() & read_only;
+    }
+
+    inline bool is_writable () const noexcept
+    {
+        return open_mode() & write_only;
+    }
+
+    inline bool is_nonblocking () const noexcept
+    {
+        return open_mode() & non_blocking;
+    }
+
+    inline error_code close ()
+    {
+        return _d.Impl::close();
+    }
+
+    inline bool opened () const noexcept
+    {
+        return _d.Impl::opened();
+    }
+
+    inline ssize_t read (char * bytes, size_t n, error_code & ec) noexcept
+    {
+        return _d.Impl::read(bytes, n, ec);
+    }
+
+    inline ssize_t read (char * bytes, size_t n)
+    {
+        error_code ec;
+        ssize_t r = read(bytes, n, ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+
+    inline ssize_t write (char const * bytes, size_t n, error_code & ec) noexcept
+    {
+        return _d.Impl::write(bytes, n, ec);
+    }
+
+    inline ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept
+    {
+        return _d.Impl::writev(iov, iovcnt, ec);
+    }
+
+    inline void swap (static_device & rhs)
+    {
+        using std::swap;
+        swap(_d, rhs._d);
+    }
+
+    inline void invalidate ()
+    {
+        static_device tmp;
+        swap(tmp);
+    }
+
+    /**
+     * Gives access to device specific API (e.g. udp_socket::write_to).
+     */
+    inline Impl & underlying () noexcept
+    {
+        return _d;
+    }
+
+    inline Impl const & underlying () const noexcept
+    {
+        return _d;
+    }
+};
+
 }} // pfs::io
@@ -0,0 +1,677 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Exact loss statistics, late packets counted separately
+//
+// References:
+//      1. [RFC 5510, Reed-Solomon Forward Error Correction (FEC) Schemes](https://tools.ietf.org/html/rfc5510)
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "binary_stream.hpp"
+#include "bytes_view.hpp"
+#include "device.hpp"
+#include "gf256.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+//
+// Forward error correction for datagram streams. Source packets are grouped
+// by source_count, every group is followed by repair_count repair packets,
+// any source_count packets of a group restore all its source packets.
+// Every packet starts with header (big-endian):
+//
+//      [u32 group][u8 index][u8 source count][u8 repair count][u8 version]
+//
+// Source packet (index < source count) carries payload as is, so it is sent
+// and delivered without delay. Repair packet i carries sum over source
+// packets j of C(i, j) * ([u16 payload size][payload]) padded with zeros to
+// the longest one. C is Cauchy matrix with columns scaled so that its first
+// row consists of ones: single repair packet is XOR parity, more repair
+// packets make Reed-Solomon (MDS) code. Group closed early by flush() has
+// fewer source packets, their actual count is carried by repair packets.
+//
+
+namespace pfs {
+namespace io {
+
+struct fec_options
+{
+    // Source packets per group
+    size_t source_count {8};
+
+    // Repair packets per group (1 is XOR parity), source_count + repair_count
+    // must not exceed 256
+    size_t repair_count {1};
+
+    // Maximum source payload size
+    size_t max_payload {1200};
+
+    // Groups kept by decoder waiting for repair packets
+    size_t decoder_window {16};
+};
+
+struct fec_stats
+{
+    size_t source_packets {0};  // received source packets
+    size_t repair_packets {0};  // received repair packets
+    size_t recovered {0};       // source packets restored from repair packets
+    size_t unrecoverable {0};   // source packets lost in groups given up
+    size_t duplicates {0};
+    size_t late {0};            // packets of groups already given up
+};
+
+namespace details {
+namespace fec {
+
+constexpr size_t header_size = 8;
+constexpr std::uint8_t version = 1;
+
+struct header
+{
+    std::uint32_t group;
+    std::uint8_t index;
+    std::uint8_t source_count;
+    std::uint8_t repair_count;
+};
+
+inline void encode_header (header const & h, char * out) noexcept
+{
+    field_codec<std::uint32_t, endian::big>::encode(h.group, out);
+    out[4] = static_cast<char>(h.index);
+    out[5] = static_cast<char>(h.source_count);
+    out[6] = static_cast<char>(h.repair_count);
+    out[7] = static_cast<char>(version);
+}
+
+inline bool decode_header (char const * in, size_t n, header & h) noexcept
+{
+    if (n < header_size || static_cast<std::uint8_t>(in[7]) != version)
+        return false;
+
+    h.group        = field_codec<std::uint32_t, endian::big>::decode(in);
+    h.index        = static_cast<std::uint8_t>(in[4]);
+    h.source_count = static_cast<std::uint8_t>(in[5]);
+    h.repair_count = static_cast<std::uint8_t>(in[6]);
+
+    return h.source_count > 0 && h.repair_count > 0
+        && h.source_count + h.repair_count <= 256
+        && h.index < h.source_count + h.repair_count;
+}
+
+/**
+ * Coefficient of source packet @a j in repair packet @a i.
+ */
+inline std::uint8_t coefficient (size_t i, size_t j)
+{
+    // Cauchy matrix 1 / (x_i + y_j) with x_i = 255 - i and y_j = j, column j
+    // is divided by its first element
+    auto x0 = static_cast<std::uint8_t>(255);
+    auto xi = static_cast<std::uint8_t>(255 - i);
+    auto y = static_cast<std::uint8_t>(j);
+    return gf256_div(x0 ^ y, xi ^ y);
+}
+
+}} // details::fec
+
+/**
+ * @brief FEC encoder: wraps payloads into source packets and adds repair
+ *        packets after each group.
+ *
+ * Repair packets are accumulated while source packets pass, so source
+ * payloads are not stored.
+ */
+class fec_encoder
+{
+    fec_options _options;
+    std::uint32_t _group {0};
+    size_t _count {0};          // source packets in current group
+    size_t _repair_size {0};    // longest symbol in current group
+    std::vector<std::vector<char>> _repair; // header and symbol
+    std::vector<char> _packet;
+
+public:
+    /**
+     * Options must be valid: source_count and repair_count in [1, 255]
+     * (their sum not more than 256) and max_payload in [1, 65535].
+     */
+    explicit fec_encoder (fec_options const & options = fec_options{})
+        : _options(options)
+        , _repair(options.repair_count
+            , std::vector<char>(details::fec::header_size + 2 + options.max_payload))
+        , _packet(details::fec::header_size + 2 + options.max_payload)
+    {}
+
+    fec_options const & options () const noexcept
+    {
+        return _options;
+    }
+
+    /**
+     * Passes source packet carrying @a n bytes to @a send, then repair
+     * packets if the group is complete. @a send is called as
+     * send(char const * packet, size_t size, error_code & ec) and returns
+     * @c false on error. Packet that failed to send is still protected by
+     * repair packets.
+     *
+     * @return @c false with errc::message_size if payload exceeds
+     *         fec_options::max_payload or if @a send fails.
+     */
+    template <typename Send>
+    bool encode (char const * data, size_t n, Send && send, error_code & ec)
+    {
+        if (n > _options.max_payload) {
+            ec = make_error_code(errc::message_size);
+            return false;
+        }
+
+        auto const header_size = details::fec::header_size;
+        details::fec::header h {_group, static_cast<std::uint8_t>(_count)
+            , static_cast<std::uint8_t>(_options.source_count)
+            , static_cast<std::uint8_t>(_options.repair_count)};
+
+        // Symbol is payload prefixed with its size, the prefix takes the last
+        // header bytes until the header is written
+        auto symbol = _packet.data() + header_size - 2;
+        field_codec<std::uint16_t, endian::big>::encode(static_cast<std::uint16_t>(n), symbol);
+        std::memcpy(_packet.data() + header_size, data, n);
+        auto symbol_size = n + 2;
+
+        if (symbol_size > _repair_size) {
+            for (auto & r: _repair) {
+                std::memset(r.data() + header_size + _repair_size, 0
+                    , symbol_size - _repair_size);
+            }
+
+            _repair_size = symbol_size;
+        }
+
+        for (size_t i = 0; i < _repair.size(); i++) {
+            gf256_mul_add_region(details::fec::coefficient(i, _count)
+                , symbol, _repair[i].data() + header_size, symbol_size);
+        }
+
+        details::fec::encode_header(h, _packet.data());
+        bool success = send(static_cast<char const *>(_packet.data()), header_size + n, ec);
+        _count++;
+
+        if (_count == _options.source_count) {
+            error_code flush_ec;
+
+            if (!flush(send, flush_ec) && success) {
+                ec = flush_ec;
+                success = false;
+            }
+        }
+
+        return success;
+    }
+
+    /**
+     * Closes current group sending its repair packets. Called after
+     * a burst of packets to protect its tail without waiting for further
+     * packets.
+     */
+    template <typename Send>
+    bool flush (Send && send, error_code & ec)
+    {
+        if (_count == 0)
+            return true;
+
+        auto const header_size = details::fec::header_size;
+        bool success = true;
+
+        for (size_t i = 0; i < _repair.size(); i++) {
+            details::fec::header h {_group
+                , static_cast<std::uint8_t>(_count + i)
+                , static_cast<std::uint8_t>(_count)
+                , static_cast<std::uint8_t>(_options.repair_count)};
+
+            details::fec::encode_header(h, _repair[i].data());
+
+            if (success && !send(static_cast<char const *>(_repair[i].data())
+                    , header_size + _repair_size, ec)) {
+                success = false;
+            }
+        }
+
+        _group++;
+        _count = 0;
+        _repair_size = 0;
+        return success;
+    }
+};
+
+/**
+ * @brief FEC decoder: delivers source payloads as they arrive and restores
+ *        lost ones from repair packets.
+ *
+ * Payloads are delivered in order of arrival (restored ones when enough
+ * packets of their group are received), duplicates and packets of groups
+ * already given up (late) are dropped.
+ */
+class fec_decoder
+{
+    struct group_state
+    {
+        size_t source_count {0};    // upper bound until repair packet arrives
+        bool count_known {false};
+        size_t received_sources {0};
+        size_t received_repairs {0};
+        size_t symbol_size {0};
+        bool done {false};
+        std::vector<bool> received;
+        std::vector<std::vector<char>> symbols;
+    };
+
+    fec_options _options;
+    std::map<std::uint32_t, group_state> _groups;
+    std::uint32_t _newest {0};
+    bool _has_newest {false};
+    fec_stats _stats;
+
+    // Work buffers of recovery
+    std::vector<std::uint8_t> _matrix;
+    std::vector<std::uint8_t> _inverse;
+    std::vector<std::vector<char>> _syndromes;
+    std::vector<char> _restored;
+
+private:
+    static bool older (std::uint32_t a, std::uint32_t b) noexcept
+    {
+        return static_cast<std::int32_t>(a - b) < 0;
+    }
+
+    void release (group_state & g)
+    {
+        g.done = true;
+        g.symbols.clear();
+        g.symbols.shrink_to_fit();
+    }
+
+    void expire (std::uint32_t group)
+    {
+        if (!_has_newest || older(_newest, group))
+            _newest = group;
+
+        _has_newest = true;
+
+        for (auto pos = _groups.begin(); pos != _groups.end();) {
+            auto age = static_cast<std::uint32_t>(_newest - pos->first);
+
+            if (age >= _options.decoder_window) {
+                auto & g = pos->second;
+
+                if (!g.done) {
+                    // Without repair packets source count is an upper bound
+                    // (group may be closed early), so only gaps before the
+                    // last received source packet are known to be lost
+                    auto known = g.source_count;
+
+                    if (!g.count_known) {
+                        while (known > 0 && !g.received[known - 1])
+                            known--;
+                    }
+
+                    for (size_t j = 0; j < known; j++) {
+                        if (!g.received[j])
+                            _stats.unrecoverable++;
+                    }
+                }
+
+                pos = _groups.erase(pos);
+            } else {
+                ++pos;
+            }
+        }
+    }
+
+    // Inverts e x e matrix in place of _matrix into _inverse
+    bool invert (size_t e)
+    {
+        _inverse.assign(e * e, 0);
+
+        for (size_t i = 0; i < e; i++)
+            _inverse[i * e + i] = 1;
+
+        for (size_t col = 0; col < e; col++) {
+            size_t pivot = col;
+
+            while (pivot < e && _matrix[pivot * e + col] == 0)
+                pivot++;
+
+            if (pivot == e)
+                return false;
+
+            if (pivot != col) {
+                for (size_t k = 0; k < e; k++) {
+                    std::swap(_matrix[pivot * e + k], _matrix[col * e + k]);
+                    std::swap(_inverse[pivot * e + k], _inverse[col * e + k]);
+                }
+            }
+
+            auto scale = gf256_inv(_matrix[col * e + col]);
+
+            for (size_t k = 0; k < e; k++) {
+                _matrix[col * e + k] = gf256_mul(_matrix[col * e + k], scale);
+                _inverse[col * e + k] = gf256_mul(_inverse[col * e + k], scale);
+            }
+
+            for (size_t row = 0; row < e; row++) {
+                auto factor = _matrix[row * e + col];
+
+                if (row == col || factor == 0)
+                    continue;
+
+                for (size_t k = 0; k < e; k++) {
+                    _matrix[row * e + k] ^= gf256_mul(factor, _matrix[col * e + k]);
+                    _inverse[row * e + k] ^= gf256_mul(factor, _inverse[col * e + k]);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename Deliver>
+    void recover (group_state & g, Deliver && deliver)
+    {
+        auto k = g.source_count;
+        std::vector<size_t> missing;
+        std::vector<size_t> repairs;
+
+        for (size_t j = 0; j < k; j++) {
+            if (!g.received[j])
+                missing.push_back(j);
+        }
+
+        for (size_t i = k; i < g.received.size() && repairs.size() < missing.size(); i++) {
+            if (g.received[i])
+                repairs.push_back(i - k);
+        }
+
+        auto e = missing.size();
+        auto size = g.symbol_size;
+
+        // Contribution of received source packets is removed from repair
+        // packets: syndrome = sum over missing j of C(i, j) * symbol j
+        _syndromes.resize(e);
+
+        for (size_t r = 0; r < e; r++) {
+            auto & s = _syndromes[r];
+            auto const & repair = g.symbols[k + repairs[r]];
+            s.assign(repair.begin(), repair.end());
+            s.resize(size, 0);
+
+            for (size_t j = 0; j < k; j++) {
+                if (g.received[j]) {
+                    auto const & symbol = g.symbols[j];
+                    gf256_mul_add_region(details::fec::coefficient(repairs[r], j)
+                        , symbol.data(), & s[0], symbol.size());
+                }
+            }
+        }
+
+        _matrix.resize(e * e);
+
+        for (size_t r = 0; r < e; r++) {
+            for (size_t l = 0; l < e; l++)
+                _matrix[r * e + l] = details::fec::coefficient(repairs[r], missing[l]);
+        }
+
+        // Cauchy submatrix is always invertible
+        if (!invert(e))
+            return;
+
+        _restored.resize(size);
+
+        for (size_t l = 0; l < e; l++) {
+            gf256_mul_region(_inverse[l * e], _syndromes[0].data(), _restored.data(), size);
+
+            for (size_t r = 1; r < e; r++) {
+                gf256_mul_add_region(_inverse[l * e + r], _syndromes[r].data()
+                    , _restored.data(), size);
+            }
+
+            auto n = field_codec<std::uint16_t, endian::big>::decode(_restored.data());
+
+            if (n + size_t{2} > size) {
+                // Corrupted packets
+                _stats.unrecoverable++;
+                continue;
+            }
+
+            g.received[missing[l]] = true;
+            g.received_sources++;
+            _stats.recovered++;
+            deliver(static_cast<char const *>(_restored.data() + 2), static_cast<size_t>(n));
+        }
+    }
+
+public:
+    explicit fec_decoder (fec_options const & options = fec_options{})
+        : _options(options)
+    {}
+
+    fec_stats const & stats () const noexcept
+    {
+        return _stats;
+    }
+
+    /**
+     * Processes received @a packet, calls @a deliver as
+     * deliver(char const * payload, size_t size) for its payload and for
+     * payloads it restores.
+     *
+     * @return @c false with errc::bad_message if packet is malformed.
+     */
+    template <typename Deliver>
+    bool decode (char const * packet, size_t n, Deliver && deliver, error_code & ec)
+    {
+        details::fec::header h;
+
+        if (!details::fec::decode_header(packet, n, h)
+                || n - details::fec::header_size > _options.max_payload + 2) {
+            ec = make_error_code(errc::bad_message);
+            return false;
+        }
+
+        // Too old group
+        if (_has_newest && static_cast<std::uint32_t>(_newest - h.group) >= _options.decoder_window
+                && older(h.group, _newest)) {
+            _stats.late++;
+            return true;
+        }
+
+        auto pos = _groups.find(h.group);
+
+        if (pos == _groups.end()) {
+            expire(h.group);
+            pos = _groups.emplace(h.group, group_state{}).first;
+            auto & g = pos->second;
+            g.source_count = h.source_count;
+            g.received.assign(h.source_count + h.repair_count, false);
+            g.symbols.resize(h.source_count + h.repair_count);
+        }
+
+        auto & g = pos->second;
+        auto payload = packet + details::fec::header_size;
+        auto size = n - details::fec::header_size;
+        bool is_repair = h.index >= h.source_count;
+
+        if (h.index >= g.received.size() || g.received[h.index]) {
+            _stats.duplicates++;
+            return true;
+        }
+
+        if (is_repair) {
+            _stats.repair_packets++;
+
+            if (!g.count_known) {
+                // Group closed early
+                if (h.source_count > g.source_count) {
+                    ec = make_error_code(errc::bad_message);
+                    return false;
+                }
+
+                if (h.source_count < g.source_count) {
+                    std::vector<bool> received(h.source_count + h.repair_count, false);
+                    std::vector<std::vector<char>> symbols(received.size());
+
+                    for (size_t j = 0; j < h.source_count; j++) {
+                        received[j] = g.received[j];
+                        symbols[j].swap(g.symbols[j]);
+                    }
+
+                    g.received.swap(received);
+                    g.symbols.swap(symbols);
+                    g.source_count = h.source_count;
+                }
+
+                g.count_known = true;
+            }
+
+            if (g.done || h.index >= g.received.size())
+                return true;
+
+            g.received[h.index] = true;
+            g.received_repairs++;
+            g.symbols[h.index].assign(payload, payload + size);
+            g.symbol_size = std::max(g.symbol_size, size);
+        } else {
+            _stats.source_packets++;
+            g.received[h.index] = true;
+            g.received_sources++;
+            deliver(payload, size);
+
+            if (!g.done) {
+                auto & symbol = g.symbols[h.index];
+                symbol.resize(size + 2);
+                field_codec<std::uint16_t, endian::big>::encode(static_cast<std::uint16_t>(size), symbol.data());
+                std::memcpy(symbol.data() + 2, payload, size);
+                g.symbol_size = std::max(g.symbol_size, size + 2);
+            }
+        }
+
+        if (g.done)
+            return true;
+
+        if (g.received_sources == g.source_count) {
+            if (g.count_known)
+                release(g);
+        } else if (g.count_known && g.received_sources + g.received_repairs >= g.source_count) {
+            recover(g, deliver);
+            release(g);
+        }
+
+        return true;
+    }
+};
+
+/**
+ * @brief FEC protected datagram channel.
+ *
+ * Every write() sends one source datagram, repair datagrams follow each group
+ * of fec_options::source_count writes (or flush()).
+ *
+ * @tparam Device @c device, @c static_device or any type with datagram
+ *         read() and write() (e.g. udp_socket).
+ */
+template <typename Device = device>
+class basic_fec_channel
+{
+    Device * _d {nullptr};
+    fec_encoder _encoder;
+    fec_decoder _decoder;
+    std::deque<std::string> _ready;
+    std::vector<char> _buf;
+
+private:
+    struct sender
+    {
+        Device * d;
+
+        bool operator () (char const * packet, size_t n, error_code & ec) const
+        {
+            return d->write(packet, n, ec) >= 0;
+        }
+    };
+
+public:
+    basic_fec_channel (Device & d, fec_options const & options = fec_options{})
+        : _d(& d)
+        , _encoder(options)
+        , _decoder(options)
+        , _buf(details::fec::header_size + 2 + options.max_payload)
+    {}
+
+    /**
+     * Sends @a n bytes as one source packet.
+     *
+     * @return @a n or -1 on error (errc::message_size if @a n exceeds
+     *         fec_options::max_payload).
+     */
+    ssize_t write (char const * bytes, size_t n, error_code & ec)
+    {
+        return _encoder.encode(bytes, n, sender{_d}, ec)
+            ? static_cast<ssize_t>(n)
+            : -1;
+    }
+
+    /**
+     * Sends repair packets for incomplete group.
+     */
+    error_code flush ()
+    {
+        error_code ec;
+        _encoder.flush(sender{_d}, ec);
+        return ec;
+    }
+
+    /**
+     * Reads next payload (received or restored). Malformed datagrams are
+     * skipped.
+     *
+     * @return @c false on error or if device has no more data (non-blocking
+     *         device has no datagram pending).
+     */
+    bool read (std::string & payload, error_code & ec)
+    {
+        while (_ready.empty()) {
+            auto n = _d->read(_buf.data(), _buf.size(), ec);
+
+            if (n <= 0)
+                return false;
+
+            error_code decode_ec;
+            _decoder.decode(_buf.data(), static_cast<size_t>(n)
+                , [this] (char const * data, size_t size) {
+                    _ready.emplace_back(data, size);
+                }
+                , decode_ec);
+        }
+
+        payload.swap(_ready.front());
+        _ready.pop_front();
+        return true;
+    }
+
+    fec_stats const & stats () const noexcept
+    {
+        return _decoder.stats();
+    }
+};
+
+using fec_channel = basic_fec_channel<>;
+
+}} // pfs::io
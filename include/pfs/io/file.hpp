@@ -6,10 +6,25 @@
 // Changelog:
 //      2019.09.29 Initial version
 //      2019.10.15 Refactored supporting platform-agnostic implementation
+//      2026.10.18 Added make_static_file()
+//      2026.10.18 Added positional I/O (read_at/write_at) and seek/tell
+//      2026.10.18 Added durability policy and sync()
+//      2026.10.18 Added direct I/O mode
+//      2026.10.18 Added preallocation, hole punching and sparse file support
+//      2026.10.18 Added access advice, readahead and adaptive advice mode
+//      2026.10.18 Added resize()
+//      2026.10.18 Added writev()
+//      2026.10.18 Direct I/O tails go through a separate buffered descriptor
+//      2026.10.18 Adaptive advice detector is guarded by mutex
+//      2026.10.18 read() is classified by actual file position
+//      2026.10.19 File position is tracked instead of queried by read()
+//      2026.10.19 next_data() and next_hole() update tracked file position
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "operationsystem.h"
 #include "device.hpp"
+#include <atomic>
+#include <mutex>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -33,21 +48,187 @@ namespace file {
     using unix_ns::file::opened;
     using unix_ns::file::read;
     using unix_ns::file::write;
+    using unix_ns::file::writev;
     using unix_ns::file::has_pending_data;
+    using unix_ns::file::read_at;
+    using unix_ns::file::write_at;
+    using unix_ns::file::seek;
+    using unix_ns::file::tell;
+    using unix_ns::file::sync;
+    using unix_ns::file::is_direct;
+    using unix_ns::file::reopen_buffered;
+    using unix_ns::file::direct_io_alignment;
+    using unix_ns::file::read_direct;
+    using unix_ns::file::write_direct;
+    using unix_ns::file::size;
+    using unix_ns::file::resize;
+    using unix_ns::file::allocate;
+    using unix_ns::file::punch_hole;
+    using unix_ns::file::zero_range;
+    using unix_ns::file::next_data;
+    using unix_ns::file::next_hole;
+    using unix_ns::file::advise;
+    using unix_ns::file::prefetch;
     using unix_ns::swap;
 #endif
 
 }} // platform::file
 
+/**
+ * @brief Classifies read pattern as sequential or random by observed offsets.
+ *
+ * Uses a saturating score with hysteresis, so a single seek within a
+ * sequential scan (or a single adjacent read within a random workload) does
+ * not flip the classification.
+ */
+class access_pattern_detector
+{
+public:
+    enum { threshold = 4 };
+
+private:
+    offset_type _next_offset {0};
+    int _score {0}; // positive - sequential, negative - random
+    access_advice _advice {access_advice::normal};
+
+public:
+    /**
+     * Registers read of @a n bytes at @a offset.
+     *
+     * @return @c true if classification changed, new advice is stored in
+     *         @a advice.
+     */
+    bool observe (offset_type offset, size_t n, access_advice & advice) noexcept
+    {
+        bool sequential = offset == _next_offset;
+        _next_offset = offset + static_cast<offset_type>(n);
+        return classify(sequential, advice);
+    }
+
+    /**
+     * Registers read which is (or is not) adjacent to the previous one
+     * according to caller's own tracking.
+     *
+     * @return @c true if classification changed, new advice is stored in
+     *         @a advice.
+     */
+    bool classify (bool sequential, access_advice & advice) noexcept
+    {
+        if (sequential)
+            _score = _score < threshold ? _score + 1 : threshold;
+        else
+            _score = _score > -threshold ? _score - 1 : -threshold;
+
+        access_advice detected = _advice;
+
+        if (_score == threshold)
+            detected = access_advice::sequential;
+        else if (_score == -threshold)
+            detected = access_advice::random;
+
+        if (detected == _advice)
+            return false;
+
+        _advice = advice = detected;
+        return true;
+    }
+
+    /**
+     * Expected offset of the next sequential read.
+     */
+    offset_type next_offset () const noexcept
+    {
+        return _next_offset;
+    }
+
+    void set_next_offset (offset_type offset) noexcept
+    {
+        _next_offset = offset;
+    }
+
+    access_advice advice () const noexcept
+    {
+        return _advice;
+    }
+
+    void reset () noexcept
+    {
+        *this = access_pattern_detector{};
+    }
+};
+
 class file : public basic_device
 {
     platform::file::device_handle _h;
+    durability _durability {durability::full_sync};
+
+    // Non-zero if file opened in direct I/O mode
+    size_t _direct_alignment {0};
+
+    // Descriptor without O_DIRECT for unaligned tails in direct I/O mode
+    platform::file::device_handle _buffered;
+
+    std::atomic<bool> _adaptive_advice {false};
+
+    // Guards detector and advice changes: read_at() may be called concurrently
+    mutable std::mutex _detector_mtx;
+    access_pattern_detector _detector; // expects positional reads (read_at())
+    offset_type _read_next {0};        // end of the previous read()
+
+    // File position tracked in adaptive advice mode (advanced by read(),
+    // write(), seek(), next_data() and next_hole()), negative if unknown
+    offset_type _pos {-1};
+
+private:
+    // Positional read
+    void observe_read (offset_type offset, ssize_t n) noexcept
+    {
+        if (n <= 0)
+            return;
+
+        access_advice advice;
+        std::lock_guard<std::mutex> lk(_detector_mtx);
+
+        if (_detector.observe(offset, static_cast<size_t>(n), advice))
+            platform::file::advise(& _h, 0, 0, advice);
+    }
+
+    // read() at file position @a pos, sequential if no seek (or other
+    // position change) happened since the previous read()
+    void observe_stream_read (offset_type pos, ssize_t n) noexcept
+    {
+        if (n <= 0)
+            return;
+
+        access_advice advice;
+        std::lock_guard<std::mutex> lk(_detector_mtx);
+        bool sequential = pos == _read_next;
+        _read_next = pos + static_cast<offset_type>(n);
+
+        if (_detector.classify(sequential, advice))
+            platform::file::advise(& _h, 0, 0, advice);
+    }
+
+    void advance_pos (offset_type pos, ssize_t n) noexcept
+    {
+        _pos = pos >= 0 && n >= 0 ? pos + static_cast<offset_type>(n) : -1;
+    }
 
 protected:
-    file (platform::file::device_handle && h)
+    file (platform::file::device_handle && h
+        , durability policy = durability::full_sync)
+        : _durability(policy)
     {
         using platform::file::swap;
         swap(h, _h);
+
+        if (platform::file::is_direct(& _h)) {
+            error_code ec;
+            _direct_alignment = platform::file::direct_io_alignment(& _h);
+
+            // On failure unaligned tails are rejected (operation_not_supported)
+            _buffered = platform::file::reopen_buffered(& _h, ec);
+        }
     }
 
 public:
@@ -88,9 +269,17 @@ public:
         return platform::file::has_pending_data(& _h);
     }
 
+    /**
+     * Closes file, flushing data according to durability policy
+     * (durability::full_sync by default).
+     */
     virtual error_code close () override
     {
-        return platform::file::close(& _h);
+        // Sync of the direct descriptor flushes data written through the
+        // buffered one too
+        auto ec = platform::file::close(& _h, _durability);
+        platform::file::close(& _buffered, durability::none);
+        return ec;
     }
 
     virtual bool opened () const noexcept override
@@ -98,38 +287,426 @@ public:
         return platform::file::opened(& _h);
     }
 
+    /**
+     * In direct I/O mode unaligned tail of @a n is read through page cache,
+     * all data is read through page cache if @a bytes or current position
+     * is not aligned to direct_io_alignment().
+     */
     virtual ssize_t read (char * bytes, size_t n, error_code & ec) noexcept override
     {
-        return platform::file::read(& _h, bytes, n, ec);
+        bool adaptive = _adaptive_advice.load(std::memory_order_relaxed);
+        offset_type pos = -1;
+
+        // Actual position: seek() or write() in between must not be mistaken
+        // for continuation of the previous read(). The kernel is queried
+        // only if position is unknown (e.g. after error).
+        if (adaptive) {
+            pos = _pos;
+
+            if (pos < 0) {
+                error_code tell_ec;
+                pos = tell(tell_ec);
+            }
+        }
+
+        auto r = _direct_alignment
+            ? platform::file::read_direct(& _h, & _buffered, bytes, n, -1, _direct_alignment, ec)
+            : platform::file::read(& _h, bytes, n, ec);
+
+        if (adaptive) {
+            advance_pos(pos, r);
+            observe_stream_read(pos, r);
+        }
+
+        return r;
     }
 
+    /**
+     * In direct I/O mode unaligned tail of @a n is written through page cache,
+     * all data is written through page cache if @a bytes or current position
+     * is not aligned to direct_io_alignment().
+     */
     virtual ssize_t write (char const * bytes, size_t n, error_code & ec) noexcept override
     {
-        return platform::file::write(& _h, bytes, n, ec);
+        auto r = _direct_alignment
+            ? platform::file::write_direct(& _h, & _buffered, bytes, n, -1, _direct_alignment, ec)
+            : platform::file::write(& _h, bytes, n, ec);
+
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            advance_pos(_pos, r);
+
+        return r;
+    }
+
+    /**
+     * In direct I/O mode buffers are written one by one (see write()).
+     */
+    virtual ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept override
+    {
+        if (_direct_alignment)
+            return basic_device::writev(iov, iovcnt, ec);
+
+        auto r = platform::file::writev(& _h, iov, iovcnt, ec);
+
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            advance_pos(_pos, r);
+
+        return r;
+    }
+
+    /**
+     * @return Alignment required for buffers, offsets and lengths if file is
+     *         opened in direct I/O mode, or zero otherwise.
+     */
+    size_t direct_io_alignment () const noexcept
+    {
+        return _direct_alignment;
+    }
+
+    /**
+     * Reads up to @a n bytes starting at @a offset without changing the file
+     * position. Safe to call concurrently on the same file (also in
+     * adaptive advice mode).
+     *
+     * @return Number of bytes read (zero at end of file) or -1 on error.
+     */
+    ssize_t read_at (char * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) noexcept
+    {
+        auto r = _direct_alignment
+            ? platform::file::read_direct(& _h, & _buffered, bytes, n, offset, _direct_alignment, ec)
+            : platform::file::read_at(& _h, bytes, n, offset, ec);
+
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            observe_read(offset, r);
+
+        return r;
+    }
+
+    /**
+     * Writes up to @a n bytes starting at @a offset without changing the file
+     * position.
+     *
+     * @return Number of bytes written or -1 on error.
+     */
+    ssize_t write_at (char const * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) noexcept
+    {
+        return _direct_alignment
+            ? platform::file::write_direct(& _h, & _buffered, bytes, n, offset, _direct_alignment, ec)
+            : platform::file::write_at(& _h, bytes, n, offset, ec);
+    }
+
+    /**
+     * Vectored form of read_at(). In direct I/O mode all elements must be
+     * aligned, there is no fallback for unaligned tails.
+     */
+    ssize_t read_at (io_vector const * iov
+        , int iovcnt
+        , offset_type offset
+        , error_code & ec) noexcept
+    {
+        return platform::file::read_at(& _h, iov, iovcnt, offset, ec);
+    }
+
+    /**
+     * Vectored form of write_at(). In direct I/O mode all elements must be
+     * aligned, there is no fallback for unaligned tails.
+     */
+    ssize_t write_at (io_vector const * iov
+        , int iovcnt
+        , offset_type offset
+        , error_code & ec) noexcept
+    {
+        return platform::file::write_at(& _h, iov, iovcnt, offset, ec);
+    }
+
+    /**
+     * Sets file position used by read() and write().
+     *
+     * @return Resulting position or -1 on error.
+     */
+    offset_type seek (offset_type offset, seek_origin origin, error_code & ec) noexcept
+    {
+        auto pos = platform::file::seek(& _h, offset, origin, ec);
+
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            _pos = pos;
+
+        return pos;
+    }
+
+    /**
+     * @return Current file position or -1 on error.
+     */
+    offset_type tell (error_code & ec) noexcept
+    {
+        return platform::file::tell(& _h, ec);
+    }
+
+    /**
+     * @return File size or -1 on error.
+     */
+    offset_type size (error_code & ec) const noexcept
+    {
+        return platform::file::size(& _h, ec);
+    }
+
+    /**
+     * Sets file size, extending it with a hole or truncating it.
+     */
+    error_code resize (offset_type size)
+    {
+        return platform::file::resize(& _h, size);
+    }
+
+    /**
+     * Allocates disk space for range [@a offset, @a offset + @a len) up front,
+     * so subsequent writes to the range do not extend the file block by block.
+     *
+     * @param keep_size Do not change file size even if range ends beyond it.
+     */
+    error_code allocate (offset_type offset, offset_type len, bool keep_size = false)
+    {
+        return platform::file::allocate(& _h, offset, len, keep_size);
+    }
+
+    /**
+     * Deallocates disk space for the range. Subsequent reads of the range
+     * return zeros. File size is not changed.
+     */
+    error_code punch_hole (offset_type offset, offset_type len)
+    {
+        return platform::file::punch_hole(& _h, offset, len);
+    }
+
+    /**
+     * Zeroes the range, preferably by converting it to unwritten extents
+     * instead of writing zeros.
+     */
+    error_code zero_range (offset_type offset, offset_type len, bool keep_size = false)
+    {
+        return platform::file::zero_range(& _h, offset, len, keep_size);
+    }
+
+    /**
+     * @return Offset of the first data byte at or after @a offset, or -1 if
+     *         there is no data beyond @a offset or on error (@a ec is set).
+     * @note Changes file position.
+     */
+    offset_type next_data (offset_type offset, error_code & ec) noexcept
+    {
+        auto pos = platform::file::next_data(& _h, offset, ec);
+
+        // No data (ENXIO) or error: position is unknown
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            _pos = pos;
+
+        return pos;
+    }
+
+    /**
+     * @return Offset of the first hole at or after @a offset (end of file
+     *         is a hole), or -1 on error.
+     * @note Changes file position.
+     */
+    offset_type next_hole (offset_type offset, error_code & ec) noexcept
+    {
+        auto pos = platform::file::next_hole(& _h, offset, ec);
+
+        if (_adaptive_advice.load(std::memory_order_relaxed))
+            _pos = pos;
+
+        return pos;
+    }
+
+    /**
+     * Calls @a f (offset_type offset, offset_type length) for each data
+     * region of the (sparse) file. File position is preserved.
+     */
+    template <typename F>
+    error_code for_each_data_extent (F && f)
+    {
+        error_code ec;
+        auto saved_pos = tell(ec);
+
+        if (ec)
+            return ec;
+
+        offset_type offset = 0;
+
+        while (!ec) {
+            auto data = next_data(offset, ec);
+
+            if (data < 0)
+                break;
+
+            auto hole = next_hole(data, ec);
+
+            if (hole < 0)
+                break;
+
+            f(data, hole - data);
+            offset = hole;
+        }
+
+        error_code restore_ec;
+        seek(saved_pos, seek_origin::begin, restore_ec);
+
+        return ec ? ec : restore_ec;
+    }
+
+    /**
+     * Declares expected access pattern for the range. Zero @a len means up to
+     * the end of file.
+     */
+    error_code advise (access_advice advice, offset_type offset = 0, offset_type len = 0)
+    {
+        return platform::file::advise(& _h, offset, len, advice);
+    }
+
+    /**
+     * Starts reading the range into page cache in background.
+     */
+    error_code prefetch (offset_type offset, size_t len)
+    {
+        return platform::file::prefetch(& _h, offset, len);
+    }
+
+    /**
+     * Enables automatic advice mode: read offsets are tracked and file is
+     * advised as sequential or random when the observed pattern changes.
+     * Disabling restores normal advice. Offsets of read_at() calls from
+     * concurrent threads are tracked in order of completion. Must not be
+     * called concurrently with reads.
+     */
+    error_code set_adaptive_advice (bool enable)
+    {
+        std::lock_guard<std::mutex> lk(_detector_mtx);
+
+        if (enable == _adaptive_advice.load())
+            return error_code{};
+
+        _detector.reset();
+
+        if (enable) {
+            error_code ec;
+            auto pos = tell(ec);
+
+            if (ec)
+                return ec;
+
+            _detector.set_next_offset(pos);
+            _read_next = pos;
+            _pos = pos;
+            _adaptive_advice = true;
+            return error_code{};
+        }
+
+        _adaptive_advice = false;
+        return advise(access_advice::normal);
+    }
+
+    bool adaptive_advice () const noexcept
+    {
+        return _adaptive_advice.load();
+    }
+
+    /**
+     * @return Advice currently applied by automatic advice mode.
+     */
+    access_advice current_advice () const noexcept
+    {
+        std::lock_guard<std::mutex> lk(_detector_mtx);
+        return _detector.advice();
+    }
+
+    /**
+     * Explicitly flushes file data regardless of durability policy.
+     */
+    error_code sync (durability policy = durability::full_sync)
+    {
+        return platform::file::sync(& _h, policy);
+    }
+
+    durability durability_policy () const noexcept
+    {
+        return _durability;
+    }
+
+    void set_durability_policy (durability policy) noexcept
+    {
+        _durability = policy;
+    }
+
+    /**
+     * Underlying platform-specific handle.
+     */
+    platform::file::device_handle const & handle () const noexcept
+    {
+        return _h;
+    }
+
+    platform::file::device_handle & handle () noexcept
+    {
+        return _h;
     }
 
     void swap (file & rhs)
     {
         using platform::file::swap;
+        using std::swap;
         swap(_h, rhs._h);
+        swap(_durability, rhs._durability);
+        swap(_direct_alignment, rhs._direct_alignment);
+        swap(_buffered, rhs._buffered);
+        _adaptive_advice = rhs._adaptive_advice.exchange(_adaptive_advice);
+        swap(_detector, rhs._detector);
+        swap(_read_next, rhs._read_next);
+        swap(_pos, rhs._pos);
     }
 
     friend device make_file (std::string const & path
         , open_mode_flags oflags
         , permissions perms
+        , durability policy
+        , error_code & ec);
+
+    friend static_device<file> make_static_file (std::string const & path
+        , open_mode_flags oflags
+        , permissions perms
+        , durability policy
         , error_code & ec);
 };
 
 /**
  * Makes file device.
+ *
+ * @param policy Durability policy applied on close.
  */
 inline device make_file (std::string const & path
     , open_mode_flags oflags
     , permissions perms
+    , durability policy
     , error_code & ec)
 {
     platform::file::device_handle h = platform::file::open(path, oflags, perms, ec);
-    return ec ? device{} : device{new file(std::move(h))};
+    return ec ? device{} : device{new file(std::move(h), policy)};
+}
+
+/**
+ * Makes file device.
+ */
+inline device make_file (std::string const & path
+    , open_mode_flags oflags
+    , permissions perms
+    , error_code & ec)
+{
+    return make_file(path, oflags, perms, durability::full_sync, ec);
 }
 
 /**
@@ -145,6 +722,20 @@ inline device make_file (std::string const & path
             , ec);
 }
 
+/**
+ * Makes file device.
+ */
+inline device make_file (std::string const & path
+        , open_mode_flags oflags
+        , permissions perms
+        , durability policy)
+{
+    error_code ec;
+    auto d = make_file(path, oflags, perms, policy, ec);
+    if (ec) throw exception(ec);
+    return d;
+}
+
 /**
  * Makes file device.
  */
@@ -170,5 +761,56 @@ inline device make_file (std::string const & path
     return d;
 }
 
+/**
+ * Makes statically typed file device.
+ */
+inline static_device<file> make_static_file (std::string const & path
+    , open_mode_flags oflags
+    , permissions perms
+    , durability policy
+    , error_code & ec)
+{
+    platform::file::device_handle h = platform::file::open(path, oflags, perms, ec);
+    return ec
+        ? static_device<file>{}
+        : static_device<file>{file(std::move(h), policy)};
+}
+
+/**
+ * Makes statically typed file device.
+ */
+inline static_device<file> make_static_file (std::string const & path
+    , open_mode_flags oflags
+    , permissions perms
+    , error_code & ec)
+{
+    return make_static_file(path, oflags, perms, durability::full_sync, ec);
+}
+
+/**
+ * Makes statically typed file device.
+ */
+inline static_device<file> make_static_file (std::string const & path
+        , open_mode_flags oflags
+        , error_code & ec)
+{
+    return make_static_file(path
+            , oflags
+            , owner_read | owner_write
+            , ec);
+}
+
+/**
+ * Makes statically typed file device.
+ */
+inline static_device<file> make_static_file (std::string const & path
+        , open_mode_flags oflags)
+{
+    error_code ec;
+    auto d = make_static_file(path, oflags, ec);
+    if (ec) throw exception(ec);
+    return d;
+}
+
 }} // pfs::io
 
@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Added write_frame_parts()
+//      2026.10.19 Errors are reported with pfs::io::errc codes
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "bytes_view.hpp"
+#include "device.hpp"
+#include "varint.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+/**
+ * Frame length prefix format. Fixed-width prefixes are big-endian (network
+ * byte order).
+ */
+enum class frame_prefix
+{
+      fixed8
+    , fixed16
+    , fixed32
+    , fixed64
+    , varint
+};
+
+struct framed_channel_options
+{
+    frame_prefix prefix {frame_prefix::fixed32};
+
+    // Frames with larger payload are rejected on both sides
+    size_t max_frame_size {16 * 1024 * 1024};
+
+    // Initial size of receive buffer, grows to fit the largest frame
+    size_t buffer_size {64 * 1024};
+};
+
+namespace details {
+
+inline size_t frame_prefix_size (frame_prefix prefix) noexcept
+{
+    switch (prefix) {
+        case frame_prefix::fixed8:  return 1;
+        case frame_prefix::fixed16: return 2;
+        case frame_prefix::fixed32: return 4;
+        case frame_prefix::fixed64: return 8;
+        case frame_prefix::varint:  return varint_max_size;
+    }
+
+    return 0;
+}
+
+inline std::uint64_t frame_prefix_limit (frame_prefix prefix) noexcept
+{
+    return prefix == frame_prefix::varint || prefix == frame_prefix::fixed64
+        ? std::numeric_limits<std::uint64_t>::max()
+        : (std::uint64_t{1} << (8 * frame_prefix_size(prefix))) - 1;
+}
+
+/**
+ * @return Number of bytes written to @a out.
+ */
+inline size_t encode_frame_prefix (frame_prefix prefix, std::uint64_t len, char * out) noexcept
+{
+    if (prefix == frame_prefix::varint)
+        return encode_varint(len, out);
+
+    auto n = frame_prefix_size(prefix);
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = static_cast<char>((len >> (8 * (n - 1 - i))) & 0xFF);
+
+    return n;
+}
+
+/**
+ * @return Prefix size, zero if input is incomplete, or -1 if prefix is
+ *         malformed.
+ */
+inline int decode_frame_prefix (frame_prefix prefix
+    , char const * first
+    , char const * last
+    , std::uint64_t & len) noexcept
+{
+    if (prefix == frame_prefix::varint)
+        return decode_varint(first, last, len);
+
+    auto n = frame_prefix_size(prefix);
+
+    if (static_cast<size_t>(last - first) < n)
+        return 0;
+
+    len = 0;
+
+    for (size_t i = 0; i < n; i++)
+        len = (len << 8) | static_cast<std::uint8_t>(first[i]);
+
+    return static_cast<int>(n);
+}
+
+/**
+ * Writes all data from @a iov, continuing after partial writes.
+ *
+ * @return Total number of bytes written or -1 on error. If device accepts
+ *         no data (nonblocking device is not writable),
+ *         errc::operation_would_block is reported: the data may be partially
+ *         written in this case.
+ */
+template <typename Device>
+ssize_t write_all (Device & d, io_vector * iov, size_t iovcnt, error_code & ec)
+{
+    // Conservative IOV_MAX
+    size_t const max_iovcnt = 1024;
+    auto first = iov;
+    auto last = iov + iovcnt;
+    ssize_t total = 0;
+
+    while (first != last) {
+        if (first->iov_len == 0) {
+            ++first;
+            continue;
+        }
+
+        auto count = std::min(static_cast<size_t>(last - first), max_iovcnt);
+        auto n = d.writev(first, static_cast<int>(count), ec);
+
+        if (n < 0)
+            return -1;
+
+        if (n == 0) {
+            ec = make_error_code(errc::operation_would_block);
+            return -1;
+        }
+
+        total += n;
+
+        while (first != last && static_cast<size_t>(n) >= first->iov_len) {
+            n -= first->iov_len;
+            ++first;
+        }
+
+        if (first != last) {
+            first->iov_base = static_cast<char *>(first->iov_base) + n;
+            first->iov_len -= n;
+        }
+    }
+
+    return total;
+}
+
+} // details
+
+/**
+ * @brief Length-prefixed message framing over a stream device.
+ *
+ * Frames are sent with a single vectored write (prefix and payload are not
+ * copied into intermediate buffer). Received frames are views into the
+ * receive buffer that is reused between reads: all complete frames delivered
+ * by one device read are decoded without further system calls.
+ *
+ * Reading and writing use independent state, so one thread may read while
+ * another one writes if the device allows it.
+ *
+ * @tparam Device @c device, @c static_device or any type with read(),
+ *         writev() and is_nonblocking().
+ */
+template <typename Device = device>
+class basic_framed_channel
+{
+    Device * _d {nullptr};
+    frame_prefix _prefix;
+    size_t _max_frame_size;
+
+    // Receive state
+    std::vector<char> _buf;
+    size_t _begin {0};
+    size_t _end {0};
+    size_t _need {0};  // bytes required from _begin to decode the next frame
+    bool _eof {false};
+    error_code _failure; // stream is unusable after malformed frame
+
+    // Send state
+    std::vector<io_vector> _iov;
+    std::vector<char> _prefixes;
+
+private:
+    enum class decode_result { frame, incomplete, error };
+
+    decode_result decode (bytes_view & frame, error_code & ec)
+    {
+        auto first = _buf.data() + _begin;
+        auto last = _buf.data() + _end;
+        std::uint64_t len = 0;
+        auto hlen = details::decode_frame_prefix(_prefix, first, last, len);
+
+        if (hlen < 0) {
+            ec = _failure = make_error_code(errc::bad_message);
+            return decode_result::error;
+        }
+
+        if (hlen == 0) {
+            _need = _prefix == frame_prefix::varint
+                ? static_cast<size_t>(last - first) + 1
+                : details::frame_prefix_size(_prefix);
+            return decode_result::incomplete;
+        }
+
+        if (len > _max_frame_size) {
+            ec = _failure = make_error_code(errc::message_size);
+            return decode_result::error;
+        }
+
+        auto total = static_cast<size_t>(hlen) + static_cast<size_t>(len);
+
+        if (static_cast<size_t>(last - first) < total) {
+            _need = total;
+            return decode_result::incomplete;
+        }
+
+        frame = bytes_view{first + hlen, static_cast<size_t>(len)};
+        _begin += total;
+        _need = 0;
+        return decode_result::frame;
+    }
+
+    // Reads once from device. Returns false if nothing was read.
+    bool fill (error_code & ec)
+    {
+        if (_eof)
+            return false;
+
+        if (_begin == _end)
+            _begin = _end = 0;
+
+        auto required = std::max(_need, size_t{1});
+
+        if (_buf.size() - _begin < required || _end == _buf.size()) {
+            std::memmove(_buf.data(), _buf.data() + _begin, _end - _begin);
+            _end -= _begin;
+            _begin = 0;
+        }
+
+        if (_buf.size() < required)
+            _buf.resize(std::max(required, _buf.size() * 2));
+
+        auto n = _d->read(_buf.data() + _end, _buf.size() - _end, ec);
+
+        if (n < 0)
+            return false;
+
+        if (n == 0) {
+            if (!_d->is_nonblocking()) {
+                _eof = true;
+
+                if (_begin != _end)
+                    ec = make_error_code(errc::bad_message);
+            }
+
+            return false;
+        }
+
+        _end += static_cast<size_t>(n);
+        return true;
+    }
+
+public:
+    basic_framed_channel (Device & d
+        , framed_channel_options const & options = framed_channel_options{})
+        : _d(& d)
+        , _prefix(options.prefix)
+        , _max_frame_size(static_cast<size_t>(std::min<std::uint64_t>(options.max_frame_size
+            , details::frame_prefix_limit(options.prefix))))
+        , _buf(std::max(options.buffer_size, details::frame_prefix_size(options.prefix)))
+    {}
+
+    /**
+     * Sends frames with a single vectored write.
+     *
+     * @return Total payload size or -1 on error. Oversized frames are
+     *         rejected with errc::message_size before anything is sent.
+     */
+    ssize_t write_frames (bytes_view const * frames, size_t count, error_code & ec)
+    {
+        _iov.clear();
+        _prefixes.resize(count * varint_max_size);
+        ssize_t payload = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            if (frames[i].size() > _max_frame_size) {
+                ec = make_error_code(errc::message_size);
+                return -1;
+            }
+
+            auto prefix = _prefixes.data() + i * varint_max_size;
+            auto hlen = details::encode_frame_prefix(_prefix, frames[i].size(), prefix);
+
+            _iov.push_back(io_vector{prefix, hlen});
+
+            if (!frames[i].empty())
+                _iov.push_back(io_vector{const_cast<char *>(frames[i].data()), frames[i].size()});
+
+            payload += static_cast<ssize_t>(frames[i].size());
+        }
+
+        return details::write_all(*_d, _iov.data(), _iov.size(), ec) < 0 ? -1 : payload;
+    }
+
+    /**
+     * Sends single frame assembled from @a parts (e.g. header and body) without
+     * copying them.
+     *
+     * @return Total payload size or -1 on error.
+     */
+    ssize_t write_frame_parts (bytes_view const * parts, size_t count, error_code & ec)
+    {
+        _iov.clear();
+        _prefixes.resize(varint_max_size);
+        size_t payload = 0;
+
+        for (size_t i = 0; i < count; i++)
+            payload += parts[i].size();
+
+        if (payload > _max_frame_size) {
+            ec = make_error_code(errc::message_size);
+            return -1;
+        }
+
+        auto hlen = details::encode_frame_prefix(_prefix, payload, _prefixes.data());
+        _iov.push_back(io_vector{_prefixes.data(), hlen});
+
+        for (size_t i = 0; i < count; i++) {
+            if (!parts[i].empty())
+                _iov.push_back(io_vector{const_cast<char *>(parts[i].data()), parts[i].size()});
+        }
+
+        return details::write_all(*_d, _iov.data(), _iov.size(), ec) < 0
+            ? -1 : static_cast<ssize_t>(payload);
+    }
+
+    ssize_t write_frame (char const * data, size_t n, error_code & ec)
+    {
+        bytes_view frame {data, n};
+        return write_frames(& frame, 1, ec);
+    }
+
+    ssize_t write_frame (char const * data, size_t n)
+    {
+        error_code ec;
+        auto r = write_frame(data, n, ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Returns next frame, reading from device only if buffer has no complete
+     * frame. Frame view is valid until the next read call.
+     *
+     * @return @c false at the end of stream, on error (@a ec is set) or if
+     *         nonblocking device has no complete frame for now.
+     */
+    bool read_frame (bytes_view & frame, error_code & ec)
+    {
+        if (_failure) {
+            ec = _failure;
+            return false;
+        }
+
+        for (;;) {
+            switch (decode(frame, ec)) {
+                case decode_result::frame: return true;
+                case decode_result::error: return false;
+                default: break;
+            }
+
+            if (!fill(ec))
+                return false;
+        }
+    }
+
+    bool read_frame (bytes_view & frame)
+    {
+        error_code ec;
+        auto r = read_frame(frame, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Appends all complete frames available after (at most) one successful
+     * device read to @a frames. Reads again only while no complete frame is
+     * available. Frame views are valid until the next read call.
+     *
+     * @return Number of frames appended.
+     */
+    size_t read_frames (std::vector<bytes_view> & frames, error_code & ec)
+    {
+        if (_failure) {
+            ec = _failure;
+            return 0;
+        }
+
+        size_t count = 0;
+        bytes_view frame;
+
+        for (;;) {
+            auto r = decode(frame, ec);
+
+            if (r == decode_result::frame) {
+                frames.push_back(frame);
+                count++;
+                continue;
+            }
+
+            if (r == decode_result::error || count > 0 || !fill(ec))
+                return count;
+        }
+    }
+
+    /**
+     * @return @c true if device reached end of stream and all frames are
+     *         consumed.
+     */
+    bool at_end () const noexcept
+    {
+        return _eof && _begin == _end;
+    }
+};
+
+using framed_channel = basic_framed_channel<device>;
+
+}} // pfs::io
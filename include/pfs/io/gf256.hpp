@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//
+// References:
+//      1. [Screaming Fast Galois Field Arithmetic Using Intel SIMD Instructions](https://www.usenix.org/conference/fast13/technical-sessions/presentation/plank_james)
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//
+// GF(2^8) arithmetic (polynomial x^8 + x^4 + x^3 + x^2 + 1) and region
+// kernels for erasure codes. SIMD kernels multiply 16 or 32 bytes at once by
+// looking up products of low and high nibbles with pshufb.
+//
+
+namespace pfs {
+namespace io {
+
+namespace details {
+
+struct gf256_tables
+{
+    std::uint8_t exp[512];
+    std::uint8_t log[256];
+    std::uint8_t mul[256][256];
+
+    // Products of constant and low (high) nibble
+    std::uint8_t mul_lo[256][16];
+    std::uint8_t mul_hi[256][16];
+
+    gf256_tables ()
+    {
+        unsigned x = 1;
+
+        for (int i = 0; i < 255; i++) {
+            exp[i] = exp[i + 255] = static_cast<std::uint8_t>(x);
+            log[x] = static_cast<std::uint8_t>(i);
+            x <<= 1;
+
+            if (x & 0x100)
+                x ^= 0x11D;
+        }
+
+        exp[510] = exp[511] = 0;
+        log[0] = 0;
+
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b++) {
+                mul[a][b] = a == 0 || b == 0
+                    ? 0
+                    : exp[log[a] + log[b]];
+            }
+
+            for (int i = 0; i < 16; i++) {
+                mul_lo[a][i] = mul[a][i];
+                mul_hi[a][i] = mul[a][i << 4];
+            }
+        }
+    }
+};
+
+inline gf256_tables const & get_gf256_tables ()
+{
+    static gf256_tables instance;
+    return instance;
+}
+
+// dst ^= src
+using gf256_xor_func = void (*) (char const * src, char * dst, size_t n);
+
+// dst = c * src (mul) or dst ^= c * src (mul_add)
+using gf256_region_func = void (*) (std::uint8_t c, char const * src, char * dst, size_t n);
+
+inline void gf256_xor_scalar (char const * src, char * dst, size_t n)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t a, b;
+        std::memcpy(& a, src + i, 8);
+        std::memcpy(& b, dst + i, 8);
+        b ^= a;
+        std::memcpy(dst + i, & b, 8);
+    }
+
+    for (; i < n; i++)
+        dst[i] ^= src[i];
+}
+
+inline void gf256_mul_scalar (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto row = get_gf256_tables().mul[c];
+
+    for (size_t i = 0; i < n; i++)
+        dst[i] = static_cast<char>(row[static_cast<std::uint8_t>(src[i])]);
+}
+
+inline void gf256_mul_add_scalar (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto row = get_gf256_tables().mul[c];
+
+    for (size_t i = 0; i < n; i++)
+        dst[i] ^= static_cast<char>(row[static_cast<std::uint8_t>(src[i])]);
+}
+
+#if defined(PFS_IO_X86_SIMD)
+
+PFS_IO_TARGET("ssse3")
+inline void gf256_xor_ssse3 (char const * src, char * dst, size_t n)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        auto a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        auto b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_xor_si128(a, b));
+    }
+
+    gf256_xor_scalar(src + i, dst + i, n - i);
+}
+
+PFS_IO_TARGET("ssse3")
+inline __m128i gf256_mul_ssse3 (__m128i lo, __m128i hi, __m128i mask, __m128i v)
+{
+    auto l = _mm_shuffle_epi8(lo, _mm_and_si128(v, mask));
+    auto h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(v, 4), mask));
+    return _mm_xor_si128(l, h);
+}
+
+PFS_IO_TARGET("ssse3")
+inline void gf256_mul_ssse3 (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto const & t = get_gf256_tables();
+    auto lo = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_lo[c]));
+    auto hi = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_hi[c]));
+    auto mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), gf256_mul_ssse3(lo, hi, mask, v));
+    }
+
+    gf256_mul_scalar(c, src + i, dst + i, n - i);
+}
+
+PFS_IO_TARGET("ssse3")
+inline void gf256_mul_add_ssse3 (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto const & t = get_gf256_tables();
+    auto lo = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_lo[c]));
+    auto hi = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_hi[c]));
+    auto mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        auto d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i)
+            , _mm_xor_si128(d, gf256_mul_ssse3(lo, hi, mask, v)));
+    }
+
+    gf256_mul_add_scalar(c, src + i, dst + i, n - i);
+}
+
+PFS_IO_TARGET("avx2")
+inline void gf256_xor_avx2 (char const * src, char * dst, size_t n)
+{
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        auto a = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        auto b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(a, b));
+    }
+
+    gf256_xor_scalar(src + i, dst + i, n - i);
+}
+
+PFS_IO_TARGET("avx2")
+inline __m256i gf256_mul_avx2 (__m256i lo, __m256i hi, __m256i mask, __m256i v)
+{
+    auto l = _mm256_shuffle_epi8(lo, _mm256_and_si256(v, mask));
+    auto h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(v, 4), mask));
+    return _mm256_xor_si256(l, h);
+}
+
+PFS_IO_TARGET("avx2")
+inline void gf256_mul_avx2 (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto const & t = get_gf256_tables();
+    auto lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_lo[c])));
+    auto hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_hi[c])));
+    auto mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), gf256_mul_avx2(lo, hi, mask, v));
+    }
+
+    gf256_mul_scalar(c, src + i, dst + i, n - i);
+}
+
+PFS_IO_TARGET("avx2")
+inline void gf256_mul_add_avx2 (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto const & t = get_gf256_tables();
+    auto lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_lo[c])));
+    auto hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(t.mul_hi[c])));
+    auto mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        auto d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i)
+            , _mm256_xor_si256(d, gf256_mul_avx2(lo, hi, mask, v)));
+    }
+
+    gf256_mul_add_scalar(c, src + i, dst + i, n - i);
+}
+
+#endif // PFS_IO_X86_SIMD
+
+struct gf256_kernels
+{
+    gf256_xor_func xor_region;
+    gf256_region_func mul_region;
+    gf256_region_func mul_add_region;
+};
+
+/**
+ * Selects the best kernels not exceeding @a isa and supported by the CPU.
+ */
+inline gf256_kernels select_gf256_kernels (simd_isa isa)
+{
+#if defined(PFS_IO_X86_SIMD)
+    if (isa >= simd_isa::avx2 && simd_isa_supported(simd_isa::avx2))
+        return gf256_kernels{gf256_xor_avx2, gf256_mul_avx2, gf256_mul_add_avx2};
+
+    if (isa >= simd_isa::ssse3 && simd_isa_supported(simd_isa::ssse3))
+        return gf256_kernels{gf256_xor_ssse3, gf256_mul_ssse3, gf256_mul_add_ssse3};
+#else
+    (void)isa;
+#endif
+
+    return gf256_kernels{gf256_xor_scalar, gf256_mul_scalar, gf256_mul_add_scalar};
+}
+
+inline gf256_kernels const & best_gf256_kernels ()
+{
+    static gf256_kernels const k = select_gf256_kernels(best_simd_isa());
+    return k;
+}
+
+} // details
+
+inline std::uint8_t gf256_mul (std::uint8_t a, std::uint8_t b)
+{
+    return details::get_gf256_tables().mul[a][b];
+}
+
+/**
+ * Multiplicative inverse, @a a must not be zero.
+ */
+inline std::uint8_t gf256_inv (std::uint8_t a)
+{
+    auto const & t = details::get_gf256_tables();
+    return t.exp[255 - t.log[a]];
+}
+
+inline std::uint8_t gf256_div (std::uint8_t a, std::uint8_t b)
+{
+    return gf256_mul(a, gf256_inv(b));
+}
+
+/**
+ * Computes @a dst ^= @a c * @a src for @a n bytes.
+ */
+inline void gf256_mul_add_region (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    auto const & k = details::best_gf256_kernels();
+
+    if (c == 1)
+        k.xor_region(src, dst, n);
+    else if (c != 0)
+        k.mul_add_region(c, src, dst, n);
+}
+
+/**
+ * Computes @a dst = @a c * @a src for @a n bytes.
+ */
+inline void gf256_mul_region (std::uint8_t c, char const * src, char * dst, size_t n)
+{
+    if (c == 1)
+        std::memmove(dst, src, n);
+    else if (c == 0)
+        std::memset(dst, 0, n);
+    else
+        details::best_gf256_kernels().mul_region(c, src, dst, n);
+}
+
+}} // pfs::io
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Parameterized by file type
+//      2026.10.19 Result of the covering flush is returned to each writer
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+/**
+ * @brief Batches sync requests from many writers of the same file.
+ *
+ * Each writer calls sync() after its write completes. Only one flush runs at
+ * a time; writers arriving while it is in progress wait and are all covered
+ * by a single subsequent flush, so N concurrent writers cost about two
+ * flushes instead of N.
+ *
+ * @tparam File @c file or any type with sync(durability).
+ */
+template <typename File = file>
+class basic_group_commit
+{
+    File * _f {nullptr};
+    durability _policy {durability::data_sync};
+
+    // Failed flush covering tickets [first, last], kept until all writers
+    // covered by it have taken the result
+    struct failed_flush
+    {
+        std::uint64_t first;
+        std::uint64_t last;
+        std::uint64_t pending;
+        error_code ec;
+    };
+
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::uint64_t _requested {0}; // last issued ticket
+    std::uint64_t _completed {0}; // all tickets up to this one are flushed
+    std::uint64_t _sync_count {0};
+    bool _in_progress {false};
+    std::vector<failed_flush> _failures;
+
+    // Must be called with locked mutex
+    error_code take_result (std::uint64_t ticket)
+    {
+        for (auto pos = _failures.begin(); pos != _failures.end(); ++pos) {
+            if (ticket >= pos->first && ticket <= pos->last) {
+                auto ec = pos->ec;
+
+                if (--pos->pending == 0)
+                    _failures.erase(pos);
+
+                return ec;
+            }
+        }
+
+        return error_code{};
+    }
+
+public:
+    basic_group_commit (File & f, durability policy = durability::data_sync)
+        : _f(& f)
+        , _policy(policy)
+    {}
+
+    basic_group_commit (basic_group_commit const &) = delete;
+    basic_group_commit & operator = (basic_group_commit const &) = delete;
+
+    /**
+     * Returns when all data written to the file before this call is flushed.
+     *
+     * @return Result of the flush that covered this call.
+     */
+    error_code sync ()
+    {
+        std::unique_lock<std::mutex> lk(_mtx);
+        auto ticket = ++_requested;
+
+        while (_completed < ticket) {
+            if (_in_progress) {
+                _cv.wait(lk);
+                continue;
+            }
+
+            // Become a leader: flush on behalf of all writers arrived so far
+            _in_progress = true;
+            auto target = _requested;
+
+            lk.unlock();
+            auto ec = _f->sync(_policy);
+            lk.lock();
+
+            if (ec)
+                _failures.push_back(failed_flush{_completed + 1, target
+                    , target - _completed, ec});
+
+            _in_progress = false;
+            _completed = target;
+            ++_sync_count;
+            _cv.notify_all();
+        }
+
+        return take_result(ticket);
+    }
+
+    /**
+     * @return Number of flushes actually performed.
+     */
+    std::uint64_t sync_count ()
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _sync_count;
+    }
+};
+
+using group_commit = basic_group_commit<>;
+
+}} // pfs::io
@@ -6,6 +6,9 @@
 // Changelog:
 //      2019.09.29 Initial version
 //      2019.10.16 Refactored supporting platform-agnostic implementation
+//      2026.10.18 Added make_static_local_socket()
+//      2026.10.18 Added writev()
+//      2026.10.18 Added shutdown()
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "operationsystem.h"
@@ -31,6 +34,8 @@ namespace local {
     using unix_ns::local::close;
     using unix_ns::local::read;
     using unix_ns::local::write;
+    using unix_ns::local::writev;
+    using unix_ns::local::shutdown;
     using unix_ns::local::has_pending_data;
     using unix_ns::swap;
 #endif
@@ -90,6 +95,15 @@ public:
         return platform::local::close(& _h, true);
     }
 
+    /**
+     * Shuts down connection keeping socket open, threads blocked in read()
+     * return end of stream.
+     */
+    error_code shutdown ()
+    {
+        return platform::local::shutdown(& _h);
+    }
+
     virtual bool opened () const noexcept override
     {
         return platform::local::opened(& _h);
@@ -110,6 +124,11 @@ public:
         return platform::local::write(& _h, bytes, n, ec);
     }
 
+    virtual ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept override
+    {
+        return platform::local::writev(& _h, iov, iovcnt, ec);
+    }
+
     void swap (local_socket & rhs)
     {
         using platform::local::swap;
@@ -119,6 +138,11 @@ public:
     friend device make_local_socket (std::string const & name
             , bool nonblocking
             , error_code & ec);
+
+    friend static_device<local_socket> make_static_local_socket (
+              std::string const & name
+            , bool nonblocking
+            , error_code & ec);
 };
 
 /**
@@ -143,6 +167,33 @@ inline device make_local_socket (std::string const & name, bool nonblocking)
     return d;
 }
 
+/**
+ * Makes statically typed local socket.
+ */
+inline static_device<local_socket> make_static_local_socket (
+          std::string const & name
+        , bool nonblocking
+        , error_code & ec)
+{
+    local_socket::device_handle h = platform::local::open(name, nonblocking, ec);
+    return ec
+            ? static_device<local_socket>{}
+            : static_device<local_socket>{local_socket(std::move(h))};
+}
+
+/**
+ * Makes statically typed local socket.
+ */
+inline static_device<local_socket> make_static_local_socket (
+          std::string const & name
+        , bool nonblocking)
+{
+    error_code ec;
+    auto d = make_static_local_socket(name, nonblocking, ec);
+    if (ec) throw exception(ec);
+    return d;
+}
+
 }} // pfs::io
 
 
@@ -0,0 +1,402 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "bytes_view.hpp"
+#include "device.hpp"
+#include "framed_channel.hpp"
+#include "local_socket.hpp"
+#include "tcp_socket.hpp"
+#include "varint.hpp"
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//
+// Request/response multiplexing over a single stream connection. Every
+// message is a frame of framed_channel with payload:
+//
+//      [varint correlation id][body]
+//
+// Responses carry the id of the request they answer and may arrive in any
+// order.
+//
+
+namespace pfs {
+namespace io {
+
+namespace details {
+
+/**
+ * Wakes up thread blocked in read() on the connection.
+ */
+inline void shutdown_device (device & d)
+{
+    if (auto s = underlying_device<tcp_socket>(d))
+        s->shutdown();
+    else if (auto s = underlying_device<local_socket>(d))
+        s->shutdown();
+    else
+        d.close();
+}
+
+template <typename Impl>
+inline void shutdown_device (static_device<Impl> & d)
+{
+    d.underlying().shutdown();
+}
+
+} // details
+
+/**
+ * @brief Client side of multiplexed connection.
+ *
+ * Any number of threads may issue requests concurrently without waiting for
+ * responses. Dedicated reader thread dispatches responses to callbacks by
+ * correlation id. When the connection fails or is closed, all outstanding
+ * requests complete with error.
+ *
+ * @tparam Device Blocking @c tcp_socket or @c local_socket (as @c device or
+ *         @c static_device).
+ */
+template <typename Device = device>
+class basic_multiplexed_client
+{
+public:
+    /**
+     * Response handler, called from the reader thread. @a response is valid
+     * during the call only.
+     */
+    using callback_type = std::function<void (error_code const & ec, bytes_view response)>;
+
+private:
+    Device _d;
+    basic_framed_channel<Device> _channel;
+
+    std::mutex _write_mtx;
+    std::mutex _mtx; // protects members below
+    std::unordered_map<std::uint64_t, callback_type> _pending;
+    std::uint64_t _next_id {0};
+    error_code _failure;
+    bool _closed {false};
+
+    std::thread _reader;
+
+private:
+    // Connection is unusable: outstanding requests complete with the first
+    // failure recorded
+    void fail (error_code const & ec)
+    {
+        std::unordered_map<std::uint64_t, callback_type> pending;
+
+        {
+            std::unique_lock<std::mutex> locker(_mtx);
+
+            if (!_failure)
+                _failure = ec;
+
+            pending.swap(_pending);
+        }
+
+        for (auto & item: pending)
+            item.second(_failure, bytes_view{});
+    }
+
+    bool dispatch (bytes_view const & frame)
+    {
+        std::uint64_t id = 0;
+        auto n = decode_varint(frame.data(), frame.data() + frame.size(), id);
+
+        if (n <= 0)
+            return false;
+
+        callback_type callback;
+
+        {
+            std::unique_lock<std::mutex> locker(_mtx);
+            auto pos = _pending.find(id);
+
+            // Request was abandoned after failed write
+            if (pos == _pending.end())
+                return true;
+
+            callback = std::move(pos->second);
+            _pending.erase(pos);
+        }
+
+        callback(error_code{}, frame.substr(static_cast<size_t>(n)));
+        return true;
+    }
+
+    void run ()
+    {
+        std::vector<bytes_view> frames;
+        error_code ec;
+
+        for (;;) {
+            frames.clear();
+            _channel.read_frames(frames, ec);
+
+            for (auto const & frame: frames) {
+                if (!dispatch(frame)) {
+                    ec = make_error_code(errc::bad_message);
+                    break;
+                }
+            }
+
+            if (ec || frames.empty())
+                break;
+        }
+
+        fail(ec ? ec : make_error_code(errc::connection_aborted));
+    }
+
+public:
+    basic_multiplexed_client (Device && d
+        , framed_channel_options const & options = framed_channel_options{})
+        : _d(std::move(d))
+        , _channel(_d, options)
+    {
+        _reader = std::thread{& basic_multiplexed_client::run, this};
+    }
+
+    basic_multiplexed_client (basic_multiplexed_client const &) = delete;
+    basic_multiplexed_client & operator = (basic_multiplexed_client const &) = delete;
+
+    ~basic_multiplexed_client ()
+    {
+        close();
+    }
+
+    /**
+     * Sends request, @a callback is called once the response arrives or the
+     * connection fails.
+     *
+     * @return @c false if request was not sent (@a ec is set), @a callback is
+     *         never called in this case.
+     */
+    bool request (char const * data, size_t n, callback_type callback, error_code & ec)
+    {
+        std::uint64_t id = 0;
+
+        {
+            std::unique_lock<std::mutex> locker(_mtx);
+
+            if (_failure) {
+                ec = _failure;
+                return false;
+            }
+
+            id = _next_id++;
+            _pending.emplace(id, std::move(callback));
+        }
+
+        char header[varint_max_size];
+        bytes_view parts[] = {
+              bytes_view{header, encode_varint(id, header)}
+            , bytes_view{data, n}
+        };
+
+        ssize_t rc = 0;
+
+        {
+            std::unique_lock<std::mutex> locker(_write_mtx);
+            rc = _channel.write_frame_parts(parts, 2, ec);
+        }
+
+        if (rc >= 0)
+            return true;
+
+        bool abandoned = false;
+
+        {
+            std::unique_lock<std::mutex> locker(_mtx);
+            abandoned = _pending.erase(id) > 0;
+        }
+
+        // Oversized request leaves the stream intact
+        if (ec != make_error_code(errc::message_size)) {
+            {
+                std::unique_lock<std::mutex> locker(_mtx);
+
+                if (!_failure)
+                    _failure = ec;
+            }
+
+            details::shutdown_device(_d);
+        }
+
+        // Otherwise the reader has already completed the callback
+        return !abandoned;
+    }
+
+    /**
+     * Sends request.
+     *
+     * @return Future for the response body, holds @c exception on failure.
+     */
+    std::future<std::string> request (char const * data, size_t n)
+    {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto result = promise->get_future();
+        error_code ec;
+
+        auto sent = request(data, n, [promise] (error_code const & ec, bytes_view response) {
+            if (ec)
+                promise->set_exception(std::make_exception_ptr(exception(ec)));
+            else
+                promise->set_value(response.to_string());
+        }, ec);
+
+        if (!sent)
+            promise->set_exception(std::make_exception_ptr(exception(ec)));
+
+        return result;
+    }
+
+    /**
+     * @return Number of requests waiting for response.
+     */
+    size_t pending_count ()
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        return _pending.size();
+    }
+
+    /**
+     * Closes connection, outstanding requests complete with
+     * errc::operation_canceled.
+     */
+    error_code close ()
+    {
+        {
+            std::unique_lock<std::mutex> locker(_mtx);
+
+            if (_closed)
+                return error_code{};
+
+            _closed = true;
+
+            if (!_failure)
+                _failure = make_error_code(errc::operation_canceled);
+        }
+
+        details::shutdown_device(_d);
+
+        if (_reader.joinable())
+            _reader.join();
+
+        return _d.close();
+    }
+};
+
+/**
+ * @brief Serving side of multiplexed connection.
+ *
+ * Requests are read by one thread; responses may be sent in any order and
+ * from any thread.
+ */
+template <typename Device = device>
+class basic_multiplexed_server
+{
+    Device _d;
+    basic_framed_channel<Device> _channel;
+    std::mutex _write_mtx;
+
+public:
+    basic_multiplexed_server (Device && d
+        , framed_channel_options const & options = framed_channel_options{})
+        : _d(std::move(d))
+        , _channel(_d, options)
+    {}
+
+    basic_multiplexed_server (basic_multiplexed_server const &) = delete;
+    basic_multiplexed_server & operator = (basic_multiplexed_server const &) = delete;
+
+    /**
+     * Reads next request. Request view is valid until the next call.
+     *
+     * @return @c false at the end of stream or on error (@a ec is set).
+     */
+    bool read_request (std::uint64_t & id, bytes_view & request, error_code & ec)
+    {
+        bytes_view frame;
+
+        if (!_channel.read_frame(frame, ec))
+            return false;
+
+        std::uint64_t value = 0;
+        auto n = decode_varint(frame.data(), frame.data() + frame.size(), value);
+
+        if (n <= 0) {
+            ec = make_error_code(errc::bad_message);
+            return false;
+        }
+
+        id = value;
+        request = frame.substr(static_cast<size_t>(n));
+        return true;
+    }
+
+    bool read_request (std::uint64_t & id, bytes_view & request)
+    {
+        error_code ec;
+        auto r = read_request(id, request, ec);
+        if (ec) throw exception(ec);
+        return r;
+    }
+
+    /**
+     * Sends response to request @a id.
+     *
+     * @return Response size or -1 on error.
+     */
+    ssize_t respond (std::uint64_t id, char const * data, size_t n, error_code & ec)
+    {
+        char header[varint_max_size];
+        bytes_view parts[] = {
+              bytes_view{header, encode_varint(id, header)}
+            , bytes_view{data, n}
+        };
+
+        std::unique_lock<std::mutex> locker(_write_mtx);
+        auto rc = _channel.write_frame_parts(parts, 2, ec);
+        return rc < 0 ? -1 : static_cast<ssize_t>(n);
+    }
+
+    ssize_t respond (std::uint64_t id, char const * data, size_t n)
+    {
+        error_code ec;
+        auto r = respond(id, data, n, ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+
+    bool at_end () const noexcept
+    {
+        return _channel.at_end();
+    }
+
+    error_code close ()
+    {
+        return _d.close();
+    }
+};
+
+using multiplexed_client = basic_multiplexed_client<device>;
+using multiplexed_server = basic_multiplexed_server<device>;
+
+}} // pfs::io
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2020.02.12 Initial version
+//      2026.10.18 Added broadcast address discovery
 //
 // References:
 //      1. man netdevice
@@ -14,6 +15,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <string>
+#include <vector>
 
 #if defined(__linux) || defined(__linux__)
 #   define PFS_IO_NETDEVICE_IMPL_LINUX 1
@@ -21,6 +23,8 @@
 #   include <unistd.h>
 #   include <sys/ioctl.h>
 #   include <net/if.h>
+#   include <arpa/inet.h>
+#   include <ifaddrs.h>
 #   include <cstring>
 #endif
 
@@ -45,6 +49,12 @@ public:
      */
     int mtu () const;
 
+    /**
+     * Return IPv4 broadcast address of net device (e.g. "192.168.1.255"),
+     * or empty string if device has no broadcast capable address.
+     */
+    std::string broadcast_address () const;
+
 public:
 #if PFS_IO_NETDEVICE_IMPL_LINUX
     int mtu_alternative0 () const;
@@ -56,6 +66,18 @@ public:
 #endif // PFS_IO_NETDEVICE_IMPL_LINUX
 };
 
+struct broadcast_target
+{
+    std::string interface; // net device name
+    std::string address;   // broadcast address of the subnet
+};
+
+/**
+ * Return broadcast addresses of all IPv4 subnets of net devices which are up
+ * and broadcast capable (one entry per subnet).
+ */
+std::vector<broadcast_target> broadcast_addresses ();
+
 inline netdevice::netdevice (std::string const & name)
     : _name(name)
 {
@@ -113,6 +135,65 @@ inline int netdevice::mtu_alternative1 () const
 }
 #endif // PFS_IO_NETDEVICE_IMPL_LINUX
 
+#if PFS_IO_NETDEVICE_IMPL_LINUX
+namespace details {
+
+// Broadcast address is computed from address and netmask
+inline std::string ipv4_broadcast_address (sockaddr const * addr, sockaddr const * netmask)
+{
+    auto a = reinterpret_cast<sockaddr_in const *>(addr)->sin_addr.s_addr;
+    auto m = reinterpret_cast<sockaddr_in const *>(netmask)->sin_addr.s_addr;
+    in_addr broadcast;
+    broadcast.s_addr = a | ~m;
+
+    char buf[INET_ADDRSTRLEN];
+    return inet_ntop(AF_INET, & broadcast, buf, sizeof(buf)) ? std::string{buf} : std::string{};
+}
+
+} // details
+#endif // PFS_IO_NETDEVICE_IMPL_LINUX
+
+inline std::vector<broadcast_target> broadcast_addresses ()
+{
+    std::vector<broadcast_target> result;
+
+#if PFS_IO_NETDEVICE_IMPL_LINUX
+    ifaddrs * list = nullptr;
+
+    if (::getifaddrs(& list) != 0)
+        return result;
+
+    for (auto p = list; p; p = p->ifa_next) {
+        if (!p->ifa_addr || !p->ifa_netmask || p->ifa_addr->sa_family != AF_INET)
+            continue;
+
+        if (!(p->ifa_flags & IFF_UP) || !(p->ifa_flags & IFF_BROADCAST)
+                || (p->ifa_flags & IFF_LOOPBACK)) {
+            continue;
+        }
+
+        auto address = details::ipv4_broadcast_address(p->ifa_addr, p->ifa_netmask);
+
+        if (!address.empty())
+            result.push_back(broadcast_target{p->ifa_name, address});
+    }
+
+    ::freeifaddrs(list);
+#endif // PFS_IO_NETDEVICE_IMPL_LINUX
+
+    return result;
+}
+
+inline std::string netdevice::broadcast_address () const
+{
+    for (auto const & target: broadcast_addresses()) {
+        if (target.interface == _name)
+            return target.address;
+    }
+
+    return std::string{};
+}
+
 inline int netdevice::mtu () const
 {
     int result = -1;
@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Kernel modes are reachable through device and static_device,
+//                 unsent bytes of partial writes are returned to the bucket
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "device.hpp"
+#include "tcp_server.hpp"
+#include "tcp_socket.hpp"
+#include "udp_socket.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace pfs {
+namespace io {
+
+/**
+ * @brief Token bucket rate limiter.
+ *
+ * Implemented as generic cell rate algorithm: the bucket keeps the time when
+ * all reserved bytes are sent at @c rate, data conforms while that time is
+ * ahead of now by no more than the burst (bytes that may be sent back to
+ * back). Reservations are not changed by late wakeups, so the average rate
+ * is exact whatever the timer precision is.
+ */
+class token_bucket
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+private:
+    std::uint64_t _rate {0};
+    std::size_t _burst {0};
+    clock_type::duration _tolerance {0};
+    time_point _schedule;          // end of reserved transmission time
+    std::uint64_t _remainder {0};  // fraction of nanosecond carried to next reservation
+
+public:
+    /**
+     * @param rate Bytes per second, zero means unlimited.
+     * @param burst Bytes that may be sent ahead of the rate.
+     */
+    token_bucket (std::uint64_t rate = 0, std::size_t burst = 0)
+    {
+        set_rate(rate, burst);
+    }
+
+    std::uint64_t rate () const noexcept
+    {
+        return _rate;
+    }
+
+    std::size_t burst () const noexcept
+    {
+        return _burst;
+    }
+
+    /**
+     * Time the schedule may run ahead of now (burst at rate).
+     */
+    clock_type::duration tolerance () const noexcept
+    {
+        return _tolerance;
+    }
+
+    void set_rate (std::uint64_t rate, std::size_t burst)
+    {
+        _rate = rate;
+        _burst = burst;
+        _tolerance = rate == 0
+            ? clock_type::duration{0}
+            : std::chrono::duration_cast<clock_type::duration>(std::chrono::nanoseconds{
+                static_cast<std::int64_t>(burst * 1000000000ull / rate)});
+    }
+
+    /**
+     * Reserves transmission time for @a n bytes.
+     *
+     * @return Start of the reserved time: @a n bytes conform at
+     *         start - tolerance().
+     */
+    time_point reserve (std::size_t n, time_point now) noexcept
+    {
+        if (_rate == 0)
+            return now;
+
+        // Unused time of idle bucket is lost
+        if (_schedule < now) {
+            _schedule = now;
+            _remainder = 0;
+        }
+
+        auto start = _schedule;
+        auto numerator = static_cast<std::uint64_t>(n) * 1000000000ull + _remainder;
+        _remainder = numerator % _rate;
+        _schedule += std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::nanoseconds{static_cast<std::int64_t>(numerator / _rate)});
+        return start;
+    }
+
+    /**
+     * Returns reservation of @a n bytes that were not sent (e.g. rest of
+     * a partial write).
+     */
+    void release (std::size_t n) noexcept
+    {
+        if (_rate == 0 || n == 0)
+            return;
+
+        _schedule -= std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::nanoseconds{static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(n) * 1000000000ull / _rate)});
+    }
+
+    /**
+     * Forgets reservations (bucket is full).
+     */
+    void reset () noexcept
+    {
+        _schedule = time_point{};
+        _remainder = 0;
+    }
+};
+
+enum class pacing_mode
+{
+      userspace       /**< Writes are delayed by the token bucket */
+    , max_pacing_rate /**< SO_MAX_PACING_RATE: TCP internal pacing or fq queueing discipline */
+    , txtime          /**< SO_TXTIME: per-datagram departure time (fq queueing discipline) */
+};
+
+struct pacing_options
+{
+    // Target rate in bytes per second (zero means unlimited)
+    std::uint64_t rate {0};
+
+    // Bytes that may be written back to back. Zero means amount sent at rate
+    // during 200 us: sleeps overshoot by tens of microseconds (timer slack),
+    // the bucket catches up by short bursts instead of losing rate.
+    std::size_t burst {0};
+
+    pacing_mode mode {pacing_mode::userspace};
+
+    // In kernel modes writes may run ahead of the rate by this time: kernel
+    // spaces packets precisely, the token bucket only bounds its queue
+    // (bursts are bounded too if queueing discipline ignores pacing).
+    std::chrono::microseconds kernel_horizon {2000};
+};
+
+namespace details {
+namespace pacing {
+
+// Probes of concrete device API (preferred overloads take int)
+
+template <typename Device>
+auto set_max_pacing_rate (Device & d, std::uint64_t rate, int) -> decltype(d.set_max_pacing_rate(rate))
+{
+    return d.set_max_pacing_rate(rate);
+}
+
+template <typename Device>
+error_code set_max_pacing_rate (Device &, std::uint64_t, long)
+{
+    return make_error_code(errc::operation_not_supported);
+}
+
+template <typename Device>
+auto enable_txtime (Device & d, int) -> decltype(d.enable_txtime())
+{
+    return d.enable_txtime();
+}
+
+template <typename Device>
+error_code enable_txtime (Device &, long)
+{
+    return make_error_code(errc::operation_not_supported);
+}
+
+template <typename Device>
+auto writev_at (Device & d, io_vector const * iov, int iovcnt
+    , std::chrono::steady_clock::time_point departure, error_code & ec, int)
+    -> decltype(d.writev_at(iov, iovcnt, departure, ec))
+{
+    return d.writev_at(iov, iovcnt, departure, ec);
+}
+
+template <typename Device>
+ssize_t writev_at (Device & d, io_vector const * iov, int iovcnt
+    , std::chrono::steady_clock::time_point, error_code & ec, long)
+{
+    return d.writev(iov, iovcnt, ec);
+}
+
+// Dispatchers: static_device and device forward to the underlying device
+
+template <typename Device>
+error_code set_max_pacing_rate (Device & d, std::uint64_t rate)
+{
+    return set_max_pacing_rate(d, rate, 0);
+}
+
+template <typename Impl>
+error_code set_max_pacing_rate (static_device<Impl> & d, std::uint64_t rate)
+{
+    return set_max_pacing_rate(d.underlying(), rate, 0);
+}
+
+inline error_code set_max_pacing_rate (device & d, std::uint64_t rate)
+{
+    if (auto s = underlying_device<udp_socket>(d))
+        return s->set_max_pacing_rate(rate);
+
+    if (auto s = underlying_device<tcp_socket>(d))
+        return s->set_max_pacing_rate(rate);
+
+    if (auto s = underlying_device<tcp_peer>(d))
+        return s->set_max_pacing_rate(rate);
+
+    return make_error_code(errc::operation_not_supported);
+}
+
+template <typename Device>
+error_code enable_txtime (Device & d)
+{
+    return enable_txtime(d, 0);
+}
+
+template <typename Impl>
+error_code enable_txtime (static_device<Impl> & d)
+{
+    return enable_txtime(d.underlying(), 0);
+}
+
+inline error_code enable_txtime (device & d)
+{
+    if (auto s = underlying_device<udp_socket>(d))
+        return s->enable_txtime();
+
+    return make_error_code(errc::operation_not_supported);
+}
+
+template <typename Device>
+ssize_t writev_at (Device & d, io_vector const * iov, int iovcnt
+    , std::chrono::steady_clock::time_point departure, error_code & ec)
+{
+    return writev_at(d, iov, iovcnt, departure, ec, 0);
+}
+
+template <typename Impl>
+ssize_t writev_at (static_device<Impl> & d, io_vector const * iov, int iovcnt
+    , std::chrono::steady_clock::time_point departure, error_code & ec)
+{
+    return writev_at(d.underlying(), iov, iovcnt, departure, ec, 0);
+}
+
+inline ssize_t writev_at (device & d, io_vector const * iov, int iovcnt
+    , std::chrono::steady_clock::time_point departure, error_code & ec)
+{
+    if (auto s = underlying_device<udp_socket>(d))
+        return s->writev_at(iov, iovcnt, departure, ec);
+
+    return d.writev(iov, iovcnt, ec);
+}
+
+}} // details::pacing
+
+/**
+ * @brief Writable device with output paced to the target rate.
+ *
+ * Writes exceeding the token bucket sleep until they conform, bytes not
+ * accepted by the device are returned to the bucket. Kernel modes are used
+ * if the device supports them (udp_socket: set_max_pacing_rate() and
+ * enable_txtime(), tcp_socket: set_max_pacing_rate()), also when wrapped by
+ * @c device or @c static_device. Otherwise the device falls back to
+ * userspace mode (see mode()).
+ *
+ * @tparam Device @c device, @c static_device or any type with write()
+ *         (and writev() if used).
+ */
+template <typename Device = device>
+class basic_paced_device
+{
+    using clock_type = token_bucket::clock_type;
+    using time_point = token_bucket::time_point;
+
+    Device * _d {nullptr};
+    token_bucket _bucket;
+    pacing_options _options;
+
+private:
+    std::size_t effective_burst () const noexcept
+    {
+        auto burst = _options.burst > 0
+            ? _options.burst
+            : static_cast<std::size_t>(_options.rate / 5000);
+
+        if (_options.mode != pacing_mode::userspace) {
+            burst += static_cast<std::size_t>(_options.rate
+                * static_cast<std::uint64_t>(_options.kernel_horizon.count()) / 1000000);
+        }
+
+        return burst;
+    }
+
+    void configure ()
+    {
+        if (_options.mode == pacing_mode::max_pacing_rate) {
+            if (details::pacing::set_max_pacing_rate(*_d, _options.rate))
+                _options.mode = pacing_mode::userspace;
+        } else if (_options.mode == pacing_mode::txtime) {
+            if (details::pacing::enable_txtime(*_d))
+                _options.mode = pacing_mode::userspace;
+        }
+
+        _bucket.set_rate(_options.rate, effective_burst());
+    }
+
+    // Waits until @a n bytes conform, returns their departure time
+    time_point pace (size_t n)
+    {
+        auto now = clock_type::now();
+        auto start = _bucket.reserve(n, now);
+        auto release = start - _bucket.tolerance();
+
+        if (release > now)
+            std::this_thread::sleep_until(release);
+
+        return start;
+    }
+
+    // Charges only bytes actually written
+    ssize_t settle (size_t n, ssize_t written)
+    {
+        _bucket.release(written < 0 ? n : n - static_cast<size_t>(written));
+        return written;
+    }
+
+public:
+    basic_paced_device (Device & d, pacing_options const & options)
+        : _d(& d)
+        , _options(options)
+    {
+        configure();
+    }
+
+    /**
+     * @return Mode in effect (userspace if device does not support the
+     *         requested one).
+     */
+    pacing_mode mode () const noexcept
+    {
+        return _options.mode;
+    }
+
+    std::uint64_t rate () const noexcept
+    {
+        return _options.rate;
+    }
+
+    /**
+     * Changes target rate, reservations made at previous rate are kept.
+     */
+    void set_rate (std::uint64_t rate)
+    {
+        _options.rate = rate;
+
+        if (_options.mode == pacing_mode::max_pacing_rate)
+            details::pacing::set_max_pacing_rate(*_d, rate);
+
+        _bucket.set_rate(rate, effective_burst());
+    }
+
+    Device & underlying () noexcept
+    {
+        return *_d;
+    }
+
+    ssize_t write (char const * bytes, size_t n, error_code & ec)
+    {
+        auto departure = pace(n);
+
+        if (_options.mode == pacing_mode::txtime) {
+            io_vector iov;
+            iov.iov_base = const_cast<char *>(bytes);
+            iov.iov_len = n;
+            return settle(n, details::pacing::writev_at(*_d, & iov, 1, departure, ec));
+        }
+
+        return settle(n, _d->write(bytes, n, ec));
+    }
+
+    ssize_t write (char const * bytes, size_t n)
+    {
+        error_code ec;
+        auto r = write(bytes, n, ec);
+        if (r < 0) throw exception(ec);
+        return r;
+    }
+
+    ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec)
+    {
+        size_t n = 0;
+
+        for (int i = 0; i < iovcnt; i++)
+            n += iov[i].iov_len;
+
+        auto departure = pace(n);
+
+        return settle(n, _options.mode == pacing_mode::txtime
+            ? details::pacing::writev_at(*_d, iov, iovcnt, departure, ec)
+            : _d->writev(iov, iovcnt, ec));
+    }
+};
+
+using paced_device = basic_paced_device<>;
+
+}} // pfs::io
@@ -0,0 +1,390 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Growing scratch buffer for record boundary search, minimum chunk size
+//      2026.10.19 Chunk boundaries are searched once, truncated file is reported,
+//                 ordered mapped chunks are prefaulted in parallel
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+namespace platform {
+namespace file {
+
+#if defined(PFS_OS_LINUX)
+    using unix_ns::file::map_view;
+    using unix_ns::file::unmap_view;
+#endif
+
+}} // platform::file
+
+enum class delivery_order
+{
+      ordered   /**< Chunks (records) are delivered in file order by one thread at a time */
+    , unordered /**< Chunks (records) are delivered concurrently as soon as they are read */
+};
+
+struct parallel_reader_options
+{
+    enum : size_t { min_chunk_size = 4096 };
+
+    // Number of worker threads, zero means number of hardware threads
+    unsigned thread_count {0};
+
+    // Nominal chunk size (at least min_chunk_size), actual chunk boundaries
+    // are moved to the next record boundary
+    size_t chunk_size {8 * 1024 * 1024};
+
+    char delimiter {'\n'};
+
+    delivery_order order {delivery_order::ordered};
+
+    // Map file into memory instead of reading chunks with pread(), falls back
+    // to pread() if mapping fails. In ordered mode callbacks are serialized,
+    // so workers only fault in pages of their chunks ahead of delivery.
+    bool use_mmap {true};
+};
+
+namespace details {
+
+/**
+ * Returns offset of the first record starting at or after @a offset (i.e.
+ * following the first delimiter at or after @a offset - 1), or @a size if
+ * there is no such record.
+ */
+inline offset_type record_start (file & f
+    , char const * view
+    , offset_type size
+    , offset_type offset
+    , char delimiter
+    , std::vector<char> & scratch
+    , error_code & ec)
+{
+    if (offset <= 0)
+        return 0;
+
+    if (offset >= size)
+        return size;
+
+    auto pos = offset - 1;
+
+    if (view) {
+        auto p = static_cast<char const *>(std::memchr(view + pos, delimiter
+            , static_cast<size_t>(size - pos)));
+        return p ? (p - view) + 1 : size;
+    }
+
+    // Records are usually short: start with a small read and grow it while
+    // no delimiter is found, so long records cost a logarithmic number of reads
+    size_t len = 256;
+
+    while (pos < size) {
+        scratch.resize(len);
+        auto n = f.read_at(scratch.data(), len, pos, ec);
+
+        if (n < 0)
+            return -1;
+
+        // File is shorter than its size at open time
+        if (n == 0) {
+            ec = make_error_code(errc::unexpected_end_of_file);
+            return -1;
+        }
+
+        auto p = static_cast<char const *>(std::memchr(scratch.data(), delimiter
+            , static_cast<size_t>(n)));
+
+        if (p)
+            return pos + (p - scratch.data()) + 1;
+
+        pos += n;
+        len = std::min(len * 2, size_t{1024 * 1024});
+    }
+
+    return size;
+}
+
+/**
+ * Reads exactly @a n bytes unless end of file reached.
+ */
+inline ssize_t read_range (file & f
+    , char * bytes
+    , size_t n
+    , offset_type offset
+    , error_code & ec)
+{
+    size_t total = 0;
+
+    while (total < n) {
+        auto r = f.read_at(bytes + total, n - total
+            , offset + static_cast<offset_type>(total), ec);
+
+        if (r < 0)
+            return -1;
+
+        if (r == 0)
+            break;
+
+        total += static_cast<size_t>(r);
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+/**
+ * Touches every page of the range [@a begin, @a end) of the mapped @a view
+ * to fault it in.
+ */
+inline void prefault (char const * view, offset_type begin, offset_type end)
+{
+    static offset_type const page_size = 4096;
+    char volatile sink = 0;
+
+    for (auto pos = begin; pos < end; pos += page_size)
+        sink = sink ^ view[pos];
+
+    if (begin < end)
+        sink = sink ^ view[end - 1];
+}
+
+} // details
+
+/**
+ * @brief Reads delimited records of a file using several threads.
+ *
+ * File is divided into chunks of nominal size, each chunk boundary is moved
+ * to the start of the next record, so every record belongs to exactly one
+ * chunk. Worker threads first search chunk boundaries (each one once), then
+ * take chunks one by one, map (or pread()) them and deliver them to the
+ * callback.
+ *
+ * File is expected to stay unchanged while it is read. Truncation detected
+ * during the pass is reported with errc::unexpected_end_of_file (note that
+ * access to a truncated mapping raises SIGBUS, so set
+ * parallel_reader_options::use_mmap to false if the file may shrink).
+ */
+class parallel_reader
+{
+    std::string _path;
+    parallel_reader_options _options;
+
+public:
+    parallel_reader (std::string const & path
+        , parallel_reader_options const & options = parallel_reader_options{})
+        : _path(path)
+        , _options(options)
+    {}
+
+    /**
+     * Calls f(offset_type offset, char const * data, size_t n) for each
+     * non-empty chunk. Chunk consists of whole records including delimiters
+     * (last record of the file may have no delimiter). Chunk data is valid
+     * during the call only. @a f must not throw.
+     */
+    template <typename F>
+    error_code for_each_chunk (F && f)
+    {
+        error_code ec;
+        auto d = make_static_file(_path, read_only, owner_read, durability::none, ec);
+
+        if (ec)
+            return ec;
+
+        auto & fd = d.underlying();
+        auto size = fd.size(ec);
+
+        if (ec || size == 0)
+            return ec;
+
+        char const * view = nullptr;
+
+        if (_options.use_mmap) {
+            view = platform::file::map_view(& fd.handle(), 0, static_cast<size_t>(size)
+                , access_advice::sequential, ec);
+            ec.clear();
+        }
+
+        if (!view)
+            fd.advise(access_advice::sequential);
+
+        auto chunk_size = static_cast<offset_type>(std::max(_options.chunk_size
+            , static_cast<size_t>(parallel_reader_options::min_chunk_size)));
+        auto chunk_count = static_cast<size_t>((size + chunk_size - 1) / chunk_size);
+        unsigned thread_count = _options.thread_count > 0
+            ? _options.thread_count
+            : std::max(std::thread::hardware_concurrency(), 1u);
+
+        thread_count = static_cast<unsigned>(std::min<size_t>(thread_count, chunk_count));
+
+        bool ordered = _options.order == delivery_order::ordered;
+        char delimiter = _options.delimiter;
+        std::atomic<size_t> next_boundary {1};
+        std::atomic<size_t> next_chunk {0};
+        std::atomic<bool> failed {false};
+        std::mutex mtx;
+        std::condition_variable cv;
+        unsigned boundaries_done = 0;
+        size_t next_delivery = 0;
+        error_code failure;
+
+        // Chunk k is [boundaries[k], boundaries[k + 1])
+        std::vector<offset_type> boundaries(chunk_count + 1, 0);
+        boundaries[chunk_count] = size;
+
+        auto worker = [&] {
+            std::vector<char> buffer;
+            std::vector<char> scratch;
+
+            while (!failed) {
+                auto k = next_boundary++;
+
+                if (k >= chunk_count)
+                    break;
+
+                error_code wec;
+                boundaries[k] = details::record_start(fd, view, size
+                    , static_cast<offset_type>(k) * chunk_size, delimiter, scratch, wec);
+
+                if (wec) {
+                    std::lock_guard<std::mutex> lk(mtx);
+
+                    if (!failure) {
+                        failure = wec;
+                        failed = true;
+                    }
+                }
+            }
+
+            // Wait until all boundaries are found
+            {
+                std::unique_lock<std::mutex> lk(mtx);
+
+                if (++boundaries_done == thread_count)
+                    cv.notify_all();
+                else
+                    cv.wait(lk, [& boundaries_done, thread_count] {
+                        return boundaries_done == thread_count;
+                    });
+            }
+
+            while (!failed) {
+                auto k = next_chunk++;
+
+                if (k >= chunk_count)
+                    break;
+
+                error_code wec;
+                auto begin = boundaries[k];
+                auto end = boundaries[k + 1];
+                char const * data = nullptr;
+                size_t n = 0;
+
+                if (end > begin) {
+                    if (view) {
+                        data = view + begin;
+                        n = static_cast<size_t>(end - begin);
+
+                        if (ordered)
+                            details::prefault(view, begin, end);
+                    } else {
+                        buffer.resize(static_cast<size_t>(end - begin));
+                        auto r = details::read_range(fd, buffer.data(), buffer.size(), begin, wec);
+
+                        // File is shorter than its size at open time
+                        if (r >= 0 && static_cast<size_t>(r) < buffer.size())
+                            wec = make_error_code(errc::unexpected_end_of_file);
+
+                        data = buffer.data();
+                        n = buffer.size();
+                    }
+                }
+
+                if (ordered) {
+                    std::unique_lock<std::mutex> lk(mtx);
+                    cv.wait(lk, [& next_delivery, k] { return next_delivery == k; });
+                }
+
+                if (n > 0 && !wec && !failed)
+                    f(begin, data, n);
+
+                std::lock_guard<std::mutex> lk(mtx);
+
+                if (wec && !failure) {
+                    failure = wec;
+                    failed = true;
+                }
+
+                if (ordered) {
+                    ++next_delivery;
+                    cv.notify_all();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (unsigned i = 1; i < thread_count; i++)
+            threads.emplace_back(worker);
+
+        // Calling thread is a worker too
+        worker();
+
+        for (auto & t: threads)
+            t.join();
+
+        if (view)
+            platform::file::unmap_view(view, static_cast<size_t>(size));
+
+        // Mapped data gives no sign of truncation
+        if (!failure && view && fd.size(ec) < size)
+            failure = ec ? ec : make_error_code(errc::unexpected_end_of_file);
+
+        return failure;
+    }
+
+    /**
+     * Calls f(char const * data, size_t n) for each record (without
+     * delimiter). In unordered mode @a f is called concurrently from several
+     * threads. @a f must not throw.
+     */
+    template <typename F>
+    error_code for_each_record (F && f)
+    {
+        char delimiter = _options.delimiter;
+
+        return for_each_chunk([& f, delimiter] (offset_type, char const * data, size_t n) {
+            auto end = data + n;
+
+            while (data < end) {
+                auto p = static_cast<char const *>(std::memchr(data, delimiter
+                    , static_cast<size_t>(end - data)));
+
+                if (!p) {
+                    f(data, static_cast<size_t>(end - data));
+                    break;
+                }
+
+                f(data, static_cast<size_t>(p - data));
+                data = p + 1;
+            }
+        });
+    }
+};
+
+}} // pfs::io
@@ -0,0 +1,1668 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Packets of other hosts are dropped, datagrams are sent
+//                 out of lock
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "binary_stream.hpp"
+#include "device.hpp"
+#include "udp_server.hpp"
+#include "udp_socket.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//
+// Reliable UDP (RUDP): reliable ordered (or unordered) message transport over
+// UDP. Every datagram starts with header (big-endian):
+//
+//      [u8 type][u8 flags][u16 window][u32 connection id][u32 seq][u32 ack]
+//
+// DATA and FIN packets are numbered and retransmitted until acknowledged.
+// ACK carries cumulative acknowledgement (next expected seq), free receive
+// window (in packets) and up to 8 SACK blocks:
+//
+//      [u8 count]{[u32 first][u32 last + 1]}
+//
+// Connection is set up by SYN -> SYN_ACK -> any packet handshake. Server
+// answers SYN from a new socket bound to ephemeral port, so every connection
+// has its own socket and the listening one only accepts. FIN is numbered like
+// DATA and marks end of stream. RST sent after FIN is acknowledged releases
+// connection, otherwise it aborts connection.
+//
+// Packet is considered lost if a packet sent after it is acknowledged and it
+// is not acknowledged itself within RTT + RTT/4 (RACK), or on retransmission
+// timeout (RFC 6298). Tail loss probe after 2 * SRTT of silence lets RACK
+// repair losses at the end of a flight. Congestion window follows NewReno:
+// slow start, congestion avoidance and one window reduction per recovery
+// episode.
+//
+
+namespace pfs {
+namespace io {
+
+/**
+ * Packet loss and delay applied to outgoing packets (in-process network
+ * emulation for tests and benchmarks).
+ */
+struct rudp_impairment
+{
+    double loss {0}; // drop probability
+    std::chrono::milliseconds delay {0};
+    std::chrono::milliseconds jitter {0}; // random extra delay up to jitter
+    std::uint32_t seed {1};
+};
+
+struct rudp_options
+{
+    // Delivery order, chosen by connecting side. Unordered messages must fit
+    // into a single packet.
+    bool ordered {true};
+    bool nonblocking {false};
+
+    // Message bytes per packet, longer ordered messages are fragmented
+    size_t max_payload {1200};
+
+    // Packets queued and not yet acknowledged (write() blocks beyond)
+    size_t send_window {1024};
+
+    // Packets buffered by receiver
+    size_t receive_window {1024};
+
+    std::chrono::milliseconds initial_rto {200};
+    std::chrono::milliseconds min_rto {20};
+    std::chrono::milliseconds max_rto {2000};
+
+    // Consecutive retransmission timeouts before connection fails
+    int max_retransmits {10};
+
+    std::chrono::milliseconds connect_timeout {3000};
+
+    // Connection fails if nothing is received from peer for this time,
+    // keepalives are sent after a third of it
+    std::chrono::milliseconds idle_timeout {10000};
+
+    // How long close() waits for acknowledgement of outstanding data before
+    // resetting connection (restarted while acknowledgements arrive)
+    std::chrono::milliseconds linger {2000};
+
+    rudp_impairment impairment;
+};
+
+struct rudp_stats
+{
+    std::uint64_t packets_sent {0};
+    std::uint64_t packets_retransmitted {0};
+    std::uint64_t packets_received {0};
+    std::uint64_t duplicates {0};
+    std::uint64_t packets_dropped {0}; // by impairment
+    std::uint64_t timeouts {0};
+    std::chrono::microseconds srtt {0};
+    std::chrono::microseconds rto {0};
+    double cwnd {0};
+};
+
+namespace details {
+namespace rudp {
+
+enum packet_type : std::uint8_t
+{
+      syn = 1
+    , syn_ack
+    , data
+    , ack
+    , fin
+    , rst
+};
+
+enum packet_flag : std::uint8_t
+{
+      end_of_message = 0x01
+    , unordered      = 0x02
+};
+
+enum {
+      header_size     = 16
+    , max_sack_blocks = 8
+};
+
+struct header
+{
+    std::uint8_t  type;
+    std::uint8_t  flags;
+    std::uint16_t window;
+    std::uint32_t conn_id;
+    std::uint32_t seq;
+    std::uint32_t ack;
+};
+
+inline void encode_header (header const & h, char * out) noexcept
+{
+    out[0] = static_cast<char>(h.type);
+    out[1] = static_cast<char>(h.flags);
+    field_codec<std::uint16_t, endian::big>::encode(h.window, out + 2);
+    field_codec<std::uint32_t, endian::big>::encode(h.conn_id, out + 4);
+    field_codec<std::uint32_t, endian::big>::encode(h.seq, out + 8);
+    field_codec<std::uint32_t, endian::big>::encode(h.ack, out + 12);
+}
+
+inline bool decode_header (char const * in, size_t n, header & h) noexcept
+{
+    if (n < header_size)
+        return false;
+
+    h.type    = static_cast<std::uint8_t>(in[0]);
+    h.flags   = static_cast<std::uint8_t>(in[1]);
+    h.window  = field_codec<std::uint16_t, endian::big>::decode(in + 2);
+    h.conn_id = field_codec<std::uint32_t, endian::big>::decode(in + 4);
+    h.seq     = field_codec<std::uint32_t, endian::big>::decode(in + 8);
+    h.ack     = field_codec<std::uint32_t, endian::big>::decode(in + 12);
+
+    return h.type >= syn && h.type <= rst;
+}
+
+/**
+ * Restores sequence number from its lower 32 bits (the one nearest to
+ * @a expected).
+ */
+inline std::uint64_t expand_seq (std::uint32_t wire, std::uint64_t expected) noexcept
+{
+    std::uint64_t const span = std::uint64_t{1} << 32;
+    std::uint64_t result = (expected & ~(span - 1)) | wire;
+
+    if (result + span / 2 < expected)
+        result += span;
+    else if (result > expected + span / 2 && result >= span)
+        result -= span;
+
+    return result;
+}
+
+}} // details::rudp
+
+/**
+ * @brief RUDP connection.
+ *
+ * Background thread receives packets, sends acknowledgements and
+ * retransmissions. read() and write() may be called from different threads.
+ *
+ * Data written by single write() is delivered as one message: read_message()
+ * returns it whole, read() treats incoming messages as a byte stream.
+ */
+class rudp_socket : public basic_device
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using host_address = udp_socket::host_address;
+
+private:
+    using time_point = clock_type::time_point;
+    using microseconds = std::chrono::microseconds;
+    using header = details::rudp::header;
+
+    enum class state { closed, syn_sent, syn_received, established };
+
+    struct outgoing_packet
+    {
+        std::string datagram;
+        time_point sent;
+        int transmissions;
+        bool sacked;
+        bool lost;
+    };
+
+    struct incoming_piece
+    {
+        std::string data;
+        bool end_of_message;
+    };
+
+    static constexpr std::uint64_t no_seq = std::numeric_limits<std::uint64_t>::max();
+
+private:
+    rudp_options _options;
+    udp_socket _socket;
+    host_address _peer;
+    std::uint32_t _conn_id {0};
+    bool _ordered {true};
+
+    mutable std::mutex _mtx; // protects members below
+    std::condition_variable _read_cv;
+    std::condition_variable _write_cv; // send queue space, drain on close
+    state _state {state::closed};
+    bool _stopping {false};
+    bool _peer_closed {false};
+    bool _peer_released {false};
+    error_code _failure;
+
+    // Sender
+    std::deque<std::string> _send_queue; // numbered, never sent
+    std::map<std::uint64_t, outgoing_packet> _unacked;
+    std::uint64_t _snd_una {0};
+    std::uint64_t _snd_next {0};
+    size_t _in_flight {0};
+    size_t _lost_count {0};
+    size_t _peer_window {0};
+    bool _probe {false};
+    double _cwnd {0};
+    double _ssthresh {0};
+    std::uint64_t _recovery_end {0};
+
+    // Timers
+    time_point _rto_deadline;
+    bool _rto_armed {false};
+    int _backoff {0};
+    microseconds _srtt {0};
+    microseconds _rttvar {0};
+    microseconds _rto {0};
+    microseconds _min_rtt {0};
+    microseconds _latest_rtt {0};
+    time_point _rack_sent;
+    std::uint64_t _rack_seq {0};
+    bool _rack_valid {false};
+    time_point _rack_deadline;
+    bool _rack_armed {false};
+    time_point _tlp_deadline;
+    bool _tlp_armed {false};
+
+    // Receiver
+    std::uint64_t _rcv_next {0};
+    std::map<std::uint64_t, incoming_piece> _out_of_order;
+    std::deque<incoming_piece> _received;
+    size_t _read_pos {0};
+    size_t _complete_messages {0};
+    std::uint64_t _fin_seq {no_seq};
+    bool _ack_pending {false};
+    size_t _advertised_window {0};
+
+    time_point _last_received;
+    time_point _last_sent;
+
+    std::mt19937 _rng;
+    std::multimap<time_point, std::string> _delayed;
+    std::vector<std::string> _outbox; // sent by flush_outbox() out of lock
+    rudp_stats _stats;
+
+    std::thread _worker;
+    time_point _worker_wakeup; // when waiting worker wakes up by itself
+    udp_socket::device_handle _wakeup_reader;
+    udp_socket::device_handle _wakeup_writer;
+
+private:
+    rudp_socket (udp_socket && s, rudp_options const & options, std::uint32_t conn_id)
+        : _options(options)
+        , _socket(std::move(s))
+        , _peer(_socket.address())
+        , _conn_id(conn_id)
+        , _peer_window(options.receive_window)
+        , _cwnd(static_cast<double>(std::min<size_t>(10, options.send_window)))
+        , _ssthresh(static_cast<double>(options.send_window))
+        , _rto(options.initial_rto)
+        , _rng(options.impairment.seed)
+    {}
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Methods below are called with _mtx locked
+    ////////////////////////////////////////////////////////////////////////////
+    void fail (error_code const & ec)
+    {
+        if (!_failure)
+            _failure = ec;
+
+        _read_cv.notify_all();
+        _write_cv.notify_all();
+    }
+
+    // Datagrams are sent by flush_outbox() after _mtx is released, so
+    // blocking send does not stall the receive path
+    void send_datagram (std::string const & datagram)
+    {
+        _outbox.push_back(datagram);
+    }
+
+    /**
+     * Sends queued datagrams with @a locker temporarily unlocked.
+     *
+     * @return Error of the last failed send. In connected state send errors
+     *         are handled as packet loss.
+     */
+    error_code flush_outbox (std::unique_lock<std::mutex> & locker)
+    {
+        if (_outbox.empty())
+            return error_code{};
+
+        std::vector<std::string> outbox;
+        outbox.swap(_outbox);
+        auto peer = _peer;
+        error_code result;
+
+        locker.unlock();
+
+        for (auto const & datagram: outbox) {
+            error_code ec;
+
+            if (_socket.write_to(datagram.data(), datagram.size(), & peer, ec) < 0)
+                result = ec;
+        }
+
+        locker.lock();
+
+        // Reuse capacity
+        if (_outbox.empty()) {
+            outbox.clear();
+            _outbox.swap(outbox);
+        }
+
+        return result;
+    }
+
+    void transmit (std::string const & datagram, time_point now)
+    {
+        auto const & impairment = _options.impairment;
+        _last_sent = now;
+
+        if (impairment.loss > 0
+                && std::uniform_real_distribution<double>{0, 1}(_rng) < impairment.loss) {
+            _stats.packets_dropped++;
+            return;
+        }
+
+        if (impairment.delay.count() > 0 || impairment.jitter.count() > 0) {
+            auto delay = impairment.delay;
+
+            if (impairment.jitter.count() > 0) {
+                delay += std::chrono::milliseconds{std::uniform_int_distribution<int>{
+                    0, static_cast<int>(impairment.jitter.count())}(_rng)};
+            }
+
+            _delayed.emplace(now + delay, datagram);
+            return;
+        }
+
+        send_datagram(datagram);
+    }
+
+    void flush_delayed (time_point now)
+    {
+        while (!_delayed.empty() && _delayed.begin()->first <= now) {
+            send_datagram(_delayed.begin()->second);
+            _delayed.erase(_delayed.begin());
+        }
+    }
+
+    size_t receive_window_free () const
+    {
+        auto used = _received.size() + _out_of_order.size();
+        auto free = used < _options.receive_window ? _options.receive_window - used : 0;
+        return std::min<size_t>(free, std::numeric_limits<std::uint16_t>::max());
+    }
+
+    std::string make_packet (std::uint8_t type, std::uint8_t flags, std::uint64_t seq)
+    {
+        header h;
+        h.type    = type;
+        h.flags   = flags;
+        h.window  = static_cast<std::uint16_t>(receive_window_free());
+        h.conn_id = _conn_id;
+        h.seq     = static_cast<std::uint32_t>(seq);
+        h.ack     = static_cast<std::uint32_t>(_rcv_next);
+
+        std::string packet(details::rudp::header_size, '\0');
+        details::rudp::encode_header(h, & packet[0]);
+        return packet;
+    }
+
+    void send_control (std::uint8_t type, time_point now)
+    {
+        auto packet = make_packet(type, _ordered ? 0 : details::rudp::unordered, 0);
+
+        if (type == details::rudp::ack) {
+            // SACK blocks: runs of consecutive out-of-order packets
+            std::string blocks;
+            int count = 0;
+            auto pos = _out_of_order.begin();
+
+            while (pos != _out_of_order.end() && count < details::rudp::max_sack_blocks) {
+                auto first = pos->first;
+                auto last = first + 1;
+
+                for (++pos; pos != _out_of_order.end() && pos->first == last; ++pos)
+                    last++;
+
+                char buf[8];
+                field_codec<std::uint32_t, endian::big>::encode(static_cast<std::uint32_t>(first), buf);
+                field_codec<std::uint32_t, endian::big>::encode(static_cast<std::uint32_t>(last), buf + 4);
+                blocks.append(buf, 8);
+                count++;
+            }
+
+            packet.push_back(static_cast<char>(count));
+            packet += blocks;
+
+            _ack_pending = false;
+            _advertised_window = receive_window_free();
+        }
+
+        transmit(packet, now);
+    }
+
+    void enqueue (std::uint8_t type, std::uint8_t flags, char const * data, size_t n)
+    {
+        auto packet = make_packet(type, flags, _snd_next++);
+        packet.append(data, n);
+        _send_queue.push_back(std::move(packet));
+    }
+
+    microseconds current_rto () const
+    {
+        auto rto = _rto * (1 << std::min(_backoff, 10));
+        return std::min<microseconds>(rto, _options.max_rto);
+    }
+
+    void arm_rto (time_point now)
+    {
+        _rto_deadline = now + current_rto();
+        _rto_armed = true;
+    }
+
+    // Tail loss probe precedes timeout unless connection is recovering from
+    // it already
+    void arm_tlp (time_point now)
+    {
+        _tlp_armed = _backoff == 0 && _in_flight > 0 && _srtt.count() > 0;
+
+        if (_tlp_armed)
+            _tlp_deadline = now + std::max<microseconds>(2 * _srtt, std::chrono::milliseconds{1});
+    }
+
+    void disarm_rto ()
+    {
+        _rto_armed = false;
+        _tlp_armed = false;
+    }
+
+    void send_pending (time_point now)
+    {
+        auto cwnd = static_cast<size_t>(_cwnd);
+        bool transmitted = false;
+
+        // Retransmissions first
+        for (auto pos = _unacked.begin(); _lost_count > 0 && pos != _unacked.end(); ++pos) {
+            if (_in_flight >= cwnd)
+                break;
+
+            auto & p = pos->second;
+
+            if (!p.lost)
+                continue;
+
+            p.lost = false;
+            p.sent = now;
+            p.transmissions++;
+            _lost_count--;
+            _in_flight++;
+            _stats.packets_retransmitted++;
+            transmit(p.datagram, now);
+            transmitted = true;
+        }
+
+        while (!_send_queue.empty() && (_in_flight < cwnd || _probe)) {
+            auto seq = _snd_next - _send_queue.size();
+
+            // Receiver window is exhausted, probe it on timeout
+            if (seq >= _snd_una + _peer_window && !_probe)
+                break;
+
+            _probe = false;
+
+            outgoing_packet p;
+            p.datagram = std::move(_send_queue.front());
+            p.sent = now;
+            p.transmissions = 1;
+            p.sacked = false;
+            p.lost = false;
+            _send_queue.pop_front();
+
+            _in_flight++;
+            _stats.packets_sent++;
+            transmit(p.datagram, now);
+            transmitted = true;
+            _unacked.emplace(seq, std::move(p));
+        }
+
+        if (!_rto_armed && (_in_flight > 0 || _lost_count > 0 || !_send_queue.empty()))
+            arm_rto(now);
+
+        if (transmitted)
+            arm_tlp(now);
+    }
+
+    void update_rtt (microseconds rtt)
+    {
+        rtt = std::max(rtt, microseconds{1});
+        _latest_rtt = rtt;
+
+        if (_min_rtt.count() == 0 || rtt < _min_rtt)
+            _min_rtt = rtt;
+
+        if (_srtt.count() == 0) {
+            _srtt = rtt;
+            _rttvar = rtt / 2;
+        } else {
+            auto delta = _srtt > rtt ? _srtt - rtt : rtt - _srtt;
+            _rttvar = (3 * _rttvar + delta) / 4;
+            _srtt = (7 * _srtt + rtt) / 8;
+        }
+
+        // Clock granularity is 1 ms (timers are polled)
+        _rto = _srtt + std::max<microseconds>(std::chrono::milliseconds{1}, 4 * _rttvar);
+        _rto = std::max<microseconds>(_rto, _options.min_rto);
+        _rto = std::min<microseconds>(_rto, _options.max_rto);
+    }
+
+    void on_congestion_event ()
+    {
+        // One reduction per window of data
+        if (_snd_una >= _recovery_end) {
+            _ssthresh = std::max(_cwnd / 2, 2.0);
+            _cwnd = _ssthresh;
+            _recovery_end = _snd_next;
+        }
+    }
+
+    void detect_losses (time_point now)
+    {
+        _rack_armed = false;
+
+        if (!_rack_valid)
+            return;
+
+        auto reordering = std::max<microseconds>(_min_rtt / 4, std::chrono::milliseconds{1});
+        auto window = (_latest_rtt.count() > 0 ? _latest_rtt : _rto) + reordering;
+        bool loss = false;
+
+        for (auto & item: _unacked) {
+            auto & p = item.second;
+
+            if (p.sacked || p.lost)
+                continue;
+
+            bool sent_before = p.sent < _rack_sent
+                || (p.sent == _rack_sent && item.first < _rack_seq);
+
+            if (!sent_before)
+                continue;
+
+            auto deadline = p.sent + window;
+
+            if (deadline <= now) {
+                p.lost = true;
+                _in_flight--;
+                _lost_count++;
+                loss = true;
+            } else if (!_rack_armed || deadline < _rack_deadline) {
+                _rack_deadline = deadline;
+                _rack_armed = true;
+            }
+        }
+
+        if (loss)
+            on_congestion_event();
+    }
+
+    /**
+     * Tail loss probe: when the last packets of a flight (or acknowledgement
+     * for them) are lost, nothing triggers SACK based recovery. New packet or
+     * retransmitted last one provokes acknowledgement well before timeout.
+     */
+    void send_tail_probe (time_point now)
+    {
+        _tlp_armed = false;
+
+        if (!_send_queue.empty() && _snd_next - _send_queue.size() < _snd_una + _peer_window) {
+            _probe = true;
+            send_pending(now);
+            return;
+        }
+
+        for (auto pos = _unacked.rbegin(); pos != _unacked.rend(); ++pos) {
+            auto & p = pos->second;
+
+            if (p.sacked)
+                continue;
+
+            if (p.lost) {
+                p.lost = false;
+                _lost_count--;
+                _in_flight++;
+            }
+
+            p.sent = now;
+            p.transmissions++;
+            _stats.packets_retransmitted++;
+            transmit(p.datagram, now);
+            break;
+        }
+    }
+
+    void on_timeout (time_point now)
+    {
+        disarm_rto();
+
+        if (_state != state::syn_received && _unacked.empty() && _send_queue.empty())
+            return;
+
+        if (++_backoff > _options.max_retransmits) {
+            fail(make_error_code(errc::timedout));
+            return;
+        }
+
+        if (_state == state::syn_received) {
+            send_control(details::rudp::syn_ack, now);
+            arm_rto(now);
+            return;
+        }
+
+        _stats.timeouts++;
+
+        if (!_unacked.empty()) {
+            for (auto & item: _unacked) {
+                auto & p = item.second;
+
+                if (!p.sacked && !p.lost) {
+                    p.lost = true;
+                    _in_flight--;
+                    _lost_count++;
+                }
+            }
+
+            _ssthresh = std::max(_cwnd / 2, 2.0);
+            _cwnd = 1;
+            _recovery_end = _snd_next;
+        } else {
+            _probe = true;
+        }
+
+        send_pending(now);
+    }
+
+    void on_ack (header const & h, char const * payload, size_t n, time_point now)
+    {
+        auto sent_end = _snd_next - _send_queue.size();
+        auto cum = details::rudp::expand_seq(h.ack, _snd_una);
+
+        if (cum > sent_end)
+            return;
+
+        _peer_window = h.window;
+
+        size_t newly_acked = 0;
+        bool has_sample = false;
+        time_point sample_sent;
+
+        auto acknowledge = [&] (std::uint64_t seq, outgoing_packet & p) {
+            if (p.sacked)
+                return;
+
+            if (p.lost)
+                _lost_count--;
+            else
+                _in_flight--;
+
+            p.lost = false;
+            newly_acked++;
+
+            if (!_rack_valid || p.sent > _rack_sent
+                    || (p.sent == _rack_sent && seq > _rack_seq)) {
+                _rack_sent = p.sent;
+                _rack_seq = seq;
+                _rack_valid = true;
+            }
+
+            // Karn's algorithm: retransmitted packets give ambiguous samples
+            if (p.transmissions == 1 && (!has_sample || p.sent > sample_sent)) {
+                sample_sent = p.sent;
+                has_sample = true;
+            }
+        };
+
+        while (!_unacked.empty() && _unacked.begin()->first < cum) {
+            acknowledge(_unacked.begin()->first, _unacked.begin()->second);
+            _unacked.erase(_unacked.begin());
+        }
+
+        _snd_una = std::max(_snd_una, cum);
+
+        if (n > 0) {
+            size_t count = std::min<size_t>(static_cast<std::uint8_t>(payload[0])
+                , details::rudp::max_sack_blocks);
+
+            for (size_t i = 0; i < count && 1 + 8 * (i + 1) <= n; i++) {
+                auto block = payload + 1 + 8 * i;
+                auto first = details::rudp::expand_seq(
+                    field_codec<std::uint32_t, endian::big>::decode(block), _snd_una);
+                auto last = details::rudp::expand_seq(
+                    field_codec<std::uint32_t, endian::big>::decode(block + 4), _snd_una);
+
+                for (auto pos = _unacked.lower_bound(first)
+                        ; pos != _unacked.end() && pos->first < last; ++pos) {
+                    acknowledge(pos->first, pos->second);
+                    pos->second.sacked = true;
+                    pos->second.datagram.clear();
+                }
+            }
+        }
+
+        if (has_sample)
+            update_rtt(std::chrono::duration_cast<microseconds>(now - sample_sent));
+
+        if (newly_acked > 0) {
+            _backoff = 0;
+
+            if (_snd_una >= _recovery_end) {
+                if (_cwnd < _ssthresh)
+                    _cwnd += newly_acked;
+                else
+                    _cwnd += newly_acked / _cwnd;
+
+                _cwnd = std::min(_cwnd, static_cast<double>(_options.send_window));
+            }
+
+            if (_in_flight > 0 || _lost_count > 0 || !_send_queue.empty()) {
+                arm_rto(now);
+                arm_tlp(now);
+            } else {
+                disarm_rto();
+            }
+
+            _write_cv.notify_all();
+        }
+
+        detect_losses(now);
+    }
+
+    void deliver (std::uint64_t seq, incoming_piece && piece)
+    {
+        if (seq == _fin_seq)
+            return;
+
+        if (piece.end_of_message)
+            _complete_messages++;
+
+        _received.push_back(std::move(piece));
+    }
+
+    void on_data (header const & h, char const * payload, size_t n)
+    {
+        auto seq = details::rudp::expand_seq(h.seq, _rcv_next);
+
+        if (seq < _rcv_next || _out_of_order.count(seq) > 0) {
+            _stats.duplicates++;
+            return;
+        }
+
+        // Far beyond advertised window
+        if (seq - _rcv_next > _options.receive_window)
+            return;
+
+        if (h.type == details::rudp::fin)
+            _fin_seq = seq;
+
+        incoming_piece piece {std::string(payload, n)
+            , (h.flags & details::rudp::end_of_message) != 0};
+
+        if (_ordered) {
+            if (seq != _rcv_next) {
+                _out_of_order.emplace(seq, std::move(piece));
+                return;
+            }
+
+            deliver(seq, std::move(piece));
+            ++_rcv_next;
+
+            while (!_out_of_order.empty() && _out_of_order.begin()->first == _rcv_next) {
+                deliver(_rcv_next, std::move(_out_of_order.begin()->second));
+                _out_of_order.erase(_out_of_order.begin());
+                ++_rcv_next;
+            }
+        } else {
+            deliver(seq, std::move(piece));
+
+            // Out-of-order entries only track received sequence numbers
+            if (seq != _rcv_next) {
+                _out_of_order.emplace(seq, incoming_piece{std::string{}, false});
+            } else {
+                ++_rcv_next;
+
+                while (!_out_of_order.empty() && _out_of_order.begin()->first == _rcv_next) {
+                    _out_of_order.erase(_out_of_order.begin());
+                    ++_rcv_next;
+                }
+            }
+        }
+
+        if (_fin_seq != no_seq && _rcv_next > _fin_seq)
+            _peer_closed = true;
+
+        _read_cv.notify_all();
+    }
+
+    void on_packet (host_address const & from, char const * data, size_t n, time_point now)
+    {
+        header h;
+
+        // Packets from other hosts are not trusted whatever the conn_id is
+        if (from != _peer)
+            return;
+
+        if (!details::rudp::decode_header(data, n, h) || h.conn_id != _conn_id)
+            return;
+
+        _stats.packets_received++;
+        _last_received = now;
+
+        if (h.type == details::rudp::syn)
+            return;
+
+        // RST after FIN releases connection, otherwise aborts it
+        if (h.type == details::rudp::rst) {
+            if (_peer_closed) {
+                _peer_released = true;
+                _write_cv.notify_all();
+            } else {
+                fail(make_error_code(errc::connection_reset));
+            }
+
+            return;
+        }
+
+        // Any packet from client completes the handshake
+        if (_state == state::syn_received) {
+            _state = state::established;
+            _backoff = 0;
+            disarm_rto();
+        }
+
+        auto payload = data + details::rudp::header_size;
+        auto payload_size = n - details::rudp::header_size;
+
+        switch (h.type) {
+            case details::rudp::syn_ack:
+                // Lost acknowledgement of SYN_ACK
+                _ack_pending = true;
+                break;
+
+            case details::rudp::ack:
+                on_ack(h, payload, payload_size, now);
+                break;
+
+            default:
+                on_data(h, payload, payload_size);
+                _ack_pending = true;
+                break;
+        }
+    }
+
+    // Sends window update when reader frees enough space
+    void update_window (time_point now)
+    {
+        auto threshold = _advertised_window + std::max<size_t>(1, _options.receive_window / 4);
+
+        if (_state == state::established && receive_window_free() >= threshold)
+            send_control(details::rudp::ack, now);
+    }
+
+    size_t consume (char * bytes, size_t n)
+    {
+        size_t total = 0;
+
+        while (total < n && !_received.empty()) {
+            auto & piece = _received.front();
+            auto count = std::min(n - total, piece.data.size() - _read_pos);
+
+            std::copy(piece.data.data() + _read_pos, piece.data.data() + _read_pos + count, bytes + total);
+            total += count;
+            _read_pos += count;
+
+            if (_read_pos == piece.data.size()) {
+                if (piece.end_of_message)
+                    _complete_messages--;
+
+                _received.pop_front();
+                _read_pos = 0;
+            }
+        }
+
+        update_window(clock_type::now());
+        return total;
+    }
+
+    bool readable () const
+    {
+        return !_received.empty() || _peer_closed || _failure || _state == state::closed;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Background thread
+    ////////////////////////////////////////////////////////////////////////////
+    time_point next_deadline (time_point deadline) const
+    {
+        if (_rto_armed)
+            deadline = std::min(deadline, _rto_deadline);
+
+        if (_rack_armed)
+            deadline = std::min(deadline, _rack_deadline);
+
+        if (_tlp_armed)
+            deadline = std::min(deadline, _tlp_deadline);
+
+        if (!_delayed.empty())
+            deadline = std::min(deadline, _delayed.begin()->first);
+
+        return deadline;
+    }
+
+    // Timers armed by user thread may expire before waiting worker wakes up
+    void wake_worker ()
+    {
+        if (next_deadline(_worker_wakeup) < _worker_wakeup) {
+            _worker_wakeup = time_point::max();
+            platform::udp::signal_wakeup(& _wakeup_writer);
+        }
+    }
+
+    void run ()
+    {
+        // Granularity of timers and reaction to close()
+        auto const tick = std::chrono::milliseconds{20};
+
+        // Datagrams processed between acknowledgements
+        int const batch = 16;
+
+        std::vector<char> buf(64 * 1024);
+        host_address from;
+        std::unique_lock<std::mutex> locker(_mtx);
+
+        while (!_stopping && !_failure) {
+            auto now = clock_type::now();
+            auto deadline = next_deadline(now + tick);
+            _worker_wakeup = deadline;
+
+            auto timeout = deadline > now
+                ? std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - now + std::chrono::microseconds{999})
+                : std::chrono::milliseconds{0};
+
+            locker.unlock();
+            error_code ec;
+            bool ready = _socket.wait_for_read(timeout, & _wakeup_reader, ec);
+            locker.lock();
+            _worker_wakeup = time_point::max();
+
+            if (ec) {
+                fail(ec);
+                break;
+            }
+
+            now = clock_type::now();
+
+            for (int i = 0; ready && i < batch; i++) {
+                auto n = _socket.read_from(buf.data(), buf.size(), & from, ec);
+
+                if (n < 0) {
+                    fail(ec);
+                    break;
+                }
+
+                if (n == 0)
+                    break;
+
+                on_packet(from, buf.data(), static_cast<size_t>(n), now);
+            }
+
+            if (_failure)
+                break;
+
+            if (_rto_armed && now >= _rto_deadline)
+                on_timeout(now);
+
+            if (_rack_armed && now >= _rack_deadline)
+                detect_losses(now);
+
+            if (_tlp_armed && now >= _tlp_deadline)
+                send_tail_probe(now);
+
+            if (now - _last_received >= _options.idle_timeout)
+                fail(make_error_code(errc::timedout));
+
+            if (_failure)
+                break;
+
+            send_pending(now);
+
+            // Acknowledgement or keepalive
+            if (_ack_pending || now - _last_sent >= _options.idle_timeout / 3)
+                send_control(details::rudp::ack, now);
+
+            flush_delayed(now);
+            flush_outbox(locker);
+        }
+
+        flush_outbox(locker);
+    }
+
+    error_code start ()
+    {
+        auto ec = platform::udp::open_wakeup(& _wakeup_reader, & _wakeup_writer);
+
+        if (ec) {
+            fail(ec);
+            return ec;
+        }
+
+        _last_received = _last_sent = clock_type::now();
+        _worker_wakeup = time_point::max();
+        _worker = std::thread{& rudp_socket::run, this};
+        return error_code{};
+    }
+
+    // Client side of handshake
+    bool connect (error_code & ec)
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        _state = state::syn_sent;
+        _ordered = _options.ordered;
+
+        auto syn = make_packet(details::rudp::syn, _ordered ? 0 : details::rudp::unordered, 0);
+        auto deadline = clock_type::now() + _options.connect_timeout;
+        microseconds rto = _options.initial_rto;
+        std::vector<char> buf(64 * 1024);
+        host_address from;
+        bool first_attempt = true;
+
+        while (clock_type::now() < deadline) {
+            auto sent = clock_type::now();
+            transmit(syn, sent);
+            ec = flush_outbox(locker);
+
+            if (ec) {
+                _state = state::closed;
+                return false;
+            }
+
+            auto retry = std::min(deadline, sent + rto);
+
+            for (auto now = sent; now < retry; now = clock_type::now()) {
+                flush_delayed(now);
+                ec = flush_outbox(locker);
+
+                if (ec) {
+                    _state = state::closed;
+                    return false;
+                }
+
+                auto wakeup = _delayed.empty() ? retry : std::min(retry, _delayed.begin()->first);
+                auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    wakeup - now + std::chrono::microseconds{999});
+
+                if (!_socket.wait_for_read(timeout, ec)) {
+                    if (ec) {
+                        _state = state::closed;
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                auto n = _socket.read_from(buf.data(), buf.size(), & from, ec);
+
+                if (n < 0) {
+                    _state = state::closed;
+                    return false;
+                }
+
+                header h;
+
+                if (n > 0 && details::rudp::decode_header(buf.data(), static_cast<size_t>(n), h)
+                        && h.type == details::rudp::syn_ack && h.conn_id == _conn_id) {
+                    now = clock_type::now();
+
+                    if (first_attempt)
+                        update_rtt(std::chrono::duration_cast<microseconds>(now - sent));
+
+                    // Connection continues with the socket that answered
+                    _peer = from;
+                    _peer_window = h.window;
+                    _state = state::established;
+                    send_control(details::rudp::ack, now);
+                    flush_delayed(now);
+                    flush_outbox(locker);
+                    return true;
+                }
+            }
+
+            first_attempt = false;
+            rto = std::min<microseconds>(rto * 2, _options.max_rto);
+        }
+
+        _state = state::closed;
+        ec = make_error_code(errc::timedout);
+        return false;
+    }
+
+    // Server side of handshake
+    void accept (host_address const & peer, header const & syn)
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        auto now = clock_type::now();
+
+        _peer = peer;
+        _ordered = (syn.flags & details::rudp::unordered) == 0;
+        _peer_window = syn.window;
+        _state = state::syn_received;
+
+        send_control(details::rudp::syn_ack, now);
+        arm_rto(now);
+        flush_outbox(locker);
+    }
+
+public:
+    rudp_socket () : basic_device() {}
+    rudp_socket (rudp_socket const &) = delete;
+    rudp_socket & operator = (rudp_socket const &) = delete;
+
+    virtual ~rudp_socket ()
+    {
+        close();
+    }
+
+    virtual device_type type () const noexcept override
+    {
+        return device_type::rudp_socket;
+    }
+
+    virtual open_mode_flags open_mode () const noexcept override
+    {
+        if (!opened())
+            return not_open;
+
+        return _options.nonblocking ? read_write | non_blocking : read_write;
+    }
+
+    virtual bool has_pending_data () noexcept override
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        return !_received.empty();
+    }
+
+    /**
+     * Reads data of incoming messages as a byte stream.
+     *
+     * @return Number of bytes read, 0 if peer closed connection (or no data
+     *         in non-blocking mode), -1 on error.
+     */
+    virtual ssize_t read (char * bytes, size_t n, error_code & ec) noexcept override
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+
+        if (!_options.nonblocking)
+            _read_cv.wait(locker, [this] { return readable(); });
+
+        if (!_received.empty()) {
+            auto result = static_cast<ssize_t>(consume(bytes, n));
+            flush_outbox(locker);
+            return result;
+        }
+
+        if (_failure) {
+            ec = _failure;
+            return -1;
+        }
+
+        if (_state == state::closed) {
+            ec = make_error_code(errc::not_connected);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Sends @a n bytes as one message (fragmented if longer than
+     * rudp_options::max_payload in ordered mode).
+     *
+     * @return @a n, 0 if send window is full in non-blocking mode or -1 on
+     *         error: errc::message_size if message does not fit into
+     *         packet (unordered mode) or into send window,
+     *         errc::broken_pipe if peer closed connection.
+     */
+    virtual ssize_t write (char const * bytes, size_t n, error_code & ec) noexcept override
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        auto max_payload = _options.max_payload;
+        size_t chunks = n == 0 ? 1 : (n + max_payload - 1) / max_payload;
+
+        if ((!_ordered && chunks > 1) || chunks > _options.send_window) {
+            ec = make_error_code(errc::message_size);
+            return -1;
+        }
+
+        auto has_room = [this, chunks] {
+            return _send_queue.size() + _unacked.size() + chunks <= _options.send_window;
+        };
+
+        if (!_failure && !_stopping && !has_room()) {
+            if (_options.nonblocking)
+                return 0;
+
+            _write_cv.wait(locker, [this, & has_room] {
+                return has_room() || _failure || _stopping;
+            });
+        }
+
+        if (_failure) {
+            ec = _failure;
+            return -1;
+        }
+
+        if (_stopping || (_state != state::established && _state != state::syn_received)) {
+            ec = make_error_code(errc::not_connected);
+            return -1;
+        }
+
+        if (_peer_closed) {
+            ec = make_error_code(errc::broken_pipe);
+            return -1;
+        }
+
+        for (size_t i = 0; i < chunks; i++) {
+            auto offset = i * max_payload;
+            auto size = std::min(max_payload, n - offset);
+            enqueue(details::rudp::data, i + 1 == chunks ? details::rudp::end_of_message : 0
+                , bytes + offset, size);
+        }
+
+        send_pending(clock_type::now());
+        wake_worker();
+        flush_outbox(locker);
+        return static_cast<ssize_t>(n);
+    }
+
+    /**
+     * Reads next whole message.
+     *
+     * @return @c false if peer closed connection (@a ec is not set), on
+     *         error or if no complete message is available in non-blocking
+     *         mode.
+     */
+    bool read_message (std::string & message, error_code & ec)
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+
+        if (!_options.nonblocking) {
+            _read_cv.wait(locker, [this] {
+                return _complete_messages > 0 || _peer_closed || _failure
+                    || _state == state::closed;
+            });
+        }
+
+        if (_complete_messages > 0) {
+            message.clear();
+
+            for (;;) {
+                auto & piece = _received.front();
+                bool end_of_message = piece.end_of_message;
+
+                message.append(piece.data, _read_pos, std::string::npos);
+                _received.pop_front();
+                _read_pos = 0;
+
+                if (end_of_message)
+                    break;
+            }
+
+            _complete_messages--;
+            update_window(clock_type::now());
+            flush_outbox(locker);
+            return true;
+        }
+
+        if (_failure)
+            ec = _failure;
+        else if (_state == state::closed)
+            ec = make_error_code(errc::not_connected);
+
+        return false;
+    }
+
+    bool read_message (std::string & message)
+    {
+        error_code ec;
+        auto success = read_message(message, ec);
+        if (ec) throw exception(ec);
+        return success;
+    }
+
+    /**
+     * Closes connection. Waits until written data is acknowledged unless peer
+     * has already closed its side, gives up (and resets connection) when no
+     * data is acknowledged for rudp_options::linger.
+     */
+    virtual error_code close () override
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+
+        if (_state == state::closed)
+            return error_code{};
+
+        if (!_failure && !_stopping) {
+            // Peer that has closed its side does not read any more
+            bool fin_sent = !_peer_closed;
+
+            if (fin_sent) {
+                enqueue(details::rudp::fin, 0, nullptr, 0);
+                send_pending(clock_type::now());
+                wake_worker();
+            }
+
+            auto acknowledged = _snd_una;
+            auto progress = clock_type::now();
+
+            while (!_failure) {
+                auto now = clock_type::now();
+
+                if (fin_sent && _unacked.empty() && _send_queue.empty()) {
+                    // Peer has got everything, releases its side
+                    send_datagram(make_packet(details::rudp::rst, 0, 0));
+                    break;
+                }
+
+                if (_peer_closed) {
+                    // Stay while peer retransmits (our acknowledgement may
+                    // be lost) until it releases connection
+                    auto quiet = std::min<microseconds>(_options.linger, 8 * current_rto());
+
+                    if (_peer_released || now - _last_received >= quiet)
+                        break;
+                } else if (_snd_una != acknowledged) {
+                    acknowledged = _snd_una;
+                    progress = now;
+                } else if (now - progress >= _options.linger) {
+                    // No progress, peer learns that the rest is not delivered
+                    send_datagram(make_packet(details::rudp::rst, 0, 0));
+                    break;
+                }
+
+                flush_outbox(locker);
+                _write_cv.wait_for(locker, std::chrono::milliseconds{5});
+            }
+
+            flush_outbox(locker);
+        }
+
+        _stopping = true;
+        locker.unlock();
+
+        if (_worker.joinable()) {
+            platform::udp::signal_wakeup(& _wakeup_writer);
+            _worker.join();
+        }
+
+        platform::udp::close(& _wakeup_reader, false);
+        platform::udp::close(& _wakeup_writer, false);
+
+        locker.lock();
+        _state = state::closed;
+        _read_cv.notify_all();
+        _write_cv.notify_all();
+        locker.unlock();
+
+        return _socket.close();
+    }
+
+    virtual bool opened () const noexcept override
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        return _state != state::closed;
+    }
+
+    /**
+     * @return @c true if messages are delivered in order they were sent.
+     */
+    bool ordered () const noexcept
+    {
+        return _ordered;
+    }
+
+    rudp_stats stats () const
+    {
+        std::unique_lock<std::mutex> locker(_mtx);
+        auto result = _stats;
+        result.srtt = _srtt;
+        result.rto = current_rto();
+        result.cwnd = _cwnd;
+        return result;
+    }
+
+    friend device make_rudp_socket (std::string const & servername
+            , uint16_t port
+            , rudp_options const & options
+            , error_code & ec);
+
+    friend class rudp_server;
+};
+
+/**
+ * Connects to RUDP server.
+ */
+inline device make_rudp_socket (std::string const & servername
+        , uint16_t port
+        , rudp_options const & options
+        , error_code & ec)
+{
+    auto s = make_static_udp_socket(servername, port, true, ec);
+
+    if (ec)
+        return device{};
+
+    std::random_device random;
+    std::unique_ptr<rudp_socket> d {new rudp_socket(std::move(s.underlying())
+        , options, static_cast<std::uint32_t>(random()))};
+
+    if (!d->connect(ec))
+        return device{};
+
+    ec = d->start();
+
+    if (ec) {
+        d->close();
+        return device{};
+    }
+
+    return device{d.release()};
+}
+
+/**
+ * Connects to RUDP server.
+ */
+inline device make_rudp_socket (std::string const & servername
+        , uint16_t port
+        , rudp_options const & options = rudp_options{})
+{
+    error_code ec;
+    auto d = make_rudp_socket(servername, port, options, ec);
+    if (ec) throw exception(ec);
+    return d;
+}
+
+/**
+ * @brief Accepts RUDP connections.
+ */
+class rudp_server
+{
+    std::string _servername;
+    rudp_options _options;
+    udp_server _socket;
+
+    // Recently accepted connections, retransmitted SYNs are ignored
+    std::map<std::string, rudp_socket::clock_type::time_point> _accepted;
+
+public:
+    rudp_server () {}
+
+    rudp_server (std::string const & servername
+            , rudp_options const & options
+            , udp_server && s)
+        : _servername(servername)
+        , _options(options)
+        , _socket(std::move(s))
+    {}
+
+    rudp_server (rudp_server &&) = default;
+    rudp_server & operator = (rudp_server &&) = default;
+
+    /**
+     * Waits up to @a timeout for incoming connection.
+     *
+     * @return Connection or null device on timeout or error.
+     */
+    device accept (std::chrono::milliseconds timeout, error_code & ec)
+    {
+        using clock_type = rudp_socket::clock_type;
+
+        auto deadline = clock_type::now() + timeout;
+        std::vector<char> buf(64 * 1024);
+        udp_socket::host_address from;
+
+        for (auto now = clock_type::now(); now < deadline; now = clock_type::now()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - now + std::chrono::microseconds{999});
+
+            if (!_socket.wait_for_read(remaining, ec)) {
+                if (ec)
+                    return device{};
+
+                continue;
+            }
+
+            auto n = _socket.read_from(buf.data(), buf.size(), & from, ec);
+
+            if (n < 0)
+                return device{};
+
+            details::rudp::header h;
+
+            if (n == 0 || !details::rudp::decode_header(buf.data(), static_cast<size_t>(n), h)
+                    || h.type != details::rudp::syn) {
+                continue;
+            }
+
+            for (auto pos = _accepted.begin(); pos != _accepted.end();) {
+                if (pos->second + 2 * _options.connect_timeout < now)
+                    pos = _accepted.erase(pos);
+                else
+                    ++pos;
+            }
+
+            auto key = std::string(reinterpret_cast<char const *>(& from.addr), sizeof(from.addr))
+                + std::to_string(h.conn_id);
+
+            if (!_accepted.emplace(key, now).second)
+                continue;
+
+            auto s = make_udp_server(_servername, 0, true, ec);
+
+            if (ec)
+                return device{};
+
+            std::unique_ptr<rudp_socket> d {new rudp_socket(std::move(s), _options, h.conn_id)};
+            d->accept(from, h);
+            ec = d->start();
+
+            if (ec) {
+                d->close();
+                return device{};
+            }
+
+            return device{d.release()};
+        }
+
+        return device{};
+    }
+
+    device accept (std::chrono::milliseconds timeout)
+    {
+        error_code ec;
+        auto d = accept(timeout, ec);
+        if (ec) throw exception(ec);
+        return d;
+    }
+
+    /**
+     * Waits for incoming connection.
+     */
+    device accept (error_code & ec)
+    {
+        device d;
+
+        while (d.is_null() && !ec)
+            d = accept(std::chrono::milliseconds{1000}, ec);
+
+        return d;
+    }
+
+    device accept ()
+    {
+        error_code ec;
+        auto d = accept(ec);
+        if (ec) throw exception(ec);
+        return d;
+    }
+
+    error_code close ()
+    {
+        return _socket.close();
+    }
+};
+
+/**
+ * Makes RUDP server listening on @a servername and @a port.
+ */
+inline rudp_server make_rudp_server (std::string const & servername
+        , uint16_t port
+        , rudp_options const & options
+        , error_code & ec)
+{
+    auto s = make_udp_server(servername, port, true, ec);
+    return ec ? rudp_server{} : rudp_server{servername, options, std::move(s)};
+}
+
+inline rudp_server make_rudp_server (std::string const & servername
+        , uint16_t port
+        , rudp_options const & options = rudp_options{})
+{
+    error_code ec;
+    auto s = make_rudp_server(servername, port, options, ec);
+    if (ec) throw exception(ec);
+    return s;
+}
+
+}} // pfs::io
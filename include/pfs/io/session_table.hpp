@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "udp_socket.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace pfs {
+namespace io {
+
+/**
+ * @brief Per-peer session state of datagram server with idle expiry.
+ *
+ * Open addressing hash table with linear probing: sessions are stored in one
+ * array (no allocation per peer), probes compare cached hashes before keys,
+ * erased slots are filled by backward shift (no tombstones).
+ *
+ * @tparam Session Default constructible and movable session state.
+ * @tparam Key Peer address (udp_socket::host_address by default).
+ */
+template <typename Session
+    , typename Key = udp_socket::host_address
+    , typename Hash = std::hash<Key>
+    , typename KeyEqual = std::equal_to<Key>>
+class session_table
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+private:
+    struct slot
+    {
+        std::uint32_t hash {0}; // zero for empty slot
+        Key key;
+        time_point last_seen;
+        Session session;
+    };
+
+    std::vector<slot> _slots;
+    std::size_t _size {0};
+    std::size_t _mask {0};
+    std::size_t _cursor {0}; // position of incremental expiry
+    clock_type::duration _idle_timeout;
+    Hash _hash;
+    KeyEqual _equal;
+
+private:
+    std::uint32_t hash_of (Key const & key) const
+    {
+        auto h = static_cast<std::uint64_t>(_hash(key));
+        auto result = static_cast<std::uint32_t>(h ^ (h >> 32));
+        return result == 0 ? 1 : result;
+    }
+
+    std::size_t find_slot (Key const & key, std::uint32_t h) const
+    {
+        if (_slots.empty())
+            return npos;
+
+        for (auto i = h & _mask;; i = (i + 1) & _mask) {
+            auto const & s = _slots[i];
+
+            if (s.hash == 0)
+                return npos;
+
+            if (s.hash == h && _equal(s.key, key))
+                return i;
+        }
+    }
+
+    void rehash (std::size_t capacity)
+    {
+        std::vector<slot> slots(capacity);
+        slots.swap(_slots);
+        _mask = capacity - 1;
+        _cursor = 0;
+
+        for (auto & s: slots) {
+            if (s.hash == 0)
+                continue;
+
+            auto i = s.hash & _mask;
+
+            while (_slots[i].hash != 0)
+                i = (i + 1) & _mask;
+
+            _slots[i] = std::move(s);
+        }
+    }
+
+    // Backward shift deletion keeps probe sequences unbroken
+    void erase_slot (std::size_t i)
+    {
+        auto j = i;
+
+        for (;;) {
+            j = (j + 1) & _mask;
+
+            if (_slots[j].hash == 0)
+                break;
+
+            auto home = _slots[j].hash & _mask;
+
+            // Element at j stays if its home is cyclically in (i, j]
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+                continue;
+
+            _slots[i] = std::move(_slots[j]);
+            i = j;
+        }
+
+        _slots[i] = slot{};
+        _size--;
+    }
+
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    /**
+     * Sessions idle longer than @a idle_timeout are removed by expire().
+     */
+    explicit session_table (clock_type::duration idle_timeout
+            , std::size_t capacity = 0
+            , Hash const & hash = Hash{}
+            , KeyEqual const & equal = KeyEqual{})
+        : _idle_timeout(idle_timeout)
+        , _hash(hash)
+        , _equal(equal)
+    {
+        if (capacity > 0)
+            reserve(capacity);
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * Number of slots, grows to keep load factor under 3/4.
+     */
+    std::size_t capacity () const noexcept
+    {
+        return _slots.size();
+    }
+
+    /**
+     * Prepares table for @a n sessions without rehashing.
+     */
+    void reserve (std::size_t n)
+    {
+        std::size_t capacity = 16;
+
+        while (capacity * 3 < n * 4)
+            capacity *= 2;
+
+        if (capacity > _slots.size())
+            rehash(capacity);
+    }
+
+    /**
+     * @return Session of @a peer or @c nullptr.
+     */
+    Session * find (Key const & peer)
+    {
+        auto i = find_slot(peer, hash_of(peer));
+        return i == npos ? nullptr : & _slots[i].session;
+    }
+
+    Session const * find (Key const & peer) const
+    {
+        auto i = find_slot(peer, hash_of(peer));
+        return i == npos ? nullptr : & _slots[i].session;
+    }
+
+    /**
+     * Returns session of @a peer creating it if absent and marks it active
+     * at @a now. Pointers to sessions are invalidated by insertion and
+     * removal.
+     *
+     * @return Session and @c true if it was created.
+     */
+    std::pair<Session *, bool> touch (Key const & peer, time_point now)
+    {
+        auto h = hash_of(peer);
+        auto i = find_slot(peer, h);
+
+        if (i != npos) {
+            _slots[i].last_seen = now;
+            return std::make_pair(& _slots[i].session, false);
+        }
+
+        if ((_size + 1) * 4 > _slots.size() * 3)
+            rehash(_slots.empty() ? 16 : _slots.size() * 2);
+
+        i = h & _mask;
+
+        while (_slots[i].hash != 0)
+            i = (i + 1) & _mask;
+
+        auto & s = _slots[i];
+        s.hash = h;
+        s.key = peer;
+        s.last_seen = now;
+        _size++;
+
+        return std::make_pair(& s.session, true);
+    }
+
+    std::pair<Session *, bool> touch (Key const & peer)
+    {
+        return touch(peer, clock_type::now());
+    }
+
+    bool erase (Key const & peer)
+    {
+        auto i = find_slot(peer, hash_of(peer));
+
+        if (i == npos)
+            return false;
+
+        erase_slot(i);
+        return true;
+    }
+
+    void clear ()
+    {
+        _slots.clear();
+        _size = 0;
+        _mask = 0;
+        _cursor = 0;
+    }
+
+    /**
+     * Removes sessions idle since before @a now - idle_timeout, examining at
+     * most @a max_slots occupied or empty slots from the position where the
+     * previous call stopped (expiry of a large table can be spread over
+     * several calls). @a on_expire is called as
+     * on_expire(Key const &, Session &) before removal.
+     *
+     * @return Number of removed sessions.
+     */
+    template <typename F>
+    std::size_t expire (time_point now, std::size_t max_slots, F && on_expire)
+    {
+        std::size_t removed = 0;
+        auto count = std::min(max_slots, _slots.size());
+
+        // Cursor does not move after removal, so count only moves
+        for (std::size_t n = 0; n < count;) {
+            auto & s = _slots[_cursor];
+
+            if (s.hash != 0 && now - s.last_seen > _idle_timeout) {
+                on_expire(static_cast<Key const &>(s.key), s.session);
+
+                // Next element may be shifted to the cursor
+                erase_slot(_cursor);
+                removed++;
+                continue;
+            }
+
+            _cursor = (_cursor + 1) & _mask;
+            n++;
+        }
+
+        return removed;
+    }
+
+    std::size_t expire (time_point now)
+    {
+        return expire(now, _slots.size(), [] (Key const &, Session &) {});
+    }
+
+    /**
+     * Calls @a f as f(Key const &, Session &) for every session.
+     */
+    template <typename F>
+    void for_each (F && f)
+    {
+        for (auto & s: _slots) {
+            if (s.hash != 0)
+                f(static_cast<Key const &>(s.key), s.session);
+        }
+    }
+};
+
+template <typename Session, typename Key, typename Hash, typename KeyEqual>
+constexpr std::size_t session_table<Session, Key, Hash, KeyEqual>::npos;
+
+}} // pfs::io
@@ -6,6 +6,7 @@
 // Changelog:
 //      2019.10.09 Initial version
 //      2019.10.18 Refactored supporting platform-agnostic implementation
+//      2026.10.18 Added tcp_peer default constructor (for underlying_device())
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "tcp_socket.hpp"
@@ -38,6 +39,7 @@ protected:
     {}
 
 public:
+    tcp_peer () : tcp_socket() {}
     tcp_peer (tcp_peer const & rhs) = delete;
     tcp_peer & operator = (tcp_peer const & rhs) = delete;
 
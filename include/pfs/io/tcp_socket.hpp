@@ -6,6 +6,11 @@
 // Changelog:
 //      2019.10.09 Initial version
 //      2019.10.16 Refactored supporting platform-agnostic implementation
+//      2026.10.18 Added make_static_tcp_socket()
+//      2026.10.18 Added writev()
+//      2026.10.18 Added shutdown()
+//      2026.10.18 Added set_max_pacing_rate()
+//      2026.10.18 Added packet timestamping
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "operationsystem.h"
@@ -31,8 +36,14 @@ namespace tcp {
     using unix_ns::tcp::close;
     using unix_ns::tcp::read;
     using unix_ns::tcp::write;
+    using unix_ns::tcp::writev;
+    using unix_ns::tcp::shutdown;
     using unix_ns::tcp::has_pending_data;
     using unix_ns::tcp::enable_keep_alive;
+    using unix_ns::tcp::set_max_pacing_rate;
+    using unix_ns::tcp::set_timestamping;
+    using unix_ns::tcp::read_timestamped;
+    using unix_ns::tcp::read_tx_timestamp;
     using unix_ns::swap;
 #endif
 
@@ -96,6 +107,15 @@ public:
         return platform::tcp::close(& _h, true);
     }
 
+    /**
+     * Shuts down connection keeping socket open, threads blocked in read()
+     * return end of stream.
+     */
+    error_code shutdown ()
+    {
+        return platform::tcp::shutdown(& _h);
+    }
+
     virtual bool opened () const noexcept override
     {
         return platform::tcp::opened(& _h);
@@ -111,6 +131,11 @@ public:
         return platform::tcp::write(& _h, bytes, n, ec);
     }
 
+    virtual ssize_t writev (io_vector const * iov, int iovcnt, error_code & ec) noexcept override
+    {
+        return platform::tcp::writev(& _h, iov, iovcnt, ec);
+    }
+
     void swap (tcp_socket & rhs)
     {
         using platform::tcp::swap;
@@ -122,10 +147,57 @@ public:
         return platform::tcp::enable_keep_alive(& _h, enable);
     }
 
+    /**
+     * Limits sending rate to @a rate bytes per second (zero removes the
+     * limit) by TCP internal pacing.
+     */
+    error_code set_max_pacing_rate (std::uint64_t rate)
+    {
+        return platform::tcp::set_max_pacing_rate(& _h, rate);
+    }
+
+    /**
+     * Enables timestamps of received data (read() with timestamps) and (or)
+     * sent data (read_tx_timestamp()), zero @a flags disable them.
+     */
+    error_code enable_timestamping (timestamping_flags flags = rx_software_timestamp
+            | tx_software_timestamp)
+    {
+        return platform::tcp::set_timestamping(& _h, flags);
+    }
+
+    /**
+     * Reads data and receive timestamps of the last segment read (zero if
+     * not taken).
+     */
+    ssize_t read (char * bytes, size_t n, packet_timestamps & ts, error_code & ec) noexcept
+    {
+        return platform::tcp::read_timestamped(& _h, nullptr, bytes, n, & ts, ec);
+    }
+
+    /**
+     * Reads transmit timestamps of sent data, @a id is the offset of the last
+     * byte of the write counting from zero since timestamping was enabled.
+     *
+     * @return @c false if no timestamp is pending or on error.
+     */
+    bool read_tx_timestamp (std::uint32_t & id
+            , packet_timestamps & ts
+            , error_code & ec) noexcept
+    {
+        return platform::tcp::read_tx_timestamp(& _h, & id, & ts, ec);
+    }
+
     friend device make_tcp_socket (std::string const & servername
             , uint16_t port
             , bool nonblocking
             , error_code & ec);
+
+    friend static_device<tcp_socket> make_static_tcp_socket (
+              std::string const & servername
+            , uint16_t port
+            , bool nonblocking
+            , error_code & ec);
 };
 
 /**
@@ -157,4 +229,37 @@ inline device make_tcp_socket (std::string const & servername
     return d;
 }
 
+/**
+ * Makes statically typed TCP socket.
+ */
+inline static_device<tcp_socket> make_static_tcp_socket (
+          std::string const & servername
+        , uint16_t port
+        , bool nonblocking
+        , error_code & ec)
+{
+    tcp_socket::device_handle h = platform::tcp::open(servername
+            , port
+            , nonblocking
+            , ec);
+    return ec
+            ? static_device<tcp_socket>{}
+            : static_device<tcp_socket>{tcp_socket(std::move(h))};
+}
+
+/**
+ * Makes statically typed TCP socket.
+ */
+inline static_device<tcp_socket> make_static_tcp_socket (
+          std::string const & servername
+        , uint16_t port
+        , bool nonblocking)
+{
+    error_code ec;
+    auto d = make_static_tcp_socket(servername, port, nonblocking, ec);
+    if (ec)
+        throw exception(ec);
+    return d;
+}
+
 }} // pfs::io
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2019.10.14 Initial version
+//      2026.10.18 Added packet info (replies from destination address)
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "udp_socket.hpp"
@@ -16,7 +17,9 @@ namespace platform {
 namespace udp {
 
 #if defined(PFS_OS_LINUX)
+    using packet_info = unix_ns::packet_info;
     using unix_ns::udp::open_server;
+    using unix_ns::udp::set_packet_info;
     using unix_ns::swap;
 #endif
 
@@ -27,6 +30,7 @@ class udp_server : public udp_socket
 public:
     using device_handle = platform::udp::device_handle;
     using host_address = platform::udp::host_address;
+    using packet_info = platform::udp::packet_info;
 
 protected:
     udp_server (device_handle && h)
@@ -53,6 +57,46 @@ public:
 
     virtual ~udp_server () {}
 
+    /**
+     * Enables reporting of destination address and interface of received
+     * datagrams by read_from(). Server bound to wildcard address replies
+     * from the address the request was sent to, so a single socket serves
+     * all addresses of a multi-homed host.
+     */
+    error_code enable_packet_info (bool enable = true)
+    {
+        return platform::udp::set_packet_info(& _h, enable);
+    }
+
+    using udp_socket::read_from;
+    using udp_socket::write_to;
+
+    /**
+     * Reads datagram, sender is stored to @a *paddr, its destination address
+     * and interface to @a *pinfo (see enable_packet_info()).
+     */
+    ssize_t read_from (char * bytes
+            , size_t n
+            , host_address * paddr
+            , packet_info * pinfo
+            , error_code & ec) noexcept
+    {
+        return platform::udp::read(& _h, paddr, pinfo, bytes, n, ec);
+    }
+
+    /**
+     * Sends datagram to @a *paddr from local address of @a *pinfo (as
+     * returned by read_from()).
+     */
+    ssize_t write_to (char const * bytes
+            , size_t n
+            , host_address const * paddr
+            , packet_info const * pinfo
+            , error_code & ec) noexcept
+    {
+        return platform::udp::write(& _h, paddr, pinfo, bytes, n, ec);
+    }
+
     friend udp_server make_udp_server (std::string const & servername
             , uint16_t port
             , bool nonblocking
@@ -5,10 +5,24 @@
 //
 // Changelog:
 //      2019.10.14 Initial version
+//      2026.10.18 Added make_static_udp_socket()
+//      2026.10.18 Added writev()
+//      2026.10.18 Added multicast membership and options
+//      2026.10.18 Added enable_broadcast()
+//      2026.10.18 Added wait_for_read() and address()
+//      2026.10.18 Added segmentation offload (write_segments(), read_segments())
+//      2026.10.18 Added connected mode
+//      2026.10.18 Added pacing (set_max_pacing_rate(), write_at())
+//      2026.10.18 Added packet timestamping
+//      2026.10.19 read() keeps address(), added connect(host_address)
+//      2026.10.19 read_segments() keeps address()
+//      2026.10.19 Timestamped read() keeps address(), added timestamped read_from()
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "operationsystem.h"
 #include "device.hpp"
+#include <chrono>
+#include <utility>
 
 #if defined(PFS_OS_LINUX)
 #   include "unix_socket.hpp"
@@ -31,7 +45,28 @@ namespace udp {
     using unix_ns::udp::close;
     using unix_ns::udp::read;
     using unix_ns::udp::write;
+    using unix_ns::udp::writev;
+    using unix_ns::udp::write_segments;
+    using unix_ns::udp::read_segments;
+    using unix_ns::udp::set_gro;
+    using unix_ns::udp::set_max_pacing_rate;
+    using unix_ns::udp::set_txtime;
+    using unix_ns::udp::writev_at;
+    using unix_ns::udp::set_timestamping;
+    using unix_ns::udp::read_timestamped;
+    using unix_ns::udp::read_tx_timestamp;
+    using unix_ns::udp::connect;
+    using unix_ns::udp::disconnect;
     using unix_ns::udp::has_pending_data;
+    using unix_ns::udp::wait_for_read;
+    using unix_ns::udp::open_wakeup;
+    using unix_ns::udp::signal_wakeup;
+    using unix_ns::udp::set_broadcast;
+    using unix_ns::udp::join_group;
+    using unix_ns::udp::leave_group;
+    using unix_ns::udp::set_multicast_interface;
+    using unix_ns::udp::set_multicast_ttl;
+    using unix_ns::udp::set_multicast_loop;
     using unix_ns::swap;
 #endif
 
@@ -46,6 +81,8 @@ public:
 protected:
     device_handle _h;
     host_address  _addr;
+    bool _gso {true}; // segmentation offload is not known to be unsupported
+    bool _connected {false};
 
 protected:
     udp_socket (device_handle && h, host_address && addr)
@@ -107,14 +144,74 @@ public:
             , size_t n
             , error_code & ec) noexcept override
     {
-        return platform::udp::read(& _h, & _addr, bytes, n, ec);
+        // Sender is not needed (see read_from()), address() stays intact
+        return platform::udp::read(& _h, nullptr, bytes, n, ec);
     }
 
     virtual ssize_t write (char const * bytes
             , size_t n
             , error_code & ec) noexcept override
     {
-        return platform::udp::write(& _h, & _addr, bytes, n, ec);
+        return platform::udp::write(& _h, _connected ? nullptr : & _addr, bytes, n, ec);
+    }
+
+    /**
+     * Sends buffers as a single datagram.
+     */
+    virtual ssize_t writev (io_vector const * iov
+            , int iovcnt
+            , error_code & ec) noexcept override
+    {
+        return platform::udp::writev(& _h, _connected ? nullptr : & _addr, iov, iovcnt, ec);
+    }
+
+    /**
+     * @return Destination address of write(): server address for client
+     *         socket or address given to connect().
+     */
+    host_address const & address () const noexcept
+    {
+        return _addr;
+    }
+
+    /**
+     * Connects socket to address(). Then read() and write() skip
+     * per-datagram address handling, datagrams from other senders are
+     * dropped by the kernel and ICMP errors are reported (e.g.
+     * errc::connection_refused if nobody listens).
+     */
+    error_code connect ()
+    {
+        auto ec = platform::udp::connect(& _h, & _addr);
+        _connected = !ec;
+        return ec;
+    }
+
+    /**
+     * Connects socket to @a addr (e.g. sender reported by read_from() for
+     * server), @a addr becomes address().
+     */
+    error_code connect (host_address const & addr)
+    {
+        _addr = addr;
+        return connect();
+    }
+
+    /**
+     * Restores unconnected mode.
+     */
+    error_code disconnect ()
+    {
+        if (!_connected)
+            return error_code{};
+
+        _connected = false;
+        return platform::udp::disconnect(& _h);
+    }
+
+    bool connected () const noexcept
+    {
+        return _connected;
     }
 
     ssize_t read_from (char * bytes
@@ -133,17 +230,279 @@ public:
         return platform::udp::write(& _h, paddr, bytes, n, ec);
     }
 
+    /**
+     * Sends @a n bytes to address() as datagrams of @a segment_size bytes
+     * (the last one may be shorter). With UDP generic segmentation offload
+     * one system call passes up to 64 datagrams to the kernel, without it
+     * datagrams are sent one by one.
+     *
+     * @return @a n or -1 on error.
+     */
+    ssize_t write_segments (char const * bytes
+            , size_t n
+            , size_t segment_size
+            , error_code & ec) noexcept
+    {
+        return platform::udp::write_segments(& _h, _connected ? nullptr : & _addr
+            , bytes, n, segment_size, & _gso, ec);
+    }
+
+    ssize_t write_segments_to (char const * bytes
+            , size_t n
+            , size_t segment_size
+            , host_address const * paddr
+            , error_code & ec) noexcept
+    {
+        return platform::udp::write_segments(& _h, paddr, bytes, n, segment_size, & _gso, ec);
+    }
+
+    /**
+     * @return @c false if write_segments() falls back to one system call per
+     *         datagram.
+     */
+    bool segmentation_offload () const noexcept
+    {
+        return _gso;
+    }
+
+    /**
+     * Enables UDP generic receive offload: read_segments() may return
+     * several datagrams from the same sender at once (buffer should hold
+     * 64 KiB).
+     */
+    error_code enable_receive_offload (bool enable = true)
+    {
+        return platform::udp::set_gro(& _h, enable);
+    }
+
+    /**
+     * Reads datagram or several coalesced datagrams. Datagrams are
+     * @a segment_size bytes long except the last one.
+     *
+     * @return Number of bytes read, 0 if no datagram is available
+     *         (non-blocking socket) or -1 on error.
+     */
+    ssize_t read_segments (char * bytes
+            , size_t n
+            , size_t & segment_size
+            , error_code & ec) noexcept
+    {
+        // Sender is not needed (see read_segments_from()), address() stays intact
+        return platform::udp::read_segments(& _h, nullptr, bytes, n, & segment_size, ec);
+    }
+
+    ssize_t read_segments_from (char * bytes
+            , size_t n
+            , size_t & segment_size
+            , host_address * paddr
+            , error_code & ec) noexcept
+    {
+        return platform::udp::read_segments(& _h, paddr, bytes, n, & segment_size, ec);
+    }
+
+    /**
+     * Limits rate of outgoing datagrams to @a rate bytes per second (zero
+     * removes the limit). Enforced by fq queueing discipline only.
+     */
+    error_code set_max_pacing_rate (std::uint64_t rate)
+    {
+        return platform::udp::set_max_pacing_rate(& _h, rate);
+    }
+
+    /**
+     * Enables departure times of write_at() and writev_at() (can not be
+     * disabled). They are honored by fq queueing discipline, other ones send
+     * datagrams immediately.
+     */
+    error_code enable_txtime ()
+    {
+        return platform::udp::set_txtime(& _h);
+    }
+
+    /**
+     * Sends datagram to address() that leaves the host not earlier than
+     * @a departure (see enable_txtime()).
+     */
+    ssize_t write_at (char const * bytes
+            , size_t n
+            , std::chrono::steady_clock::time_point departure
+            , error_code & ec) noexcept
+    {
+        io_vector iov;
+        iov.iov_base = const_cast<char *>(bytes);
+        iov.iov_len = n;
+        return writev_at(& iov, 1, departure, ec);
+    }
+
+    ssize_t writev_at (io_vector const * iov
+            , int iovcnt
+            , std::chrono::steady_clock::time_point departure
+            , error_code & ec) noexcept
+    {
+        auto txtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            departure.time_since_epoch()).count();
+
+        return platform::udp::writev_at(& _h, _connected ? nullptr : & _addr
+            , iov, iovcnt, static_cast<std::uint64_t>(txtime), ec);
+    }
+
+    /**
+     * Enables timestamps of received datagrams (read() with timestamps)
+     * and (or) sent ones (read_tx_timestamp()), zero @a flags disable them.
+     */
+    error_code enable_timestamping (timestamping_flags flags = rx_software_timestamp
+            | tx_software_timestamp)
+    {
+        return platform::udp::set_timestamping(& _h, flags);
+    }
+
+    /**
+     * Reads datagram and its receive timestamps (zero if not taken).
+     */
+    ssize_t read (char * bytes
+            , size_t n
+            , packet_timestamps & ts
+            , error_code & ec) noexcept
+    {
+        // Sender is not needed (see read_from()), address() stays intact
+        return platform::udp::read_timestamped(& _h, nullptr, bytes, n, & ts, ec);
+    }
+
+    /**
+     * Reads datagram, its sender and receive timestamps (zero if not taken).
+     */
+    ssize_t read_from (char * bytes
+            , size_t n
+            , host_address * paddr
+            , packet_timestamps & ts
+            , error_code & ec) noexcept
+    {
+        return platform::udp::read_timestamped(& _h, paddr, bytes, n, & ts, ec);
+    }
+
+    /**
+     * Reads transmit timestamps of a sent datagram, @a id is the number of
+     * the datagram counting from zero since timestamping was enabled.
+     *
+     * @return @c false if no timestamp is pending or on error.
+     */
+    bool read_tx_timestamp (std::uint32_t & id
+            , packet_timestamps & ts
+            , error_code & ec) noexcept
+    {
+        return platform::udp::read_tx_timestamp(& _h, & id, & ts, ec);
+    }
+
+    /**
+     * Waits up to @a timeout for incoming datagram.
+     *
+     * @return @c true if datagram can be read without blocking.
+     */
+    bool wait_for_read (std::chrono::milliseconds timeout, error_code & ec) noexcept
+    {
+        return platform::udp::wait_for_read(& _h, static_cast<int>(timeout.count()), ec);
+    }
+
+    /**
+     * Waits up to @a timeout for incoming datagram or for
+     * platform::udp::signal_wakeup() on the pipe @a wakeup reads (see
+     * platform::udp::open_wakeup()).
+     */
+    bool wait_for_read (std::chrono::milliseconds timeout
+            , device_handle * wakeup
+            , error_code & ec) noexcept
+    {
+        return platform::udp::wait_for_read(& _h, wakeup, static_cast<int>(timeout.count()), ec);
+    }
+
+    /**
+     * Allows sending to broadcast addresses (writes fail with
+     * errc::permission_denied otherwise).
+     */
+    error_code enable_broadcast (bool enable = true)
+    {
+        return platform::udp::set_broadcast(& _h, enable);
+    }
+
+    /**
+     * Joins multicast @a group (numeric IPv4 or IPv6 address) on interface
+     * @a iface (e.g. "eth0"), interface is chosen by routing table if empty.
+     */
+    error_code join_group (std::string const & group
+            , std::string const & iface = std::string{})
+    {
+        return platform::udp::join_group(& _h, group, std::string{}, iface);
+    }
+
+    error_code leave_group (std::string const & group
+            , std::string const & iface = std::string{})
+    {
+        return platform::udp::leave_group(& _h, group, std::string{}, iface);
+    }
+
+    /**
+     * Joins source-specific multicast @a group: only datagrams sent by
+     * @a source are received.
+     */
+    error_code join_source_group (std::string const & group
+            , std::string const & source
+            , std::string const & iface = std::string{})
+    {
+        return platform::udp::join_group(& _h, group, source, iface);
+    }
+
+    error_code leave_source_group (std::string const & group
+            , std::string const & source
+            , std::string const & iface = std::string{})
+    {
+        return platform::udp::leave_group(& _h, group, source, iface);
+    }
+
+    /**
+     * Selects interface for outgoing multicast datagrams.
+     */
+    error_code set_multicast_interface (std::string const & iface)
+    {
+        return platform::udp::set_multicast_interface(& _h, iface);
+    }
+
+    /**
+     * Sets TTL (hop limit for IPv6) of outgoing multicast datagrams,
+     * default is 1 (local network only).
+     */
+    error_code set_multicast_ttl (int ttl)
+    {
+        return platform::udp::set_multicast_ttl(& _h, ttl);
+    }
+
+    /**
+     * Enables (default) or disables delivery of own multicast datagrams to
+     * sockets on this host.
+     */
+    error_code set_multicast_loop (bool enable)
+    {
+        return platform::udp::set_multicast_loop(& _h, enable);
+    }
+
     void swap (udp_socket & rhs)
     {
         using platform::udp::swap;
         swap(_h, rhs._h);
         swap(_addr, rhs._addr);
+        std::swap(_gso, rhs._gso);
+        std::swap(_connected, rhs._connected);
     }
 
     friend device make_udp_socket (std::string const & servername
             , uint16_t port
             , bool nonblocking
             , error_code & ec);
+
+    friend static_device<udp_socket> make_static_udp_socket (
+              std::string const & servername
+            , uint16_t port
+            , bool nonblocking
+            , error_code & ec);
 };
 
 /**
@@ -177,5 +536,40 @@ inline device make_udp_socket (std::string const & servername
     return d;
 }
 
+/**
+ * Makes statically typed UDP socket.
+ */
+inline static_device<udp_socket> make_static_udp_socket (
+          std::string const & servername
+        , uint16_t port
+        , bool nonblocking
+        , error_code & ec)
+{
+    udp_socket::host_address addr;
+    udp_socket::device_handle h = platform::udp::open(servername
+            , port
+            , nonblocking
+            , & addr
+            , ec);
+    return ec
+            ? static_device<udp_socket>{}
+            : static_device<udp_socket>{udp_socket(std::move(h), std::move(addr))};
+}
+
+/**
+ * Makes statically typed UDP socket.
+ */
+inline static_device<udp_socket> make_static_udp_socket (
+          std::string const & servername
+        , uint16_t port
+        , bool nonblocking)
+{
+    error_code ec;
+    auto d = make_static_udp_socket(servername, port, nonblocking, ec);
+    if (ec)
+        throw exception(ec);
+    return d;
+}
+
 }} // pfs::io
 
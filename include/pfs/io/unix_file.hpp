@@ -5,14 +5,41 @@
 //
 // Changelog:
 //      2019.10.15 Initial version
+//      2026.10.18 Added positional I/O (read_at/write_at) and seek/tell
+//      2026.10.18 Added durability policy and sync()
+//      2026.10.18 Added direct I/O support
+//      2026.10.18 Added preallocation, hole punching and sparse file support
+//      2026.10.18 Added access advice and readahead
+//      2026.10.18 Added in-kernel copy primitives (reflink, copy_file_range, sendfile)
+//      2026.10.18 Added directory helpers
+//      2026.10.18 Added vectored write (writev)
+//      2026.10.18 Added read-only memory mapping
+//      2026.10.18 Direct I/O tails go through a separate buffered descriptor
+//      2026.10.18 Added is_same_file()
+//      2026.10.19 Sequential direct I/O realigns file position
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "device.hpp"
 #include "permissions.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
 #include <utility>
+#include <vector>
+#include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <linux/falloc.h>
+#include <linux/fs.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+
+#ifndef FICLONE
+#   define FICLONE _IOW(0x94, 9, int)
+#endif
 
 namespace pfs {
 namespace io {
@@ -91,6 +118,9 @@ inline open_mode_flags open_mode (device_handle const * h) noexcept
     if (status & O_NONBLOCK || status & O_NDELAY)
         result |= non_blocking;
 
+    if (status & O_DIRECT)
+        result |= direct;
+
     return result;
 }
 
@@ -121,6 +151,9 @@ inline device_handle open (std::string const & path
     if (oflags & truncate)
         native_oflags |= O_TRUNC;
 
+    if (oflags & direct)
+        native_oflags |= O_DIRECT;
+
     int fd = -1;
 
     if (native_mode)
@@ -135,13 +168,37 @@ inline device_handle open (std::string const & path
     return device_handle{};
 }
 
-inline error_code close (device_handle * h)
+////////////////////////////////////////////////////////////////////////////////
+// Flush file data according to durability policy
+////////////////////////////////////////////////////////////////////////////////
+inline error_code sync (device_handle * h, durability policy)
+{
+    int rc = 0;
+
+    switch (policy) {
+        case durability::none:
+            break;
+        case durability::data_sync:
+            rc = ::fdatasync(h->fd);
+            break;
+        case durability::full_sync:
+            rc = ::fsync(h->fd);
+            break;
+        case durability::writeback:
+            rc = ::sync_file_range(h->fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+            break;
+    }
+
+    return rc != 0 ? get_last_system_error() : error_code{};
+}
+
+inline error_code close (device_handle * h
+        , durability policy = durability::full_sync)
 {
     error_code ec;
 
     if (h->fd > 0) {
-        if (fsync(h->fd) != 0)
-            ec = get_last_system_error();
+        ec = sync(h, policy);
 
         if (::close(h->fd) < 0)
             ec = get_last_system_error();
@@ -182,6 +239,562 @@ inline ssize_t write (device_handle * h
     return sz;
 }
 
+inline ssize_t writev (device_handle * h
+        , io_vector const * iov
+        , int iovcnt
+        , error_code & ec) noexcept
+{
+    ssize_t sz = ::writev(h->fd, iov, iovcnt);
+
+    if (sz < 0)
+        ec = get_last_system_error();
+
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Positional I/O. Does not use or change the file position, so it can be
+// called concurrently from several threads on the same descriptor.
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t read_at (device_handle * h
+        , char * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    ssize_t sz = ::pread(h->fd, bytes, n, static_cast<off_t>(offset));
+
+    if (sz < 0)
+        ec = get_last_system_error();
+
+    return sz;
+}
+
+inline ssize_t write_at (device_handle * h
+        , char const * bytes
+        , size_t n
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    ssize_t sz = ::pwrite(h->fd, bytes, n, static_cast<off_t>(offset));
+
+    if (sz < 0)
+        ec = get_last_system_error();
+
+    return sz;
+}
+
+inline ssize_t read_at (device_handle * h
+        , io_vector const * iov
+        , int iovcnt
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    ssize_t sz = ::preadv(h->fd, iov, iovcnt, static_cast<off_t>(offset));
+
+    if (sz < 0)
+        ec = get_last_system_error();
+
+    return sz;
+}
+
+inline ssize_t write_at (device_handle * h
+        , io_vector const * iov
+        , int iovcnt
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    ssize_t sz = ::pwritev(h->fd, iov, iovcnt, static_cast<off_t>(offset));
+
+    if (sz < 0)
+        ec = get_last_system_error();
+
+    return sz;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Set file position. Returns resulting offset or -1 on error.
+////////////////////////////////////////////////////////////////////////////////
+inline offset_type seek (device_handle * h
+        , offset_type offset
+        , seek_origin origin
+        , error_code & ec) noexcept
+{
+    int whence = SEEK_SET;
+
+    switch (origin) {
+        case seek_origin::begin  : whence = SEEK_SET; break;
+        case seek_origin::current: whence = SEEK_CUR; break;
+        case seek_origin::end    : whence = SEEK_END; break;
+    }
+
+    off_t pos = ::lseek(h->fd, static_cast<off_t>(offset), whence);
+
+    if (pos < 0)
+        ec = get_last_system_error();
+
+    return static_cast<offset_type>(pos);
+}
+
+inline offset_type tell (device_handle * h, error_code & ec) noexcept
+{
+    return seek(h, 0, seek_origin::current, ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// File size
+////////////////////////////////////////////////////////////////////////////////
+inline offset_type size (device_handle const * h, error_code & ec) noexcept
+{
+    struct stat st;
+
+    if (::fstat(h->fd, & st) != 0) {
+        ec = get_last_system_error();
+        return -1;
+    }
+
+    return static_cast<offset_type>(st.st_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Set file size
+////////////////////////////////////////////////////////////////////////////////
+inline error_code resize (device_handle * h, offset_type size) noexcept
+{
+    int rc = ::ftruncate(h->fd, static_cast<off_t>(size));
+    return rc != 0 ? get_last_system_error() : error_code{};
+}
+
+/**
+ * Checks if @a path (symbolic links resolved) refers to the same file as
+ * @a h (the same device and inode, so hard links are detected too).
+ *
+ * @return @c false if @a path does not exist.
+ */
+inline bool is_same_file (device_handle const * h, std::string const & path) noexcept
+{
+    struct stat hst, pst;
+
+    return ::fstat(h->fd, & hst) == 0
+        && ::stat(path.c_str(), & pst) == 0
+        && hst.st_dev == pst.st_dev
+        && hst.st_ino == pst.st_ino;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Share all extents of source file with destination file (copy-on-write
+// clone). Supported by Btrfs, XFS (with reflink=1) and some other file systems.
+////////////////////////////////////////////////////////////////////////////////
+inline error_code clone (device_handle const * src, device_handle * dest) noexcept
+{
+    int rc = ::ioctl(dest->fd, FICLONE, src->fd);
+    return rc != 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy range inside the kernel. Does not change file positions.
+// Returns number of bytes copied (zero at end of source file) or -1 on error.
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t copy_range (device_handle const * src
+        , offset_type src_offset
+        , device_handle * dest
+        , offset_type dest_offset
+        , size_t len
+        , error_code & ec) noexcept
+{
+#if defined(__NR_copy_file_range)
+    loff_t in = static_cast<loff_t>(src_offset);
+    loff_t out = static_cast<loff_t>(dest_offset);
+
+    // Called through syscall() since glibc wrapper is available since 2.27 only
+    ssize_t rc = ::syscall(__NR_copy_file_range, src->fd, & in, dest->fd, & out
+        , len, 0u);
+#else
+    ssize_t rc = -1;
+    errno = ENOSYS;
+#endif
+
+    if (rc < 0)
+        ec = get_last_system_error();
+
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy range using sendfile(). Writes to the current position of destination.
+// Returns number of bytes copied or -1 on error.
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t send_range (device_handle const * src
+        , offset_type src_offset
+        , device_handle * dest
+        , size_t len
+        , error_code & ec) noexcept
+{
+    off_t offset = static_cast<off_t>(src_offset);
+    ssize_t rc = ::sendfile(dest->fd, src->fd, & offset, len);
+
+    if (rc < 0)
+        ec = get_last_system_error();
+
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Space allocation
+////////////////////////////////////////////////////////////////////////////////
+inline error_code fallocate (device_handle * h
+        , int mode
+        , offset_type offset
+        , offset_type len) noexcept
+{
+    int rc = ::fallocate(h->fd, mode, static_cast<off_t>(offset), static_cast<off_t>(len));
+    return rc != 0 ? get_last_system_error() : error_code{};
+}
+
+inline error_code allocate (device_handle * h
+        , offset_type offset
+        , offset_type len
+        , bool keep_size) noexcept
+{
+    return fallocate(h, keep_size ? FALLOC_FL_KEEP_SIZE : 0, offset, len);
+}
+
+inline error_code punch_hole (device_handle * h
+        , offset_type offset
+        , offset_type len) noexcept
+{
+    return fallocate(h, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, len);
+}
+
+inline error_code zero_range (device_handle * h
+        , offset_type offset
+        , offset_type len
+        , bool keep_size) noexcept
+{
+    return fallocate(h
+        , FALLOC_FL_ZERO_RANGE | (keep_size ? FALLOC_FL_KEEP_SIZE : 0)
+        , offset
+        , len);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sparse files. Returns offset of the next data (hole) region starting at or
+// after offset, or -1 if there is no such region (ec is not set in that case)
+// or on error. End of file is considered as a hole. Changes file position.
+////////////////////////////////////////////////////////////////////////////////
+inline offset_type seek_region (device_handle * h
+        , offset_type offset
+        , int whence
+        , error_code & ec) noexcept
+{
+    off_t pos = ::lseek(h->fd, static_cast<off_t>(offset), whence);
+
+    if (pos < 0 && errno != ENXIO)
+        ec = get_last_system_error();
+
+    return pos < 0 ? -1 : static_cast<offset_type>(pos);
+}
+
+inline offset_type next_data (device_handle * h
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    return seek_region(h, offset, SEEK_DATA, ec);
+}
+
+inline offset_type next_hole (device_handle * h
+        , offset_type offset
+        , error_code & ec) noexcept
+{
+    return seek_region(h, offset, SEEK_HOLE, ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Access advice. Zero len means up to the end of file.
+////////////////////////////////////////////////////////////////////////////////
+inline error_code advise (device_handle * h
+        , offset_type offset
+        , offset_type len
+        , access_advice advice) noexcept
+{
+    int native_advice = POSIX_FADV_NORMAL;
+
+    switch (advice) {
+        case access_advice::normal    : native_advice = POSIX_FADV_NORMAL; break;
+        case access_advice::sequential: native_advice = POSIX_FADV_SEQUENTIAL; break;
+        case access_advice::random    : native_advice = POSIX_FADV_RANDOM; break;
+        case access_advice::willneed  : native_advice = POSIX_FADV_WILLNEED; break;
+        case access_advice::dontneed  : native_advice = POSIX_FADV_DONTNEED; break;
+        case access_advice::noreuse   : native_advice = POSIX_FADV_NOREUSE; break;
+    }
+
+    // NOTE posix_fadvise() returns error number instead of setting errno
+    int rc = ::posix_fadvise(h->fd, static_cast<off_t>(offset)
+        , static_cast<off_t>(len), native_advice);
+
+    return rc != 0 ? make_error_code_from_errno(rc) : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Initiate reading of the range into page cache without waiting
+////////////////////////////////////////////////////////////////////////////////
+inline error_code prefetch (device_handle * h
+        , offset_type offset
+        , size_t len) noexcept
+{
+    ssize_t rc = ::readahead(h->fd, static_cast<off64_t>(offset), len);
+    return rc != 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Read-only memory mapping. Returns nullptr on error.
+////////////////////////////////////////////////////////////////////////////////
+inline char const * map_view (device_handle const * h
+        , offset_type offset
+        , size_t len
+        , access_advice advice
+        , error_code & ec) noexcept
+{
+    void * addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, h->fd
+        , static_cast<off_t>(offset));
+
+    if (addr == MAP_FAILED) {
+        ec = get_last_system_error();
+        return nullptr;
+    }
+
+    int native_advice = MADV_NORMAL;
+
+    switch (advice) {
+        case access_advice::sequential: native_advice = MADV_SEQUENTIAL; break;
+        case access_advice::random    : native_advice = MADV_RANDOM; break;
+        case access_advice::willneed  : native_advice = MADV_WILLNEED; break;
+        case access_advice::dontneed  : native_advice = MADV_DONTNEED; break;
+        default: break;
+    }
+
+    // Advice is a hint, failure is not an error
+    if (native_advice != MADV_NORMAL)
+        ::madvise(addr, len, native_advice);
+
+    return static_cast<char const *>(addr);
+}
+
+inline error_code unmap_view (char const * addr, size_t len) noexcept
+{
+    return ::munmap(const_cast<char *>(addr), len) != 0
+        ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Direct I/O
+////////////////////////////////////////////////////////////////////////////////
+inline bool is_direct (device_handle const * h) noexcept
+{
+    int status = ::fcntl(h->fd, F_GETFL);
+    return status >= 0 && (status & O_DIRECT);
+}
+
+/**
+ * Opens one more descriptor of the same file (the same inode, not the same
+ * path) without O_DIRECT flag. It is used for unaligned parts of direct I/O
+ * transfers, so flags of the direct descriptor are never changed.
+ */
+inline device_handle reopen_buffered (device_handle const * h, error_code & ec) noexcept
+{
+    device_handle result;
+    int status = ::fcntl(h->fd, F_GETFL);
+
+    if (status < 0) {
+        ec = get_last_system_error();
+        return result;
+    }
+
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/self/fd/%d", h->fd);
+
+    result.fd = ::open(path, (status & (O_ACCMODE | O_APPEND)) | O_CLOEXEC);
+
+    if (result.fd < 0)
+        ec = get_last_system_error();
+
+    return result;
+}
+
+/**
+ * Returns alignment required for buffer addresses, offsets and lengths in
+ * direct I/O mode: reported by filesystem (STATX_DIOALIGN), logical sector
+ * size for block devices, preferred I/O block size (but not less than 4096,
+ * so 4Kn devices are served) for regular files or 512 for other files.
+ * If file status is not available 4096 is returned.
+ */
+inline size_t direct_io_alignment (device_handle const * h) noexcept
+{
+#if defined(STATX_DIOALIGN)
+    struct statx stx;
+
+    if (::statx(h->fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, & stx) == 0
+            && (stx.stx_mask & STATX_DIOALIGN)
+            && stx.stx_dio_offset_align > 0) {
+        return std::max(static_cast<size_t>(stx.stx_dio_offset_align)
+            , static_cast<size_t>(stx.stx_dio_mem_align));
+    }
+#endif
+
+    struct stat st;
+
+    if (::fstat(h->fd, & st) != 0)
+        return 4096;
+
+    if (S_ISBLK(st.st_mode)) {
+        int sector_size = 0;
+
+        if (::ioctl(h->fd, BLKSSZGET, & sector_size) == 0 && sector_size > 0)
+            return static_cast<size_t>(sector_size);
+    }
+
+    if (S_ISREG(st.st_mode))
+        return std::max(static_cast<size_t>(st.st_blksize), size_t{4096});
+
+    return 512;
+}
+
+inline bool is_aligned (void const * p, size_t alignment) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+/**
+ * Transfers data in direct I/O mode. The aligned part of @a n bytes is
+ * transferred through @a h bypassing page cache, unaligned parts are
+ * transferred through @a buffered descriptor (see reopen_buffered()).
+ *
+ * Buffer address and explicit @a offset must be aligned. Transfer at current
+ * file position (@a offset is negative) is split into unaligned head up to
+ * the alignment boundary, aligned middle and unaligned tail, so the file
+ * position is realigned and the following transfers go through @a h again.
+ * If buffer is unaligned relative to the file position all data is
+ * transferred through page cache.
+ *
+ * @param offset Negative value means current file position.
+ * @return Number of bytes transferred or -1 on error. If some part fails
+ *         after previous ones succeeded, their byte count is returned and
+ *         @a ec is not set (the error is reported by the next call).
+ */
+template <typename Byte, typename TransferAt>
+ssize_t transfer_direct (device_handle * h
+        , device_handle * buffered
+        , Byte * bytes
+        , size_t n
+        , offset_type offset
+        , size_t alignment
+        , error_code & ec
+        , TransferAt && transfer_at) noexcept
+{
+    bool sequential = offset < 0;
+
+    if (sequential) {
+        offset = ::lseek(h->fd, 0, SEEK_CUR);
+
+        if (offset < 0) {
+            ec = get_last_system_error();
+            return -1;
+        }
+    }
+
+    size_t head = 0;
+
+    if (sequential) {
+        auto misalignment = static_cast<size_t>(offset) % alignment;
+        head = misalignment == 0 ? 0 : std::min(n, alignment - misalignment);
+
+        if (!is_aligned(bytes + head, alignment))
+            head = n;
+    } else if (!is_aligned(bytes, alignment)
+            || static_cast<size_t>(offset) % alignment != 0) {
+        ec = make_error_code(errc::invalid_argument);
+        return -1;
+    }
+
+    size_t middle = (n - head) - (n - head) % alignment;
+
+    struct part
+    {
+        device_handle * h;
+        size_t n;
+    } parts[] = {
+          {buffered, head}
+        , {h, middle}
+        , {buffered, n - head - middle}
+    };
+
+    ssize_t total = 0;
+
+    for (auto const & p: parts) {
+        if (p.n == 0)
+            continue;
+
+        ssize_t sz = -1;
+
+        if (p.h->fd < 0) {
+            ec = make_error_code(errc::operation_not_supported);
+        } else {
+            sz = transfer_at(p.h, bytes + total, p.n
+                , offset + static_cast<offset_type>(total), ec);
+        }
+
+        if (sz < 0) {
+            if (total == 0)
+                return -1;
+
+            ec.clear();
+            break;
+        }
+
+        total += sz;
+
+        // End of file
+        if (static_cast<size_t>(sz) < p.n)
+            break;
+    }
+
+    if (sequential && total > 0
+            && ::lseek(h->fd, offset + static_cast<offset_type>(total), SEEK_SET) < 0) {
+        ec = get_last_system_error();
+        return -1;
+    }
+
+    return total;
+}
+
+inline ssize_t read_direct (device_handle * h
+        , device_handle * buffered
+        , char * bytes
+        , size_t n
+        , offset_type offset
+        , size_t alignment
+        , error_code & ec) noexcept
+{
+    return transfer_direct(h, buffered, bytes, n, offset, alignment, ec
+        , [] (device_handle * h, char * b, size_t n, offset_type off, error_code & ec) {
+            return read_at(h, b, n, off, ec);
+        });
+}
+
+inline ssize_t write_direct (device_handle * h
+        , device_handle * buffered
+        , char const * bytes
+        , size_t n
+        , offset_type offset
+        , size_t alignment
+        , error_code & ec) noexcept
+{
+    return transfer_direct(h, buffered, bytes, n, offset, alignment, ec
+        , [] (device_handle * h, char const * b, size_t n, offset_type off, error_code & ec) {
+            return write_at(h, b, n, off, ec);
+        });
+}
+
 inline bool has_pending_data (device_handle * h)
 {
     int n = 0;
@@ -189,4 +802,59 @@ inline bool has_pending_data (device_handle * h)
     return rc == 0 ? n > 0 : false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Directory helpers
+////////////////////////////////////////////////////////////////////////////////
+inline error_code make_directory (std::string const & path, permissions perms)
+{
+    int rc = ::mkdir(path.c_str(), to_native_perms(perms));
+    return rc != 0 && errno != EEXIST ? get_last_system_error() : error_code{};
+}
+
+/**
+ * Lists directory entries except "." and "..".
+ */
+inline error_code list_directory (std::string const & path
+        , std::vector<std::string> & names)
+{
+    DIR * dir = ::opendir(path.c_str());
+
+    if (!dir)
+        return get_last_system_error();
+
+    errno = 0;
+
+    while (dirent * entry = ::readdir(dir)) {
+        std::string name {entry->d_name};
+
+        if (name != "." && name != "..")
+            names.push_back(std::move(name));
+    }
+
+    error_code ec = errno != 0 ? get_last_system_error() : error_code{};
+    ::closedir(dir);
+    return ec;
+}
+
+/**
+ * Flushes directory entries, required to make file creation, removal or
+ * renaming durable.
+ */
+inline error_code sync_directory (std::string const & path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY);
+
+    if (fd < 0)
+        return get_last_system_error();
+
+    error_code ec = ::fsync(fd) != 0 ? get_last_system_error() : error_code{};
+    ::close(fd);
+    return ec;
+}
+
+inline error_code remove_file (std::string const & path)
+{
+    return ::unlink(path.c_str()) != 0 ? get_last_system_error() : error_code{};
+}
+
 }}}} // pfs::io::unix_ns::file
@@ -5,15 +5,35 @@
 //
 // Changelog:
 //      2019.10.16 Initial version
+//      2026.10.18 Added vectored write (writev)
+//      2026.10.18 Added shutdown()
+//      2026.10.18 Added multicast membership and options
+//      2026.10.18 Added broadcast enablement
+//      2026.10.18 Added wait_for_read() and wakeup pipe
+//      2026.10.18 Added UDP segmentation offload (UDP_SEGMENT / UDP_GRO)
+//      2026.10.18 Added connected UDP mode
+//      2026.10.18 Added packet info (IP_PKTINFO / IPV6_RECVPKTINFO)
+//      2026.10.18 Added host_address comparison, hashing and formatting
+//      2026.10.18 Added pacing (SO_MAX_PACING_RATE / SO_TXTIME)
+//      2026.10.18 Added packet timestamping (SO_TIMESTAMPING / SO_TIMESTAMPNS)
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "unix_file.hpp"
+#include <functional>
+#include <string>
 #include <vector>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <ctime>
 #include <arpa/inet.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <netdb.h>
+#include <net/if.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -36,6 +56,16 @@ struct host_address
     }
 };
 
+/**
+ * Local end of datagram: destination address of received datagram (source
+ * address of reply) and interface index.
+ */
+struct packet_info
+{
+    host_address local; // port is not set
+    unsigned interface {0};
+};
+
 inline void swap (host_address & a, host_address & b)
 {
     host_address tmp;
@@ -45,12 +75,119 @@ inline void swap (host_address & a, host_address & b)
     std::memcpy(& b.addr, & tmp.addr, addlen);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Host address comparison, hashing and formatting. Address is identified by
+// family, IP address, port and (IPv6) scope, other fields (e.g. flow label)
+// are ignored.
+////////////////////////////////////////////////////////////////////////////////
+inline int compare (host_address const & a, host_address const & b) noexcept
+{
+    auto family = a.addr.addr4.sin_family;
+
+    if (family != b.addr.addr4.sin_family)
+        return family < b.addr.addr4.sin_family ? -1 : 1;
+
+    int rc = 0;
+
+    if (family == AF_INET6) {
+        rc = std::memcmp(& a.addr.addr6.sin6_addr, & b.addr.addr6.sin6_addr
+            , sizeof(a.addr.addr6.sin6_addr));
+
+        if (rc == 0 && a.addr.addr6.sin6_scope_id != b.addr.addr6.sin6_scope_id)
+            rc = a.addr.addr6.sin6_scope_id < b.addr.addr6.sin6_scope_id ? -1 : 1;
+    } else {
+        auto x = ntohl(a.addr.addr4.sin_addr.s_addr);
+        auto y = ntohl(b.addr.addr4.sin_addr.s_addr);
+        rc = x == y ? 0 : x < y ? -1 : 1;
+    }
+
+    if (rc == 0) {
+        // Port has the same offset in both families
+        auto x = ntohs(a.addr.addr4.sin_port);
+        auto y = ntohs(b.addr.addr4.sin_port);
+        rc = x == y ? 0 : x < y ? -1 : 1;
+    }
+
+    return rc;
+}
+
+inline bool operator == (host_address const & a, host_address const & b) noexcept
+{
+    return compare(a, b) == 0;
+}
+
+inline bool operator != (host_address const & a, host_address const & b) noexcept
+{
+    return compare(a, b) != 0;
+}
+
+inline bool operator < (host_address const & a, host_address const & b) noexcept
+{
+    return compare(a, b) < 0;
+}
+
+inline std::size_t hash_value (host_address const & a) noexcept
+{
+    std::uint64_t h = static_cast<std::uint64_t>(a.addr.addr4.sin_family) << 16
+        | a.addr.addr4.sin_port;
+
+    if (a.addr.addr6.sin6_family == AF_INET6) {
+        std::uint64_t words[2];
+        std::memcpy(words, & a.addr.addr6.sin6_addr, sizeof(words));
+        h ^= words[0] * 0x9E3779B97F4A7C15ULL;
+        h ^= (words[1] + a.addr.addr6.sin6_scope_id) * 0xC2B2AE3D27D4EB4FULL;
+    } else {
+        h ^= static_cast<std::uint64_t>(a.addr.addr4.sin_addr.s_addr) << 24;
+    }
+
+    // Finalizer of MurmurHash3
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+
+    return static_cast<std::size_t>(h);
+}
+
+/**
+ * Formats address as "192.0.2.1:53", "[2001:db8::1]:53" or "[fe80::1%eth0]:53".
+ */
+inline std::string to_string (host_address const & a)
+{
+    char buf[INET6_ADDRSTRLEN + IF_NAMESIZE + 16];
+    auto family = a.addr.addr4.sin_family;
+
+    if (family == AF_INET) {
+        inet_ntop(AF_INET, & a.addr.addr4.sin_addr, buf, sizeof(buf));
+        return std::string{buf} + ':' + std::to_string(ntohs(a.addr.addr4.sin_port));
+    }
+
+    if (family == AF_INET6) {
+        inet_ntop(AF_INET6, & a.addr.addr6.sin6_addr, buf, sizeof(buf));
+        std::string result {"["};
+        result += buf;
+
+        if (a.addr.addr6.sin6_scope_id != 0) {
+            char name[IF_NAMESIZE];
+            result += '%';
+            result += if_indextoname(a.addr.addr6.sin6_scope_id, name)
+                ? std::string{name}
+                : std::to_string(a.addr.addr6.sin6_scope_id);
+        }
+
+        return result + "]:" + std::to_string(ntohs(a.addr.addr6.sin6_port));
+    }
+
+    return std::string{};
+}
+
 namespace socket {
 
 inline bool has_pending_data (device_handle * h)
 {
     char buf[1];
-    ssize_t n = recvfrom(h->fd, buf, 1, MSG_PEEK, nullptr, nullptr);
+    ssize_t n = recvfrom(h->fd, buf, 1, MSG_PEEK | MSG_DONTWAIT, nullptr, nullptr);
     return n > 0;
 }
 
@@ -64,9 +201,7 @@ inline ssize_t read (device_handle * h
 {
     ssize_t rc = recv(h->fd, bytes, n, 0);
 
-    if (rc < 0
-            && errno == EAGAIN
-            || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+    if (rc < 0 && (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK)))
         rc = 0;
 
     if (rc < 0)
@@ -111,6 +246,53 @@ inline ssize_t write (device_handle * h
     return total_written;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Gather write to stream socket (writes all data like write())
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t writev (device_handle * h
+        , io_vector const * iov
+        , int iovcnt
+        , error_code & ec) noexcept
+{
+    std::vector<io_vector> rest(iov, iov + iovcnt);
+    io_vector * first = rest.data();
+    io_vector * last = rest.data() + rest.size();
+    ssize_t total_written = 0;
+
+    while (first != last) {
+        msghdr msg;
+        std::memset(& msg, 0, sizeof(msg));
+        msg.msg_iov = first;
+        msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(last - first);
+
+        ssize_t written = sendmsg(h->fd, & msg, MSG_NOSIGNAL);
+
+        if (written < 0) {
+            if (errno == EAGAIN
+                    || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+                continue;
+
+            ec = get_last_system_error();
+            return -1;
+        }
+
+        total_written += written;
+
+        // Skip completely written buffers and adjust partially written one
+        while (first != last && static_cast<size_t>(written) >= first->iov_len) {
+            written -= first->iov_len;
+            ++first;
+        }
+
+        if (first != last) {
+            first->iov_base = static_cast<char *>(first->iov_base) + written;
+            first->iov_len -= written;
+        }
+    }
+
+    return total_written;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Close socket
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,7 +302,7 @@ inline error_code close (device_handle * h, bool force_shutdown)
 
     if (h->fd > 0) {
         if (force_shutdown)
-            shutdown(h->fd, SHUT_RDWR);
+            ::shutdown(h->fd, SHUT_RDWR);
 
         if (::close(h->fd) < 0)
             ec = get_last_system_error();
@@ -130,6 +312,268 @@ inline error_code close (device_handle * h, bool force_shutdown)
     return ec;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Shut down both directions without closing descriptor (wakes up threads
+// blocked in read)
+////////////////////////////////////////////////////////////////////////////////
+inline error_code shutdown (device_handle * h)
+{
+    return ::shutdown(h->fd, SHUT_RDWR) != 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Wait for incoming data (timeout_ms < 0 waits infinitely). Wait is also
+// interrupted by signal_wakeup() for the pipe that @a wakeup reads.
+////////////////////////////////////////////////////////////////////////////////
+inline bool wait_for_read (device_handle * h
+        , device_handle * wakeup
+        , int timeout_ms
+        , error_code & ec)
+{
+    pollfd pfd[2];
+    pfd[0].fd = h->fd;
+    pfd[0].events = POLLIN;
+    pfd[0].revents = 0;
+
+    // Negative descriptor is ignored by poll()
+    pfd[1].fd = wakeup ? wakeup->fd : -1;
+    pfd[1].events = POLLIN;
+    pfd[1].revents = 0;
+
+    int rc = ::poll(pfd, 2, timeout_ms);
+
+    if (rc < 0) {
+        // Interrupted wait is reported as timeout
+        if (errno != EINTR)
+            ec = get_last_system_error();
+
+        return false;
+    }
+
+    if (pfd[1].revents & POLLIN) {
+        char buf[64];
+
+        while (::read(wakeup->fd, buf, sizeof(buf)) > 0)
+            ;
+    }
+
+    return (pfd[0].revents & (POLLIN | POLLERR)) != 0;
+}
+
+inline bool wait_for_read (device_handle * h, int timeout_ms, error_code & ec)
+{
+    return wait_for_read(h, nullptr, timeout_ms, ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Open pipe for interrupting wait_for_read()
+////////////////////////////////////////////////////////////////////////////////
+inline error_code open_wakeup (device_handle * reader, device_handle * writer)
+{
+    int fds[2];
+
+    if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0)
+        return get_last_system_error();
+
+    reader->fd = fds[0];
+    writer->fd = fds[1];
+    return error_code{};
+}
+
+inline void signal_wakeup (device_handle * writer)
+{
+    char c = 0;
+
+    // Pipe is full only if wakeup is pending already
+    ssize_t rc = ::write(writer->fd, & c, 1);
+    (void)rc;
+}
+
+/**
+ * Limits rate of outgoing data to @a rate bytes per second (zero removes the
+ * limit). Enforced by TCP internal pacing and by fq queueing discipline.
+ */
+inline error_code set_max_pacing_rate (device_handle * h, std::uint64_t rate)
+{
+#if defined(SO_MAX_PACING_RATE)
+    std::uint64_t value = rate == 0 ? ~std::uint64_t{0} : rate;
+    int rc = setsockopt(h->fd, SOL_SOCKET, SO_MAX_PACING_RATE, & value, sizeof(value));
+
+    // Kernels before 5.0 accept 32-bit value only
+    if (rc < 0 && errno == EINVAL) {
+        std::uint32_t value32 = value > 0xFFFFFFFFu
+            ? 0xFFFFFFFFu
+            : static_cast<std::uint32_t>(value);
+        rc = setsockopt(h->fd, SOL_SOCKET, SO_MAX_PACING_RATE, & value32, sizeof(value32));
+    }
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+#else
+    (void)h;
+    return rate != 0 ? make_error_code(errc::operation_not_supported) : error_code{};
+#endif
+}
+
+/**
+ * Enables packet timestamps (see timestamping_enum), zero @a flags disable
+ * them. Hardware timestamps also require timestamping enabled on the
+ * network adapter (SIOCSHWTSTAMP). Software receive timestamps fall back to
+ * SO_TIMESTAMPNS if SO_TIMESTAMPING is not supported. Kernel starts taking
+ * receive timestamps asynchronously, packets received shortly after the
+ * first socket enabled them may have none.
+ */
+inline error_code set_timestamping (device_handle * h, timestamping_flags flags)
+{
+    unsigned value = 0;
+
+    if (flags & rx_software_timestamp)
+        value |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+    if (flags & tx_software_timestamp)
+        value |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+    if (flags & rx_hardware_timestamp)
+        value |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+
+    if (flags & tx_hardware_timestamp)
+        value |= SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+
+    // Transmit timestamps are identified by counter (datagrams) or byte
+    // offset (streams) and returned without packet copy
+    if (flags & (tx_software_timestamp | tx_hardware_timestamp))
+        value |= SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+
+    int rc = setsockopt(h->fd, SOL_SOCKET, SO_TIMESTAMPING, & value, sizeof(value));
+
+    if (rc < 0 && (flags == rx_software_timestamp || flags == 0)) {
+        int enable = flags != 0 ? 1 : 0;
+        rc = setsockopt(h->fd, SOL_SOCKET, SO_TIMESTAMPNS, & enable, sizeof(enable));
+    }
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+// Control buffer for timestamps and extended error of error queue
+union timestamping_control
+{
+    char buf[CMSG_SPACE(sizeof(scm_timestamping))
+        + CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    cmsghdr align;
+};
+
+inline std::chrono::nanoseconds to_nanoseconds (timespec const & ts) noexcept
+{
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+// Extracts timestamps and (for error queue) transmit timestamp identifier
+inline void parse_timestamps (msghdr * msg, packet_timestamps * ts, std::uint32_t * id)
+{
+    for (auto cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            scm_timestamping value;
+            std::memcpy(& value, CMSG_DATA(cmsg), sizeof(value));
+            ts->software = to_nanoseconds(value.ts[0]);
+            ts->hardware = to_nanoseconds(value.ts[2]);
+        } else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec value;
+            std::memcpy(& value, CMSG_DATA(cmsg), sizeof(value));
+            ts->software = to_nanoseconds(value);
+        } else if (id != nullptr
+                && ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+                    || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))) {
+            sock_extended_err err;
+            std::memcpy(& err, CMSG_DATA(cmsg), sizeof(err));
+
+            if (err.ee_origin == SO_EE_ORIGIN_TIMESTAMPING)
+                *id = err.ee_data;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Read with receive timestamps (sender address is stored in *paddr if not
+// null)
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t read_timestamped (device_handle * h
+        , host_address * paddr
+        , char * bytes
+        , size_t n
+        , packet_timestamps * ts
+        , error_code & ec) noexcept
+{
+    iovec iov;
+    iov.iov_base = bytes;
+    iov.iov_len = n;
+
+    timestamping_control control;
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+
+    if (paddr) {
+        msg.msg_name = & paddr->addr;
+        msg.msg_namelen = sizeof(paddr->addr);
+    }
+
+    msg.msg_iov = & iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    *ts = packet_timestamps{};
+    ssize_t rc = recvmsg(h->fd, & msg, 0);
+
+    if (rc < 0 && (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK)))
+        return 0;
+
+    if (rc < 0) {
+        ec = get_last_system_error();
+        return rc;
+    }
+
+    parse_timestamps(& msg, ts, nullptr);
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Read transmit timestamp from error queue (never blocks). Identifier is
+// the number of datagram counting from zero since timestamping was enabled
+// (for stream socket: offset of the last byte of the write).
+////////////////////////////////////////////////////////////////////////////////
+inline bool read_tx_timestamp (device_handle * h
+        , std::uint32_t * id
+        , packet_timestamps * ts
+        , error_code & ec) noexcept
+{
+    char data[1];
+    iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = sizeof(data);
+
+    timestamping_control control;
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+    msg.msg_iov = & iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    *ts = packet_timestamps{};
+    ssize_t rc = recvmsg(h->fd, & msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+
+    if (rc < 0) {
+        if (errno != EAGAIN && (EAGAIN == EWOULDBLOCK || errno != EWOULDBLOCK))
+            ec = get_last_system_error();
+
+        return false;
+    }
+
+    parse_timestamps(& msg, ts, id);
+    return true;
+}
+
 } // socket
 
 namespace local {
@@ -139,6 +583,8 @@ using file::opened;
 using socket::close;
 using socket::read;
 using socket::write;
+using socket::writev;
+using socket::shutdown;
 using socket::has_pending_data;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -398,7 +844,13 @@ using file::opened;
 using socket::close;
 using socket::read;
 using socket::write;
+using socket::writev;
+using socket::shutdown;
 using socket::has_pending_data;
+using socket::set_max_pacing_rate;
+using socket::set_timestamping;
+using socket::read_timestamped;
+using socket::read_tx_timestamp;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Open TCP socket
@@ -519,6 +971,13 @@ using file::open_mode;
 using file::opened;
 using socket::close;
 using socket::has_pending_data;
+using socket::wait_for_read;
+using socket::open_wakeup;
+using socket::signal_wakeup;
+using socket::set_max_pacing_rate;
+using socket::set_timestamping;
+using socket::read_timestamped;
+using socket::read_tx_timestamp;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Open UDP socket
@@ -599,13 +1058,12 @@ inline ssize_t read (device_handle * h
         , size_t n
         , error_code & ec) noexcept
 {
-    socklen_t addrlen = 0;
+    socklen_t addrlen = paddr ? sizeof(paddr->addr) : 0;
     ssize_t rc = recvfrom(h->fd, bytes, n, 0
-            , reinterpret_cast<sockaddr *>(& paddr->addr), & addrlen);
+            , paddr ? reinterpret_cast<sockaddr *>(& paddr->addr) : nullptr
+            , paddr ? & addrlen : nullptr);
 
-    if (rc < 0
-            && errno == EAGAIN
-            || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+    if (rc < 0 && (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK)))
         rc = 0;
 
     if (rc < 0)
@@ -615,7 +1073,7 @@ inline ssize_t read (device_handle * h
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Write to UDP socket
+// Write to UDP socket (to connected peer if paddr is null)
 ////////////////////////////////////////////////////////////////////////////////
 inline ssize_t write (device_handle * h
         , host_address const * paddr
@@ -634,8 +1092,8 @@ inline ssize_t write (device_handle * h
                 , bytes + total_written
                 , n
                 , MSG_NOSIGNAL
-                , reinterpret_cast<sockaddr const *>(& paddr->addr)
-                , sizeof(paddr->addr));
+                , paddr ? reinterpret_cast<sockaddr const *>(& paddr->addr) : nullptr
+                , paddr ? sizeof(paddr->addr) : 0);
 
         if (written < 0) {
             if (errno == EAGAIN
@@ -655,6 +1113,678 @@ inline ssize_t write (device_handle * h
 
     return total_written;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Gather buffers into single datagram
+////////////////////////////////////////////////////////////////////////////////
+inline ssize_t writev (device_handle * h
+        , host_address const * paddr
+        , io_vector const * iov
+        , int iovcnt
+        , error_code & ec) noexcept
+{
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+
+    if (paddr) {
+        msg.msg_name = const_cast<void *>(static_cast<void const *>(& paddr->addr));
+        msg.msg_namelen = sizeof(paddr->addr);
+    }
+
+    msg.msg_iov = const_cast<io_vector *>(iov);
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(iovcnt);
+
+    ssize_t rc = sendmsg(h->fd, & msg, MSG_NOSIGNAL);
+
+    if (rc < 0)
+        ec = get_last_system_error();
+
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Connect UDP socket: datagrams are sent to peer without address and only
+// datagrams from peer are received
+////////////////////////////////////////////////////////////////////////////////
+inline error_code connect (device_handle * h, host_address const * paddr)
+{
+    auto addr = reinterpret_cast<sockaddr const *>(& paddr->addr);
+    socklen_t addrlen = addr->sa_family == AF_INET6
+        ? sizeof(paddr->addr.addr6)
+        : sizeof(paddr->addr.addr4);
+
+    int rc = ::connect(h->fd, addr, addrlen);
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+inline error_code disconnect (device_handle * h)
+{
+    sockaddr addr;
+    std::memset(& addr, 0, sizeof(addr));
+    addr.sa_family = AF_UNSPEC;
+
+    int rc = ::connect(h->fd, & addr, sizeof(addr));
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Segmentation offload (Linux 4.18+ for sending, 5.0+ for receiving)
+////////////////////////////////////////////////////////////////////////////////
+
+// Limits of single UDP_SEGMENT send (UDP_MAX_SEGMENTS and IPv4 datagram size)
+constexpr size_t max_gso_segments = 64;
+constexpr size_t max_gso_size = 65507;
+
+/**
+ * Sends @a n bytes as datagrams of @a segment_size bytes (the last one may
+ * be shorter). Up to 64 datagrams are passed to the kernel by one call if
+ * @a *gso is @c true, @a *gso is reset if segmentation offload is not
+ * supported and datagrams are sent one by one.
+ */
+inline ssize_t write_segments (device_handle * h
+        , host_address const * paddr
+        , char const * bytes
+        , size_t n
+        , size_t segment_size
+        , bool * gso
+        , error_code & ec) noexcept
+{
+    if (segment_size == 0 || segment_size > max_gso_size) {
+        ec = make_error_code(errc::invalid_argument);
+        return -1;
+    }
+
+    size_t total = 0;
+
+    while (total < n) {
+        size_t batch = segment_size;
+
+#if defined(UDP_SEGMENT)
+        if (*gso)
+            batch = std::min(max_gso_segments, max_gso_size / segment_size) * segment_size;
+#endif
+
+        batch = std::min(batch, n - total);
+
+        iovec iov;
+        iov.iov_base = const_cast<char *>(bytes + total);
+        iov.iov_len = batch;
+
+        msghdr msg;
+        std::memset(& msg, 0, sizeof(msg));
+
+        if (paddr) {
+            msg.msg_name = const_cast<void *>(static_cast<void const *>(& paddr->addr));
+            msg.msg_namelen = sizeof(paddr->addr);
+        }
+
+        msg.msg_iov = & iov;
+        msg.msg_iovlen = 1;
+
+#if defined(UDP_SEGMENT)
+        union {
+            char buf[CMSG_SPACE(sizeof(std::uint16_t))];
+            cmsghdr align;
+        } control;
+
+        if (batch > segment_size) {
+            std::memset(& control, 0, sizeof(control));
+            msg.msg_control = & control;
+            msg.msg_controllen = sizeof(control);
+
+            auto cmsg = CMSG_FIRSTHDR(& msg);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+            auto size = static_cast<std::uint16_t>(segment_size);
+            std::memcpy(CMSG_DATA(cmsg), & size, sizeof(size));
+        }
+#endif
+
+        ssize_t rc = sendmsg(h->fd, & msg, MSG_NOSIGNAL);
+
+        if (rc < 0) {
+            if (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+                continue;
+
+            // Kernel or device without segmentation offload
+            if (batch > segment_size && (errno == EINVAL || errno == EIO
+                    || errno == ENOPROTOOPT || errno == EOPNOTSUPP)) {
+                *gso = false;
+                continue;
+            }
+
+            ec = get_last_system_error();
+            return -1;
+        }
+
+        total += static_cast<size_t>(rc);
+    }
+
+    return static_cast<ssize_t>(total);
+}
+
+/**
+ * Enables receiving of coalesced datagrams by read_segments().
+ */
+inline error_code set_gro (device_handle * h, bool enable)
+{
+#if defined(UDP_GRO)
+    int value = enable ? 1 : 0;
+    int rc = setsockopt(h->fd, SOL_UDP, UDP_GRO, & value, sizeof(value));
+    return rc < 0 ? get_last_system_error() : error_code{};
+#else
+    (void)h;
+    return enable ? make_error_code(errc::operation_not_supported) : error_code{};
+#endif
+}
+
+/**
+ * Enables departure time of datagrams given to writev_at() (can not be
+ * disabled, datagrams without departure time are sent immediately).
+ * Departure times refer to CLOCK_MONOTONIC (std::chrono::steady_clock) and
+ * are honored by fq queueing discipline, other ones ignore them.
+ */
+inline error_code set_txtime (device_handle * h)
+{
+#if defined(SO_TXTIME)
+    sock_txtime value;
+    value.clockid = CLOCK_MONOTONIC;
+    value.flags = 0;
+    int rc = setsockopt(h->fd, SOL_SOCKET, SO_TXTIME, & value, sizeof(value));
+    return rc < 0 ? get_last_system_error() : error_code{};
+#else
+    (void)h;
+    return make_error_code(errc::operation_not_supported);
+#endif
+}
+
+/**
+ * Sends buffers as a single datagram leaving the host not earlier than
+ * @a txtime nanoseconds of CLOCK_MONOTONIC (see set_txtime()).
+ */
+inline ssize_t writev_at (device_handle * h
+        , host_address const * paddr
+        , io_vector const * iov
+        , int iovcnt
+        , std::uint64_t txtime
+        , error_code & ec) noexcept
+{
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+
+    if (paddr) {
+        msg.msg_name = const_cast<void *>(static_cast<void const *>(& paddr->addr));
+        msg.msg_namelen = sizeof(paddr->addr);
+    }
+
+    msg.msg_iov = const_cast<io_vector *>(iov);
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(iovcnt);
+
+#if defined(SCM_TXTIME)
+    union {
+        char buf[CMSG_SPACE(sizeof(std::uint64_t))];
+        cmsghdr align;
+    } control;
+
+    std::memset(& control, 0, sizeof(control));
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    auto cmsg = CMSG_FIRSTHDR(& msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_TXTIME;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(txtime));
+    std::memcpy(CMSG_DATA(cmsg), & txtime, sizeof(txtime));
+#else
+    (void)txtime;
+#endif
+
+    ssize_t rc;
+
+    do {
+        rc = sendmsg(h->fd, & msg, MSG_NOSIGNAL);
+    } while (rc < 0 && (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK)));
+
+    if (rc < 0)
+        ec = get_last_system_error();
+
+    return rc;
+}
+
+/**
+ * Reads datagram or several coalesced datagrams of @a *segment_size bytes
+ * (the last one may be shorter) from the same sender.
+ */
+inline ssize_t read_segments (device_handle * h
+        , host_address * paddr
+        , char * bytes
+        , size_t n
+        , size_t * segment_size
+        , error_code & ec) noexcept
+{
+    iovec iov;
+    iov.iov_base = bytes;
+    iov.iov_len = n;
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+    msg.msg_name = paddr ? & paddr->addr : nullptr;
+    msg.msg_namelen = paddr ? sizeof(paddr->addr) : 0;
+    msg.msg_iov = & iov;
+    msg.msg_iovlen = 1;
+
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        cmsghdr align;
+    } control;
+
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t rc = recvmsg(h->fd, & msg, 0);
+
+    if (rc < 0) {
+        if (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+            return 0;
+
+        ec = get_last_system_error();
+        return -1;
+    }
+
+    *segment_size = static_cast<size_t>(rc);
+
+#if defined(UDP_GRO)
+    for (auto cmsg = CMSG_FIRSTHDR(& msg); cmsg; cmsg = CMSG_NXTHDR(& msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size = 0;
+            std::memcpy(& size, CMSG_DATA(cmsg), sizeof(size));
+
+            if (size > 0)
+                *segment_size = static_cast<size_t>(size);
+        }
+    }
+#endif
+
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Allow (or disallow) sending to broadcast addresses
+////////////////////////////////////////////////////////////////////////////////
+inline error_code set_broadcast (device_handle * h, bool enable)
+{
+    int value = enable ? 1 : 0;
+    int rc = setsockopt(h->fd, SOL_SOCKET, SO_BROADCAST, & value, sizeof(value));
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Multicast
+////////////////////////////////////////////////////////////////////////////////
+inline int socket_family (device_handle const * h)
+{
+    int family = AF_UNSPEC;
+    socklen_t len = sizeof(family);
+    getsockopt(h->fd, SOL_SOCKET, SO_DOMAIN, & family, & len);
+    return family;
+}
+
+// Interface index by name (e.g. "eth0"), zero for empty name
+inline unsigned interface_index (std::string const & iface, error_code & ec)
+{
+    if (iface.empty())
+        return 0;
+
+    auto index = if_nametoindex(iface.c_str());
+
+    if (index == 0)
+        ec = get_last_system_error();
+
+    return index;
+}
+
+// Parses numeric IPv4 or IPv6 address
+inline bool parse_address (std::string const & s, sockaddr_storage & ss)
+{
+    std::memset(& ss, 0, sizeof(ss));
+    auto a4 = reinterpret_cast<sockaddr_in *>(& ss);
+    auto a6 = reinterpret_cast<sockaddr_in6 *>(& ss);
+
+    if (inet_pton(AF_INET, s.c_str(), & a4->sin_addr) > 0) {
+        a4->sin_family = AF_INET;
+        return true;
+    }
+
+    if (inet_pton(AF_INET6, s.c_str(), & a6->sin6_addr) > 0) {
+        a6->sin6_family = AF_INET6;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Joins or leaves multicast @a group. Membership is source-specific if
+ * @a source is not empty. Empty @a iface selects interface by routing table.
+ */
+inline error_code change_membership (device_handle * h
+        , std::string const & group
+        , std::string const & source
+        , std::string const & iface
+        , bool join)
+{
+    error_code ec;
+    auto index = interface_index(iface, ec);
+
+    if (ec)
+        return ec;
+
+    sockaddr_storage group_addr;
+
+    if (!parse_address(group, group_addr))
+        return make_error_code(errc::invalid_argument);
+
+    auto level = group_addr.ss_family == AF_INET ? IPPROTO_IP : IPPROTO_IPV6;
+    int rc = 0;
+
+    // By default Linux delivers to the socket all groups joined by any socket
+    // bound to the same port. Older kernels do not support the option for
+    // IPv6, joining fails then instead of silently receiving other groups.
+    if (join) {
+        int off = 0;
+
+        if (group_addr.ss_family == AF_INET) {
+            rc = setsockopt(h->fd, IPPROTO_IP, IP_MULTICAST_ALL, & off, sizeof(off));
+        } else {
+#if defined(IPV6_MULTICAST_ALL)
+            rc = setsockopt(h->fd, IPPROTO_IPV6, IPV6_MULTICAST_ALL, & off, sizeof(off));
+#else
+            return make_error_code(errc::operation_not_supported);
+#endif
+        }
+
+        if (rc < 0)
+            return get_last_system_error();
+    }
+
+    if (source.empty()) {
+        if (group_addr.ss_family == AF_INET) {
+            ip_mreqn mreq;
+            std::memset(& mreq, 0, sizeof(mreq));
+            mreq.imr_multiaddr = reinterpret_cast<sockaddr_in *>(& group_addr)->sin_addr;
+            mreq.imr_address.s_addr = htonl(INADDR_ANY);
+            mreq.imr_ifindex = static_cast<int>(index);
+
+            rc = setsockopt(h->fd, level, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP
+                    , & mreq, sizeof(mreq));
+        } else {
+            ipv6_mreq mreq;
+            std::memset(& mreq, 0, sizeof(mreq));
+            mreq.ipv6mr_multiaddr = reinterpret_cast<sockaddr_in6 *>(& group_addr)->sin6_addr;
+            mreq.ipv6mr_interface = index;
+
+            rc = setsockopt(h->fd, level, join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP
+                    , & mreq, sizeof(mreq));
+        }
+    } else {
+        sockaddr_storage source_addr;
+
+        if (!parse_address(source, source_addr) || source_addr.ss_family != group_addr.ss_family)
+            return make_error_code(errc::invalid_argument);
+
+        // Protocol-independent API (RFC 3678) serves both families
+        group_source_req req;
+        std::memset(& req, 0, sizeof(req));
+        req.gsr_interface = index;
+        std::memcpy(& req.gsr_group, & group_addr, sizeof(group_addr));
+        std::memcpy(& req.gsr_source, & source_addr, sizeof(source_addr));
+
+        rc = setsockopt(h->fd, level, join ? MCAST_JOIN_SOURCE_GROUP : MCAST_LEAVE_SOURCE_GROUP
+                , & req, sizeof(req));
+    }
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+inline error_code join_group (device_handle * h
+        , std::string const & group
+        , std::string const & source
+        , std::string const & iface)
+{
+    return change_membership(h, group, source, iface, true);
+}
+
+inline error_code leave_group (device_handle * h
+        , std::string const & group
+        , std::string const & source
+        , std::string const & iface)
+{
+    return change_membership(h, group, source, iface, false);
+}
+
+/**
+ * Selects interface for outgoing multicast datagrams.
+ */
+inline error_code set_multicast_interface (device_handle * h, std::string const & iface)
+{
+    error_code ec;
+    auto index = interface_index(iface, ec);
+
+    if (ec)
+        return ec;
+
+    int rc = 0;
+
+    if (socket_family(h) == AF_INET6) {
+        int value = static_cast<int>(index);
+        rc = setsockopt(h->fd, IPPROTO_IPV6, IPV6_MULTICAST_IF, & value, sizeof(value));
+    } else {
+        ip_mreqn mreq;
+        std::memset(& mreq, 0, sizeof(mreq));
+        mreq.imr_ifindex = static_cast<int>(index);
+        rc = setsockopt(h->fd, IPPROTO_IP, IP_MULTICAST_IF, & mreq, sizeof(mreq));
+    }
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+/**
+ * Sets TTL (IPv4) or hop limit (IPv6) of outgoing multicast datagrams.
+ */
+inline error_code set_multicast_ttl (device_handle * h, int ttl)
+{
+    int rc = socket_family(h) == AF_INET6
+        ? setsockopt(h->fd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, & ttl, sizeof(ttl))
+        : setsockopt(h->fd, IPPROTO_IP, IP_MULTICAST_TTL, & ttl, sizeof(ttl));
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+/**
+ * Enables or disables delivery of outgoing multicast datagrams to local
+ * sockets.
+ */
+inline error_code set_multicast_loop (device_handle * h, bool enable)
+{
+    int value = enable ? 1 : 0;
+    int rc = socket_family(h) == AF_INET6
+        ? setsockopt(h->fd, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, & value, sizeof(value))
+        : setsockopt(h->fd, IPPROTO_IP, IP_MULTICAST_LOOP, & value, sizeof(value));
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Packet info: local address and interface of datagrams (for sockets bound to
+// wildcard address on multi-homed hosts)
+////////////////////////////////////////////////////////////////////////////////
+inline error_code set_packet_info (device_handle * h, bool enable)
+{
+    int value = enable ? 1 : 0;
+    int rc = 0;
+
+    if (socket_family(h) == AF_INET6) {
+        rc = setsockopt(h->fd, IPPROTO_IPV6, IPV6_RECVPKTINFO, & value, sizeof(value));
+
+        // IPv4-mapped datagrams of dual-stack socket
+        if (rc == 0)
+            setsockopt(h->fd, IPPROTO_IP, IP_PKTINFO, & value, sizeof(value));
+    } else {
+        rc = setsockopt(h->fd, IPPROTO_IP, IP_PKTINFO, & value, sizeof(value));
+    }
+
+    return rc < 0 ? get_last_system_error() : error_code{};
+}
+
+// Control buffer large enough for any packet info
+union packet_info_control
+{
+    char v4[CMSG_SPACE(sizeof(in_pktinfo))];
+    char v6[CMSG_SPACE(sizeof(in6_pktinfo))];
+    cmsghdr align;
+};
+
+/**
+ * Reads datagram, fills @a *pinfo if packet info is enabled (set_packet_info()).
+ */
+inline ssize_t read (device_handle * h
+        , host_address * paddr
+        , packet_info * pinfo
+        , char * bytes
+        , size_t n
+        , error_code & ec) noexcept
+{
+    iovec iov;
+    iov.iov_base = bytes;
+    iov.iov_len = n;
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+    msg.msg_name = paddr ? & paddr->addr : nullptr;
+    msg.msg_namelen = paddr ? sizeof(paddr->addr) : 0;
+    msg.msg_iov = & iov;
+    msg.msg_iovlen = 1;
+
+    packet_info_control control;
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t rc = recvmsg(h->fd, & msg, 0);
+
+    if (rc < 0) {
+        if (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+            return 0;
+
+        ec = get_last_system_error();
+        return -1;
+    }
+
+    *pinfo = packet_info{};
+
+    for (auto cmsg = CMSG_FIRSTHDR(& msg); cmsg; cmsg = CMSG_NXTHDR(& msg, cmsg)) {
+        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+            in_pktinfo info;
+            std::memcpy(& info, CMSG_DATA(cmsg), sizeof(info));
+            pinfo->local.addr.addr4.sin_family = AF_INET;
+            pinfo->local.addr.addr4.sin_addr = info.ipi_addr;
+            pinfo->interface = static_cast<unsigned>(info.ipi_ifindex);
+        } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+            in6_pktinfo info;
+            std::memcpy(& info, CMSG_DATA(cmsg), sizeof(info));
+            pinfo->local.addr.addr6.sin6_family = AF_INET6;
+            pinfo->local.addr.addr6.sin6_addr = info.ipi6_addr;
+            pinfo->interface = info.ipi6_ifindex;
+        }
+    }
+
+    return rc;
+}
+
+/**
+ * Sends datagram from local address of @a *pinfo (as received by read()).
+ */
+inline ssize_t write (device_handle * h
+        , host_address const * paddr
+        , packet_info const * pinfo
+        , char const * bytes
+        , size_t n
+        , error_code & ec) noexcept
+{
+    iovec iov;
+    iov.iov_base = const_cast<char *>(bytes);
+    iov.iov_len = n;
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+
+    if (paddr) {
+        msg.msg_name = const_cast<void *>(static_cast<void const *>(& paddr->addr));
+        msg.msg_namelen = sizeof(paddr->addr);
+    }
+
+    msg.msg_iov = & iov;
+    msg.msg_iovlen = 1;
+
+    packet_info_control control;
+    std::memset(& control, 0, sizeof(control));
+    msg.msg_control = & control;
+    msg.msg_controllen = sizeof(control);
+
+    auto cmsg = CMSG_FIRSTHDR(& msg);
+
+    if (pinfo->local.addr.addr4.sin_family == AF_INET) {
+        // Interface is chosen by routing table
+        in_pktinfo info;
+        std::memset(& info, 0, sizeof(info));
+        info.ipi_spec_dst = pinfo->local.addr.addr4.sin_addr;
+
+        msg.msg_controllen = CMSG_SPACE(sizeof(info));
+        cmsg->cmsg_level = IPPROTO_IP;
+        cmsg->cmsg_type = IP_PKTINFO;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+        std::memcpy(CMSG_DATA(cmsg), & info, sizeof(info));
+    } else if (pinfo->local.addr.addr6.sin6_family == AF_INET6) {
+        // Interface is required for link-local addresses
+        in6_pktinfo info;
+        std::memset(& info, 0, sizeof(info));
+        info.ipi6_addr = pinfo->local.addr.addr6.sin6_addr;
+        info.ipi6_ifindex = pinfo->interface;
+
+        msg.msg_controllen = CMSG_SPACE(sizeof(info));
+        cmsg->cmsg_level = IPPROTO_IPV6;
+        cmsg->cmsg_type = IPV6_PKTINFO;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+        std::memcpy(CMSG_DATA(cmsg), & info, sizeof(info));
+    } else {
+        msg.msg_control = nullptr;
+        msg.msg_controllen = 0;
+    }
+
+    ssize_t rc;
+
+    do {
+        rc = sendmsg(h->fd, & msg, MSG_NOSIGNAL);
+    } while (rc < 0 && (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK)));
+
+    if (rc < 0)
+        ec = get_last_system_error();
+
+    return rc;
+}
 } // udp
 
 }}} // pfs::io::unix_ns
+
+namespace std {
+
+template <>
+struct hash<pfs::io::unix_ns::host_address>
+{
+    size_t operator () (pfs::io::unix_ns::host_address const & a) const noexcept
+    {
+        return pfs::io::unix_ns::hash_value(a);
+    }
+};
+
+} // std
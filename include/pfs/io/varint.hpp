@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Added zigzag encoding for signed values
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//
+// Variable-length unsigned integer encoding (LEB128, as in Protocol Buffers):
+// seven bits per byte, least significant group first, high bit set in all
+// bytes except the last one. Signed values are zigzag-mapped first, so that
+// small negative numbers stay short.
+//
+
+namespace pfs {
+namespace io {
+
+// Maximum encoded size of 64-bit value
+constexpr std::size_t varint_max_size = 10;
+
+inline std::size_t varint_size (std::uint64_t value) noexcept
+{
+    std::size_t n = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ * Encodes @a value into @a out (at least varint_size(value) bytes).
+ *
+ * @return Number of bytes written.
+ */
+inline std::size_t encode_varint (std::uint64_t value, char * out) noexcept
+{
+    std::size_t n = 0;
+
+    while (value >= 0x80) {
+        out[n++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+
+    out[n++] = static_cast<char>(value);
+    return n;
+}
+
+/**
+ * Decodes value from [first, last).
+ *
+ * @return Number of bytes consumed, zero if input is incomplete, or -1 if
+ *         encoding is malformed (value does not fit 64 bits).
+ */
+inline int decode_varint (char const * first, char const * last, std::uint64_t & value) noexcept
+{
+    std::uint64_t result = 0;
+    int n = 0;
+
+    for (auto p = first; p < last; ++p) {
+        auto byte = static_cast<std::uint8_t>(*p);
+
+        // Tenth byte may carry the single remaining bit only
+        if (n == 9 && byte > 1)
+            return -1;
+
+        result |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * n);
+        n++;
+
+        if (!(byte & 0x80)) {
+            value = result;
+            return n;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Maps signed value to unsigned: 0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+ */
+constexpr std::uint64_t zigzag_encode (std::int64_t value) noexcept
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+constexpr std::int64_t zigzag_decode (std::uint64_t value) noexcept
+{
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+}} // pfs::io
@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "bytes_view.hpp"
+#include "cpu_features.hpp"
+#include "device.hpp"
+#include "varint.hpp"
+#include <cstdint>
+#include <cstring>
+
+//
+// Bulk varint and zigzag kernels. SIMD decoders classify a whole block of
+// input at once (continuation bits via movemask): a block of single-byte
+// values is widened with one instruction per group, other values are
+// located by terminator bitmap and gathered from a 64-bit word without
+// per-byte loop. Encoders pack groups of small values the same way.
+//
+
+namespace pfs {
+namespace io {
+
+namespace details {
+
+using decode_varints_func = size_t (*) (char const *& first, char const * last
+    , std::uint64_t * out, size_t count, error_code & ec);
+using encode_varints_func = size_t (*) (std::uint64_t const * values, size_t count, char * out);
+using zigzag_encode_func = void (*) (std::int64_t const * values, size_t count, std::uint64_t * out);
+using zigzag_decode_func = void (*) (std::uint64_t const * values, size_t count, std::int64_t * out);
+
+inline size_t decode_varints_scalar (char const *& first, char const * last
+    , std::uint64_t * out, size_t count, error_code & ec)
+{
+    size_t i = 0;
+
+    for (; i < count; i++) {
+        auto n = decode_varint(first, last, out[i]);
+
+        if (n <= 0) {
+            if (n < 0)
+                ec = make_error_code(errc::bad_message);
+            break;
+        }
+
+        first += n;
+    }
+
+    return i;
+}
+
+inline size_t encode_varints_scalar (std::uint64_t const * values, size_t count, char * out)
+{
+    size_t n = 0;
+
+    for (size_t i = 0; i < count; i++)
+        n += encode_varint(values[i], out + n);
+
+    return n;
+}
+
+inline void zigzag_encode_scalar (std::int64_t const * values, size_t count, std::uint64_t * out)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = zigzag_encode(values[i]);
+}
+
+inline void zigzag_decode_scalar (std::uint64_t const * values, size_t count, std::int64_t * out)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = zigzag_decode(values[i]);
+}
+
+#if defined(PFS_IO_X86_SIMD)
+
+// Gathers 7-bit groups of little-endian word (high bits must be cleared)
+inline std::uint64_t varint_compact (std::uint64_t x) noexcept
+{
+    x = ((x & 0x7F007F007F007F00ULL) >> 1) | (x & 0x007F007F007F007FULL);
+    x = ((x & 0x3FFF00003FFF0000ULL) >> 2) | (x & 0x00003FFF00003FFFULL);
+    x = ((x & 0x0FFFFFFF00000000ULL) >> 4) | (x & 0x000000000FFFFFFFULL);
+    return x;
+}
+
+// Inverse of varint_compact() for values below 2^56
+inline std::uint64_t varint_spread (std::uint64_t x) noexcept
+{
+    x = ((x & 0x00FFFFFFF0000000ULL) << 4) | (x & 0x000000000FFFFFFFULL);
+    x = ((x & 0x0FFFC0000FFFC000ULL) << 2) | (x & 0x00003FFF00003FFFULL);
+    x = ((x & 0x3F803F803F803F80ULL) << 1) | (x & 0x007F007F007F007FULL);
+    return x;
+}
+
+/**
+ * Encodes value with a single 8-byte store, so @a out must have 8 bytes
+ * available.
+ */
+inline size_t encode_varint_word (std::uint64_t value, char * out) noexcept
+{
+    if (value >> 56)
+        return encode_varint(value, out);
+
+    size_t len = static_cast<size_t>(63 - __builtin_clzll(value | 1)) / 7 + 1;
+    // Continuation bits for all bytes but the last one
+    auto word = varint_spread(value) | (0x8080808080808080ULL & ((1ULL << (8 * (len - 1))) - 1));
+    std::memcpy(out, & word, 8);
+    return len;
+}
+
+/**
+ * Decodes values terminated in a block starting at @a p, @a term has a bit
+ * set for every terminating byte. Stops at value longer than 8 bytes.
+ * Requires 8 readable bytes after every terminator.
+ *
+ * @return Number of bytes consumed.
+ */
+inline size_t decode_varints_masked (char const * p, std::uint32_t term
+    , std::uint64_t * out, size_t count, size_t & decoded) noexcept
+{
+    size_t offset = 0;
+    decoded = 0;
+
+    while (term != 0 && decoded < count) {
+        auto end = static_cast<size_t>(__builtin_ctz(term)) + 1;
+        auto len = end - offset;
+
+        if (len > 8)
+            break;
+
+        std::uint64_t word;
+        std::memcpy(& word, p + offset, 8);
+        word &= 0x7F7F7F7F7F7F7F7FULL & (~0ULL >> (64 - 8 * len));
+        out[decoded++] = varint_compact(word);
+
+        offset = end;
+        term &= term - 1;
+    }
+
+    return offset;
+}
+
+PFS_IO_TARGET("sse4.1")
+inline size_t decode_varints_sse41 (char const *& first, char const * last
+    , std::uint64_t * out, size_t count, error_code & ec)
+{
+    auto p = first;
+    size_t i = 0;
+
+    while (i < count && last - p >= 16 + 8) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(block));
+
+        // Sixteen single-byte values
+        if (mask == 0 && count - i >= 16) {
+            auto q = reinterpret_cast<__m128i *>(out + i);
+            _mm_storeu_si128(q + 0, _mm_cvtepu8_epi64(block));
+            _mm_storeu_si128(q + 1, _mm_cvtepu8_epi64(_mm_srli_si128(block, 2)));
+            _mm_storeu_si128(q + 2, _mm_cvtepu8_epi64(_mm_srli_si128(block, 4)));
+            _mm_storeu_si128(q + 3, _mm_cvtepu8_epi64(_mm_srli_si128(block, 6)));
+            _mm_storeu_si128(q + 4, _mm_cvtepu8_epi64(_mm_srli_si128(block, 8)));
+            _mm_storeu_si128(q + 5, _mm_cvtepu8_epi64(_mm_srli_si128(block, 10)));
+            _mm_storeu_si128(q + 6, _mm_cvtepu8_epi64(_mm_srli_si128(block, 12)));
+            _mm_storeu_si128(q + 7, _mm_cvtepu8_epi64(_mm_srli_si128(block, 14)));
+            p += 16;
+            i += 16;
+            continue;
+        }
+
+        size_t decoded = 0;
+        p += decode_varints_masked(p, ~mask & 0xFFFF, out + i, count - i, decoded);
+        i += decoded;
+
+        // Long value
+        if (decoded == 0) {
+            auto n = decode_varint(p, last, out[i]);
+
+            if (n < 0) {
+                ec = make_error_code(errc::bad_message);
+                first = p;
+                return i;
+            }
+
+            p += n;
+            i++;
+        }
+    }
+
+    first = p;
+    return i + decode_varints_scalar(first, last, out + i, count - i, ec);
+}
+
+PFS_IO_TARGET("avx2")
+inline size_t decode_varints_avx2 (char const *& first, char const * last
+    , std::uint64_t * out, size_t count, error_code & ec)
+{
+    auto p = first;
+    size_t i = 0;
+
+    while (i < count && last - p >= 32 + 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(block));
+
+        // Thirty two single-byte values
+        if (mask == 0 && count - i >= 32) {
+            auto q = reinterpret_cast<__m256i *>(out + i);
+            __m128i lo = _mm256_castsi256_si128(block);
+            __m128i hi = _mm256_extracti128_si256(block, 1);
+            _mm256_storeu_si256(q + 0, _mm256_cvtepu8_epi64(lo));
+            _mm256_storeu_si256(q + 1, _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 4)));
+            _mm256_storeu_si256(q + 2, _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 8)));
+            _mm256_storeu_si256(q + 3, _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 12)));
+            _mm256_storeu_si256(q + 4, _mm256_cvtepu8_epi64(hi));
+            _mm256_storeu_si256(q + 5, _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 4)));
+            _mm256_storeu_si256(q + 6, _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 8)));
+            _mm256_storeu_si256(q + 7, _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 12)));
+            p += 32;
+            i += 32;
+            continue;
+        }
+
+        size_t decoded = 0;
+        p += decode_varints_masked(p, ~mask, out + i, count - i, decoded);
+        i += decoded;
+
+        if (decoded == 0) {
+            auto n = decode_varint(p, last, out[i]);
+
+            if (n < 0) {
+                ec = make_error_code(errc::bad_message);
+                first = p;
+                return i;
+            }
+
+            p += n;
+            i++;
+        }
+    }
+
+    first = p;
+    return i + decode_varints_scalar(first, last, out + i, count - i, ec);
+}
+
+// Packs 16 values below 128 (four vectors of two values) into bytes
+PFS_IO_TARGET("sse4.1")
+inline __m128i pack_varint_bytes_sse41 (__m128i const * v)
+{
+    __m128i d[4];
+
+    for (int k = 0; k < 4; k++) {
+        d[k] = _mm_unpacklo_epi64(_mm_shuffle_epi32(v[2 * k], _MM_SHUFFLE(3, 3, 2, 0))
+            , _mm_shuffle_epi32(v[2 * k + 1], _MM_SHUFFLE(3, 3, 2, 0)));
+    }
+
+    return _mm_packus_epi16(_mm_packus_epi32(d[0], d[1]), _mm_packus_epi32(d[2], d[3]));
+}
+
+PFS_IO_TARGET("sse4.1")
+inline size_t encode_varints_sse41 (std::uint64_t const * values, size_t count, char * out)
+{
+    __m128i const high = _mm_set1_epi64x(~std::int64_t{0x7F});
+    size_t n = 0;
+    size_t i = 0;
+
+    while (i + 16 <= count) {
+        __m128i v[8];
+        __m128i any = _mm_setzero_si128();
+
+        for (int k = 0; k < 8; k++) {
+            v[k] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i) + k);
+            any = _mm_or_si128(any, v[k]);
+        }
+
+        if (_mm_testz_si128(any, high)) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + n), pack_varint_bytes_sse41(v));
+            n += 16;
+            i += 16;
+            continue;
+        }
+
+        for (size_t end = i + 16; i < end; i++)
+            n += encode_varint_word(values[i], out + n);
+    }
+
+    for (; i < count; i++)
+        n += encode_varint_word(values[i], out + n);
+
+    return n;
+}
+
+PFS_IO_TARGET("avx2")
+inline size_t encode_varints_avx2 (std::uint64_t const * values, size_t count, char * out)
+{
+    __m256i const high = _mm256_set1_epi64x(~std::int64_t{0x7F});
+    __m256i const low_dwords = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    size_t n = 0;
+    size_t i = 0;
+
+    while (i + 16 <= count) {
+        auto p = reinterpret_cast<__m256i const *>(values + i);
+        __m256i v0 = _mm256_loadu_si256(p + 0);
+        __m256i v1 = _mm256_loadu_si256(p + 1);
+        __m256i v2 = _mm256_loadu_si256(p + 2);
+        __m256i v3 = _mm256_loadu_si256(p + 3);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(v0, v1), _mm256_or_si256(v2, v3));
+
+        if (_mm256_testz_si256(any, high)) {
+            __m128i d0 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v0, low_dwords));
+            __m128i d1 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v1, low_dwords));
+            __m128i d2 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v2, low_dwords));
+            __m128i d3 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v3, low_dwords));
+            __m128i bytes = _mm_packus_epi16(_mm_packus_epi32(d0, d1), _mm_packus_epi32(d2, d3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + n), bytes);
+            n += 16;
+            i += 16;
+            continue;
+        }
+
+        for (size_t end = i + 16; i < end; i++)
+            n += encode_varint_word(values[i], out + n);
+    }
+
+    for (; i < count; i++)
+        n += encode_varint_word(values[i], out + n);
+
+    return n;
+}
+
+PFS_IO_TARGET("sse4.1")
+inline void zigzag_encode_sse41 (std::int64_t const * values, size_t count, std::uint64_t * out)
+{
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+
+        // Sign of each 64-bit lane spread over the lane
+        __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(v, 31), _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i)
+            , _mm_xor_si128(_mm_slli_epi64(v, 1), sign));
+    }
+
+    zigzag_encode_scalar(values + i, count - i, out + i);
+}
+
+PFS_IO_TARGET("sse4.1")
+inline void zigzag_decode_sse41 (std::uint64_t const * values, size_t count, std::int64_t * out)
+{
+    __m128i const one = _mm_set1_epi64x(1);
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+        __m128i sign = _mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(v, one));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i)
+            , _mm_xor_si128(_mm_srli_epi64(v, 1), sign));
+    }
+
+    zigzag_decode_scalar(values + i, count - i, out + i);
+}
+
+PFS_IO_TARGET("avx2")
+inline void zigzag_encode_avx2 (std::int64_t const * values, size_t count, std::uint64_t * out)
+{
+    __m256i const zero = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+        __m256i sign = _mm256_cmpgt_epi64(zero, v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i)
+            , _mm256_xor_si256(_mm256_slli_epi64(v, 1), sign));
+    }
+
+    zigzag_encode_scalar(values + i, count - i, out + i);
+}
+
+PFS_IO_TARGET("avx2")
+inline void zigzag_decode_avx2 (std::uint64_t const * values, size_t count, std::int64_t * out)
+{
+    __m256i const one = _mm256_set1_epi64x(1);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+        __m256i sign = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(v, one));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i)
+            , _mm256_xor_si256(_mm256_srli_epi64(v, 1), sign));
+    }
+
+    zigzag_decode_scalar(values + i, count - i, out + i);
+}
+
+#endif // PFS_IO_X86_SIMD
+
+struct varint_kernels
+{
+    decode_varints_func decode;
+    encode_varints_func encode;
+    zigzag_encode_func zigzag_encode;
+    zigzag_decode_func zigzag_decode;
+};
+
+/**
+ * Selects the best kernels not exceeding @a isa and supported by the CPU.
+ */
+inline varint_kernels select_varint_kernels (simd_isa isa)
+{
+#if defined(PFS_IO_X86_SIMD)
+    if (isa >= simd_isa::avx2 && simd_isa_supported(simd_isa::avx2)) {
+        return varint_kernels{decode_varints_avx2, encode_varints_avx2
+            , zigzag_encode_avx2, zigzag_decode_avx2};
+    }
+
+    if (isa >= simd_isa::sse41 && simd_isa_supported(simd_isa::sse41)) {
+        return varint_kernels{decode_varints_sse41, encode_varints_sse41
+            , zigzag_encode_sse41, zigzag_decode_sse41};
+    }
+#else
+    (void)isa;
+#endif
+
+    return varint_kernels{decode_varints_scalar, encode_varints_scalar
+        , zigzag_encode_scalar, zigzag_decode_scalar};
+}
+
+inline varint_kernels const & best_varint_kernels ()
+{
+    static varint_kernels const k = select_varint_kernels(best_simd_isa());
+    return k;
+}
+
+} // details
+
+/**
+ * Decodes up to @a count values from [first, last) and advances @a first
+ * past them. Decoding stops before incomplete value or, with
+ * errc::bad_message, before malformed one.
+ *
+ * @return Number of values decoded.
+ */
+inline size_t decode_varints (char const *& first, char const * last
+    , std::uint64_t * out, size_t count, error_code & ec)
+{
+    return details::best_varint_kernels().decode(first, last, out, count, ec);
+}
+
+/**
+ * Decodes values from the beginning of @a input and removes them from it.
+ */
+inline size_t decode_varints (bytes_view & input, std::uint64_t * out, size_t count, error_code & ec)
+{
+    auto first = input.data();
+    auto n = decode_varints(first, input.data() + input.size(), out, count, ec);
+    input = input.substr(static_cast<size_t>(first - input.data()));
+    return n;
+}
+
+/**
+ * Encodes @a count values into @a out, which must have room for
+ * count * varint_max_size bytes.
+ *
+ * @return Number of bytes written.
+ */
+inline size_t encode_varints (std::uint64_t const * values, size_t count, char * out)
+{
+    return details::best_varint_kernels().encode(values, count, out);
+}
+
+inline void zigzag_encode (std::int64_t const * values, size_t count, std::uint64_t * out)
+{
+    details::best_varint_kernels().zigzag_encode(values, count, out);
+}
+
+inline void zigzag_decode (std::uint64_t const * values, size_t count, std::int64_t * out)
+{
+    details::best_varint_kernels().zigzag_decode(values, count, out);
+}
+
+}} // pfs::io
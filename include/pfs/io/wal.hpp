@@ -0,0 +1,671 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Added commit delay
+//      2026.10.19 Torn record in a non-last segment is reported as corruption
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "crc32c.hpp"
+#include "file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//
+// Write-ahead log layout
+// ----------------------
+//
+// Log is a directory of segment files named by 16 hexadecimal digits of the
+// segment number with ".wal" suffix. Each segment is preallocated to the
+// configured size (so unwritten space reads as zeros) and contains records
+// framed as:
+//
+//      +---------------+---------------+-----------------+
+//      | length (LE32) | CRC-32C (LE32)| payload[length] |
+//      +---------------+---------------+-----------------+
+//
+// CRC covers length field and payload. Zero length and zero CRC mark the end
+// of written data in the segment. A record with mismatched CRC (torn write)
+// also ends the segment. Only the last segment may end with a torn record,
+// segments before it are complete once the writer moves on.
+//
+
+namespace pfs {
+namespace io {
+
+namespace platform {
+namespace file {
+
+#if defined(PFS_OS_LINUX)
+    using unix_ns::file::make_directory;
+    using unix_ns::file::list_directory;
+    using unix_ns::file::sync_directory;
+    using unix_ns::file::remove_file;
+#endif
+
+}} // platform::file
+
+/**
+ * Position of a record in write-ahead log.
+ */
+struct wal_position
+{
+    std::uint64_t segment;
+    offset_type offset;
+};
+
+inline bool operator == (wal_position const & a, wal_position const & b)
+{
+    return a.segment == b.segment && a.offset == b.offset;
+}
+
+inline bool operator != (wal_position const & a, wal_position const & b)
+{
+    return !(a == b);
+}
+
+inline bool operator < (wal_position const & a, wal_position const & b)
+{
+    return a.segment < b.segment
+        || (a.segment == b.segment && a.offset < b.offset);
+}
+
+struct wal_options
+{
+    // Segment file size, space is preallocated on segment creation
+    offset_type segment_size {64 * 1024 * 1024};
+
+    // Flush applied on each group commit
+    durability sync_policy {durability::data_sync};
+
+    // Time the leader waits for more appenders before writing a group
+    // (trades latency for fewer flushes under concurrent load)
+    std::chrono::microseconds commit_delay {0};
+
+    permissions perms {owner_read | owner_write};
+};
+
+namespace details {
+
+constexpr std::size_t wal_header_size = 8;
+
+inline void wal_store32 (char * p, std::uint32_t v)
+{
+    p[0] = static_cast<char>(v & 0xFF);
+    p[1] = static_cast<char>((v >> 8) & 0xFF);
+    p[2] = static_cast<char>((v >> 16) & 0xFF);
+    p[3] = static_cast<char>((v >> 24) & 0xFF);
+}
+
+inline std::uint32_t wal_load32 (char const * p)
+{
+    auto u = reinterpret_cast<unsigned char const *>(p);
+    return static_cast<std::uint32_t>(u[0])
+        | static_cast<std::uint32_t>(u[1]) << 8
+        | static_cast<std::uint32_t>(u[2]) << 16
+        | static_cast<std::uint32_t>(u[3]) << 24;
+}
+
+inline std::uint32_t wal_record_crc (char const * length_field
+    , char const * data
+    , std::size_t n)
+{
+    return crc32c(crc32c(length_field, 4), data, n);
+}
+
+inline void wal_encode_header (char * header, char const * data, std::size_t n)
+{
+    wal_store32(header, static_cast<std::uint32_t>(n));
+    wal_store32(header + 4, wal_record_crc(header, data, n));
+}
+
+inline std::string wal_segment_name (std::uint64_t segment)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.wal"
+        , static_cast<unsigned long long>(segment));
+    return std::string{name};
+}
+
+inline bool wal_parse_segment_name (std::string const & name, std::uint64_t & segment)
+{
+    if (name.size() != 20 || name.compare(16, 4, ".wal") != 0)
+        return false;
+
+    char * end = nullptr;
+    auto value = std::strtoull(name.c_str(), & end, 16);
+
+    if (end != name.c_str() + 16)
+        return false;
+
+    segment = static_cast<std::uint64_t>(value);
+    return true;
+}
+
+inline std::string wal_segment_path (std::string const & dir, std::uint64_t segment)
+{
+    return dir + '/' + wal_segment_name(segment);
+}
+
+/**
+ * Lists segment numbers in ascending order.
+ */
+inline error_code wal_list_segments (std::string const & dir
+    , std::vector<std::uint64_t> & segments)
+{
+    std::vector<std::string> names;
+    auto ec = platform::file::list_directory(dir, names);
+
+    if (ec)
+        return ec;
+
+    for (auto const & name: names) {
+        std::uint64_t segment = 0;
+
+        if (wal_parse_segment_name(name, segment))
+            segments.push_back(segment);
+    }
+
+    std::sort(segments.begin(), segments.end());
+    return error_code{};
+}
+
+/**
+ * Scans records of a segment using large sequential reads, calling
+ * f(offset_type offset, char const * data, std::size_t n) for each valid
+ * record. Record data is valid during the call only.
+ *
+ * @param torn Set to @c true if scan stopped at a corrupted record.
+ * @return Offset past the last valid record.
+ */
+template <typename F>
+offset_type wal_scan_segment (file & segment, F && f, bool & torn, error_code & ec)
+{
+    std::size_t const chunk_size = 1024 * 1024;
+    std::vector<char> buf(chunk_size);
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    offset_type pos = 0;       // offset of the record at buf[begin]
+    offset_type read_pos = 0;  // offset of the byte to read next
+    bool eof = false;
+
+    torn = false;
+
+    auto file_size = segment.size(ec);
+
+    if (ec)
+        return 0;
+
+    segment.advise(access_advice::sequential);
+
+    // Ensures at least `need` bytes available in the buffer
+    auto fill = [&] (std::size_t need) -> bool {
+        while (end - begin < need) {
+            if (eof)
+                return false;
+
+            if (begin > 0) {
+                std::copy(buf.begin() + begin, buf.begin() + end, buf.begin());
+                end -= begin;
+                begin = 0;
+            }
+
+            if (need > buf.size())
+                buf.resize((need / chunk_size + 1) * chunk_size);
+
+            auto n = segment.read_at(buf.data() + end, buf.size() - end, read_pos, ec);
+
+            if (n < 0)
+                return false;
+
+            if (n == 0) {
+                eof = true;
+                return false;
+            }
+
+            end += static_cast<std::size_t>(n);
+            read_pos += n;
+        }
+
+        return true;
+    };
+
+    while (fill(wal_header_size)) {
+        char const * header = buf.data() + begin;
+        auto len = wal_load32(header);
+        auto crc = wal_load32(header + 4);
+
+        // End of written data
+        if (len == 0 && crc == 0)
+            break;
+
+        if (static_cast<offset_type>(len) > file_size - pos - static_cast<offset_type>(wal_header_size)) {
+            torn = true;
+            break;
+        }
+
+        if (!fill(wal_header_size + len)) {
+            torn = !ec;
+            break;
+        }
+
+        header = buf.data() + begin;
+        char const * data = header + wal_header_size;
+
+        if (wal_record_crc(header, data, len) != crc) {
+            torn = true;
+            break;
+        }
+
+        f(pos, data, static_cast<std::size_t>(len));
+
+        begin += wal_header_size + len;
+        pos += static_cast<offset_type>(wal_header_size + len);
+    }
+
+    return pos;
+}
+
+} // details
+
+/**
+ * @brief Append-only segmented write-ahead log writer.
+ *
+ * append() may be called concurrently. Records staged by concurrent appenders
+ * are written by a single leader with one write per segment and one flush
+ * (group commit), append() returns when the record is durable.
+ */
+class wal_writer
+{
+    struct chunk
+    {
+        std::uint64_t segment;
+        offset_type offset;
+        std::string data;
+    };
+
+    std::string _dir;
+    wal_options _options;
+
+    // Protected by mutex
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::vector<chunk> _pending;
+    wal_position _tail {};
+    std::uint64_t _requested {0};
+    std::uint64_t _completed {0};
+    std::uint64_t _commit_count {0};
+    bool _in_progress {false};
+    error_code _failure; // sticky: log tail is undefined after write error
+
+    // Accessed by the leader only
+    static_device<file> _segment;
+    std::uint64_t _segment_number {0};
+
+private:
+    wal_writer (std::string const & dir, wal_options const & options)
+        : _dir(dir)
+        , _options(options)
+    {}
+
+    error_code open_segment (std::uint64_t segment)
+    {
+        error_code ec;
+        auto path = details::wal_segment_path(_dir, segment);
+
+        _segment = make_static_file(path, read_write, _options.perms
+            , durability::none, ec);
+
+        if (ec)
+            return ec;
+
+        _segment_number = segment;
+
+        // Fallback to sparse file if preallocation is not supported
+        ec = _segment.underlying().allocate(0, _options.segment_size);
+
+        if (ec)
+            ec = _segment.underlying().resize(_options.segment_size);
+
+        if (!ec)
+            ec = platform::file::sync_directory(_dir);
+
+        return ec;
+    }
+
+    error_code recover ()
+    {
+        auto ec = platform::file::make_directory(_dir, _options.perms | owner_exec);
+
+        if (ec)
+            return ec;
+
+        std::vector<std::uint64_t> segments;
+        ec = details::wal_list_segments(_dir, segments);
+
+        if (ec)
+            return ec;
+
+        if (segments.empty()) {
+            _tail = wal_position{};
+            return open_segment(0);
+        }
+
+        ec = open_segment(segments.back());
+
+        if (ec)
+            return ec;
+
+        bool torn = false;
+        auto end = details::wal_scan_segment(_segment.underlying()
+            , [] (offset_type, char const *, std::size_t) {}, torn, ec);
+
+        if (ec)
+            return ec;
+
+        // Clear remnants of the torn record, so they can not be taken for
+        // valid data after the next record written over the beginning of it
+        if (torn) {
+            auto & f = _segment.underlying();
+            auto size = f.size(ec);
+
+            if (!ec && size > end) {
+                ec = f.zero_range(end, size - end, true);
+
+                if (ec)
+                    ec = f.punch_hole(end, size - end);
+            }
+
+            if (!ec)
+                ec = f.sync(_options.sync_policy);
+
+            if (ec)
+                return ec;
+        }
+
+        _tail = wal_position{segments.back(), end};
+        return error_code{};
+    }
+
+    error_code flush (std::vector<chunk> & chunks)
+    {
+        error_code ec;
+
+        for (auto & c: chunks) {
+            if (c.segment != _segment_number) {
+                // Previous segment must be durable before records in the
+                // next one
+                ec = _segment.underlying().sync(_options.sync_policy);
+
+                if (!ec)
+                    ec = open_segment(c.segment);
+
+                if (ec)
+                    return ec;
+            }
+
+            std::size_t written = 0;
+
+            while (written < c.data.size()) {
+                auto n = _segment.underlying().write_at(c.data.data() + written
+                    , c.data.size() - written
+                    , c.offset + static_cast<offset_type>(written)
+                    , ec);
+
+                if (n < 0)
+                    return ec;
+
+                written += static_cast<std::size_t>(n);
+            }
+        }
+
+        return _segment.underlying().sync(_options.sync_policy);
+    }
+
+public:
+    wal_writer (wal_writer const &) = delete;
+    wal_writer & operator = (wal_writer const &) = delete;
+
+    /**
+     * Maximum payload size of a single record.
+     */
+    std::size_t max_record_size () const noexcept
+    {
+        return static_cast<std::size_t>(_options.segment_size) - details::wal_header_size;
+    }
+
+    /**
+     * Appends record and waits until it is durable.
+     *
+     * @return Position of the record.
+     */
+    wal_position append (char const * data, std::size_t n, error_code & ec)
+    {
+        if (n > max_record_size()) {
+            ec = make_error_code(errc::invalid_argument);
+            return wal_position{};
+        }
+
+        char header[details::wal_header_size];
+        details::wal_encode_header(header, data, n);
+
+        std::unique_lock<std::mutex> lk(_mtx);
+
+        if (_failure) {
+            ec = _failure;
+            return wal_position{};
+        }
+
+        auto record_size = static_cast<offset_type>(details::wal_header_size + n);
+
+        // Rotate segment
+        if (_tail.offset + record_size > _options.segment_size) {
+            _tail.segment++;
+            _tail.offset = 0;
+        }
+
+        auto pos = _tail;
+
+        if (_pending.empty() || _pending.back().segment != pos.segment)
+            _pending.push_back(chunk{pos.segment, pos.offset, std::string{}});
+
+        _pending.back().data.append(header, sizeof(header)).append(data, n);
+        _tail.offset += record_size;
+
+        auto ticket = ++_requested;
+
+        while (_completed < ticket && !_failure) {
+            if (_in_progress) {
+                _cv.wait(lk);
+                continue;
+            }
+
+            // Become a leader: write and flush records of all appenders
+            // arrived so far
+            _in_progress = true;
+
+            if (_options.commit_delay.count() > 0) {
+                lk.unlock();
+                std::this_thread::sleep_for(_options.commit_delay);
+                lk.lock();
+            }
+
+            std::vector<chunk> chunks;
+            chunks.swap(_pending);
+            auto target = _requested;
+
+            lk.unlock();
+            auto flush_ec = flush(chunks);
+            lk.lock();
+
+            _in_progress = false;
+
+            if (flush_ec)
+                _failure = flush_ec;
+            else
+                _completed = target;
+
+            ++_commit_count;
+            _cv.notify_all();
+        }
+
+        if (_completed < ticket) {
+            ec = _failure;
+            return wal_position{};
+        }
+
+        return pos;
+    }
+
+    wal_position append (char const * data, std::size_t n)
+    {
+        error_code ec;
+        auto pos = append(data, n, ec);
+        if (ec) throw exception(ec);
+        return pos;
+    }
+
+    /**
+     * Position for the next record.
+     */
+    wal_position tail ()
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _tail;
+    }
+
+    /**
+     * Number of group commits (write + flush) performed.
+     */
+    std::uint64_t commit_count ()
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _commit_count;
+    }
+
+    /**
+     * Removes segments preceding @a segment (e.g. after checkpoint).
+     * Current segment is never removed.
+     */
+    error_code truncate_before (std::uint64_t segment)
+    {
+        {
+            std::lock_guard<std::mutex> lk(_mtx);
+            segment = std::min(segment, _tail.segment);
+        }
+
+        std::vector<std::uint64_t> segments;
+        auto ec = details::wal_list_segments(_dir, segments);
+
+        for (auto s: segments) {
+            if (ec || s >= segment)
+                break;
+
+            ec = platform::file::remove_file(details::wal_segment_path(_dir, s));
+        }
+
+        if (!ec)
+            ec = platform::file::sync_directory(_dir);
+
+        return ec;
+    }
+
+    friend unique_ptr<wal_writer> make_wal_writer (std::string const & dir
+        , wal_options const & options
+        , error_code & ec);
+};
+
+/**
+ * Opens write-ahead log in directory @a dir (created if needed), recovering
+ * position after the last valid record.
+ */
+inline unique_ptr<wal_writer> make_wal_writer (std::string const & dir
+    , wal_options const & options
+    , error_code & ec)
+{
+    unique_ptr<wal_writer> w {new wal_writer{dir, options}};
+    ec = w->recover();
+    return ec ? unique_ptr<wal_writer>{} : std::move(w);
+}
+
+inline unique_ptr<wal_writer> make_wal_writer (std::string const & dir
+    , wal_options const & options)
+{
+    error_code ec;
+    auto w = make_wal_writer(dir, options, ec);
+    if (ec) throw exception(ec);
+    return w;
+}
+
+/**
+ * @brief Write-ahead log reader (recovery scan).
+ */
+class wal_reader
+{
+    std::string _dir;
+
+public:
+    wal_reader (std::string const & dir)
+        : _dir(dir)
+    {}
+
+    /**
+     * Calls f(wal_position const & pos, char const * data, std::size_t n) for
+     * each valid record at or after @a from. Record data is valid during the
+     * call only.
+     *
+     * @return errc::data_corruption if a segment other than the last one ends
+     *         with a torn record (records after it are not delivered).
+     */
+    template <typename F>
+    error_code for_each (F && f, wal_position const & from = wal_position{})
+    {
+        std::vector<std::uint64_t> segments;
+        auto ec = details::wal_list_segments(_dir, segments);
+
+        for (auto s: segments) {
+            if (ec)
+                break;
+
+            if (s < from.segment)
+                continue;
+
+            auto d = make_static_file(details::wal_segment_path(_dir, s)
+                , read_only, owner_read, durability::none, ec);
+
+            if (ec)
+                break;
+
+            bool torn = false;
+
+            details::wal_scan_segment(d.underlying()
+                , [& f, & from, s] (offset_type offset, char const * data, std::size_t n) {
+                    wal_position pos {s, offset};
+
+                    if (!(pos < from))
+                        f(pos, data, n);
+                }
+                , torn, ec);
+
+            if (!ec && torn && s != segments.back())
+                ec = make_error_code(errc::data_corruption);
+        }
+
+        return ec;
+    }
+};
+
+}} // pfs::io
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/async_file_writer.hpp"
+#include "utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Device that blocks on each write until released
+class gated_device : public pfs::io::basic_device
+{
+public:
+    std::atomic<bool> released {false};
+    std::string data;
+
+    pfs::io::device_type type () const noexcept override
+    {
+        return pfs::io::device_type::buffer;
+    }
+
+    pfs::io::open_mode_flags open_mode () const noexcept override
+    {
+        return pfs::io::write_only;
+    }
+
+    bool has_pending_data () noexcept override
+    {
+        return false;
+    }
+
+    ssize_t read (char *, size_t, pfs::io::error_code & ec) noexcept override
+    {
+        ec = pfs::io::make_error_code(pfs::io::errc::invalid_argument);
+        return -1;
+    }
+
+    ssize_t write (char const * bytes, size_t n, pfs::io::error_code &) noexcept override
+    {
+        while (!released)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+        data.append(bytes, n);
+        return static_cast<ssize_t>(n);
+    }
+
+    pfs::io::error_code close () override
+    {
+        return pfs::io::error_code{};
+    }
+
+    bool opened () const noexcept override
+    {
+        return true;
+    }
+};
+
+TEST_CASE("Async file writer / basic") {
+    pfs::io::async_writer_options options;
+    options.buffer_size = 1024;
+    options.buffer_count = 4;
+
+    std::string expected;
+
+    {
+        auto w = pfs::io::make_async_file_writer(tmp_path("async_file_writer.txt"), options);
+
+        for (int i = 0; i < 100; i++) {
+            REQUIRE(w->write(loremipsum, sizeof(loremipsum) - 1) == sizeof(loremipsum) - 1);
+            expected += loremipsum;
+        }
+
+        REQUIRE(!w->flush());
+        CHECK(w->written_bytes() == expected.size());
+        CHECK(read_all(tmp_path("async_file_writer.txt")) == expected);
+
+        // Written out by timer
+        REQUIRE(w->write("tail", 4) == 4);
+        expected += "tail";
+        std::this_thread::sleep_for(std::chrono::milliseconds{300});
+        CHECK(w->written_bytes() == expected.size());
+
+        pfs::io::error_code ec;
+        std::string huge(options.buffer_size * options.buffer_count + 1, 'x');
+        CHECK(w->write(huge.data(), huge.size(), ec) < 0);
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+
+        REQUIRE(w->write("end", 3) == 3);
+        expected += "end";
+        REQUIRE(!w->close());
+
+        CHECK(w->write("more", 4, ec) < 0);
+    }
+
+    CHECK(read_all(tmp_path("async_file_writer.txt")) == expected);
+}
+
+TEST_CASE("Async file writer / concurrent producers") {
+    pfs::io::async_writer_options options;
+    options.buffer_size = 512;
+    options.buffer_count = 3;
+
+    int const thread_count = 8;
+    int const line_count = 1000;
+
+    {
+        auto w = pfs::io::make_async_file_writer(tmp_path("async_file_writer.txt"), options);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < thread_count; t++) {
+            threads.emplace_back([& w, t, line_count] {
+                for (int i = 0; i < line_count; i++) {
+                    auto line = std::to_string(t) + " " + std::to_string(i) + "\n";
+                    w->write(line.data(), line.size());
+                }
+            });
+        }
+
+        for (auto & th: threads)
+            th.join();
+    }
+
+    // Lines are not interleaved, order of each producer preserved
+    std::istringstream in{read_all(tmp_path("async_file_writer.txt"))};
+    std::map<int, int> next;
+    int t = 0, i = 0;
+
+    while (in >> t >> i) {
+        CHECK(next[t] == i);
+        next[t] = i + 1;
+    }
+
+    REQUIRE(next.size() == static_cast<size_t>(thread_count));
+
+    for (auto const & item: next)
+        CHECK(item.second == line_count);
+}
+
+TEST_CASE("Async file writer / overflow policy") {
+    pfs::io::async_writer_options options;
+    options.buffer_size = 16;
+    options.buffer_count = 2;
+    options.policy = pfs::io::overflow_policy::drop;
+
+    auto gate = new gated_device;
+    pfs::io::async_file_writer w {pfs::io::device{gate}, options};
+    std::string record(16, 'r');
+
+    // Background thread is stuck writing first buffer
+    REQUIRE(w.write(record.data(), record.size()) == 16);
+
+    while (w.write(record.data(), record.size()) > 0)
+        ;
+
+    CHECK(w.dropped_bytes() >= 16);
+
+    gate->released = true;
+    REQUIRE(!w.flush());
+
+    // Records are dropped entirely
+    CHECK(w.dropped_bytes() % 16 == 0);
+    CHECK(w.written_bytes() == 32);
+    CHECK(gate->data == record + record);
+}
+
+TEST_CASE("Async file writer / blocked producer") {
+    pfs::io::async_writer_options options;
+    options.buffer_size = 16;
+    options.buffer_count = 2;
+    options.flush_interval = std::chrono::milliseconds{10000};
+
+    auto gate = new gated_device;
+    gate->released = true;
+    pfs::io::async_file_writer w {pfs::io::device{gate}, options};
+
+    // Partially filled active buffer leaves not enough capacity for the
+    // second record: producer must not wait for the flush interval
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(w.write(std::string(10, 'a').data(), 10) == 10);
+    REQUIRE(w.write(std::string(30, 'b').data(), 30) == 30);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds{2});
+
+    REQUIRE(!w.flush());
+    CHECK(gate->data == std::string(10, 'a') + std::string(30, 'b'));
+}
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/binary_stream.hpp"
+#include "pfs/io/buffer.hpp"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Collects written data and counts write calls
+class counting_device : public pfs::io::basic_device
+{
+public:
+    std::string data;
+    int writes {0};
+
+    pfs::io::device_type type () const noexcept override
+    {
+        return pfs::io::device_type::buffer;
+    }
+
+    pfs::io::open_mode_flags open_mode () const noexcept override
+    {
+        return pfs::io::write_only;
+    }
+
+    bool has_pending_data () noexcept override
+    {
+        return false;
+    }
+
+    ssize_t read (char *, size_t, pfs::io::error_code & ec) noexcept override
+    {
+        ec = pfs::io::make_error_code(pfs::io::errc::invalid_argument);
+        return -1;
+    }
+
+    ssize_t write (char const * bytes, size_t n, pfs::io::error_code &) noexcept override
+    {
+        data.append(bytes, n);
+        writes++;
+        return static_cast<ssize_t>(n);
+    }
+
+    pfs::io::error_code close () override
+    {
+        return pfs::io::error_code{};
+    }
+
+    bool opened () const noexcept override
+    {
+        return true;
+    }
+};
+
+TEST_CASE("Binary stream / byte order") {
+    counting_device d;
+
+    pfs::io::basic_binary_writer<counting_device, pfs::io::endian::big> be {d};
+    be.write(std::uint32_t{0x01020304}).write(std::int16_t{-2}).flush();
+    CHECK(d.data == std::string{"\x01\x02\x03\x04\xFF\xFE", 6});
+
+    d.data.clear();
+    pfs::io::basic_binary_writer<counting_device, pfs::io::endian::little> le {d};
+    le.write(std::uint32_t{0x01020304}).write(std::uint8_t{5}).write(true).flush();
+    CHECK(d.data == std::string{"\x04\x03\x02\x01\x05\x01", 6});
+
+    d.data.clear();
+    be.write(1.0).flush();
+    CHECK(d.data == std::string{"\x3F\xF0\x00\x00\x00\x00\x00\x00", 8});
+}
+
+TEST_CASE("Binary stream / zigzag") {
+    CHECK(pfs::io::zigzag_encode(0) == 0);
+    CHECK(pfs::io::zigzag_encode(-1) == 1);
+    CHECK(pfs::io::zigzag_encode(1) == 2);
+    CHECK(pfs::io::zigzag_encode(-2) == 3);
+    CHECK(pfs::io::zigzag_encode(std::numeric_limits<std::int64_t>::max()) == ~std::uint64_t{1});
+    CHECK(pfs::io::zigzag_encode(std::numeric_limits<std::int64_t>::min()) == ~std::uint64_t{0});
+
+    for (std::int64_t v: {std::int64_t{0}, std::int64_t{-1}, std::int64_t{63}, std::int64_t{-64}
+            , std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()}) {
+        CHECK(pfs::io::zigzag_decode(pfs::io::zigzag_encode(v)) == v);
+    }
+}
+
+TEST_CASE("Binary stream / round trip") {
+    counting_device d;
+    pfs::io::basic_binary_writer<counting_device> writer {d, 16};
+    std::string long_string(1000, 'x');
+    int const message_count = 10;
+
+    for (int i = 0; i < message_count; i++) {
+        writer.write(static_cast<std::uint32_t>(i))
+            .write(static_cast<std::int64_t>(-i))
+            .write(0.5 * i)
+            .write(1.5f)
+            .write(i % 2 == 0)
+            .write_varint(std::uint64_t{1} << (i * 6))
+            .write_zigzag(-300 * i)
+            .write_string("name" + std::to_string(i))
+            .write_string(long_string);
+
+        CHECK(writer.size() > 0);
+        writer.flush();
+        CHECK(writer.size() == 0);
+    }
+
+    // One write per message
+    CHECK(d.writes == message_count);
+
+    for (size_t buffer_size: {size_t{1}, size_t{7}, size_t{64 * 1024}}) {
+        auto source = d.data;
+        auto r = pfs::io::make_buffer(source, pfs::io::read_only);
+
+        pfs::io::binary_reader_options options;
+        options.buffer_size = buffer_size;
+        pfs::io::binary_reader reader {r, options};
+
+        for (int i = 0; i < message_count; i++) {
+            std::uint32_t u32 = 0;
+            std::int64_t i64 = 0;
+            double f64 = 0;
+            float f32 = 0;
+            bool b = false;
+            std::uint64_t varint = 0;
+            std::int64_t zigzag = 0;
+            std::string name;
+            pfs::io::bytes_view view;
+
+            REQUIRE(reader.read(u32));
+            REQUIRE(reader.read(i64));
+            REQUIRE(reader.read(f64));
+            REQUIRE(reader.read(f32));
+            REQUIRE(reader.read(b));
+            REQUIRE(reader.read_varint(varint));
+            REQUIRE(reader.read_zigzag(zigzag));
+            REQUIRE(reader.read_string(name));
+            REQUIRE(reader.read_string(view));
+
+            CHECK(u32 == static_cast<std::uint32_t>(i));
+            CHECK(i64 == -i);
+            CHECK(f64 == 0.5 * i);
+            CHECK(f32 == 1.5f);
+            CHECK(b == (i % 2 == 0));
+            CHECK(varint == std::uint64_t{1} << (i * 6));
+            CHECK(zigzag == -300 * i);
+            CHECK(name == "name" + std::to_string(i));
+            CHECK(view == pfs::io::bytes_view{long_string});
+        }
+
+        std::uint8_t byte = 0;
+        CHECK_FALSE(reader.read(byte));
+        CHECK(reader.at_end());
+    }
+}
+
+TEST_CASE("Binary stream / bulk varints") {
+    std::vector<std::uint64_t> values;
+
+    for (std::uint64_t i = 0; i < 1000; i++)
+        values.push_back(i % 3 == 0 ? i * i * i : i % 100);
+
+    std::string wire;
+
+    {
+        auto d = pfs::io::make_buffer(wire, pfs::io::write_only);
+        pfs::io::binary_writer writer {d};
+        writer.write_varints(values.data(), values.size()).write(std::uint8_t{0xAA}).flush();
+    }
+
+    auto d = pfs::io::make_buffer(wire, pfs::io::read_only);
+    pfs::io::binary_reader_options options;
+    options.buffer_size = 13;
+    pfs::io::binary_reader reader {d, options};
+
+    std::vector<std::uint64_t> result(values.size());
+    CHECK(reader.read_varints(result.data(), result.size()) == values.size());
+    CHECK(result == values);
+
+    std::uint8_t tail = 0;
+    REQUIRE(reader.read(tail));
+    CHECK(tail == 0xAA);
+    CHECK(reader.read_varints(result.data(), result.size()) == 0);
+    CHECK(reader.at_end());
+}
+
+TEST_CASE("Binary stream / errors") {
+    pfs::io::error_code ec;
+
+    // Truncated field
+    {
+        std::string source {"\x00\x01", 2};
+        auto r = pfs::io::make_static_buffer(source, pfs::io::read_only);
+        pfs::io::basic_binary_reader<decltype(r)> reader {r};
+        std::uint32_t value = 0;
+
+        CHECK_FALSE(reader.read(value, ec));
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::bad_message));
+    }
+
+    // Oversized string
+    {
+        std::string source {"\x10" "0123456789abcdef"};
+        auto r = pfs::io::make_buffer(source, pfs::io::read_only);
+        pfs::io::binary_reader_options options;
+        options.max_string_size = 8;
+        pfs::io::binary_reader reader {r, options};
+        std::string s;
+
+        ec.clear();
+        CHECK_FALSE(reader.read_string(s, ec));
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+    }
+
+    // Malformed varint
+    {
+        std::string source(11, '\xFF');
+        auto r = pfs::io::make_buffer(source, pfs::io::read_only);
+        pfs::io::binary_reader reader {r};
+        std::uint64_t value = 0;
+
+        CHECK_THROWS_AS(reader.read_varint(value), pfs::io::exception);
+    }
+}
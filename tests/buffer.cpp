@@ -127,3 +127,78 @@ TEST_CASE("Buffer / write") {
     REQUIRE(ec == std::error_code{});
     CHECK(result == loremipsum);
 }
+
+TEST_CASE("Buffer / writev") {
+    std::string result;
+    auto d = pfs::io::make_buffer(result, pfs::io::write_only);
+    std::error_code ec;
+
+    char hello[] = "Hello";
+    char world[] = ", World!";
+    pfs::io::io_vector iov[2] = {{hello, 5}, {world, 8}};
+
+    // Default implementation writes buffers one by one
+    REQUIRE(d.writev(iov, 2, ec) == 13);
+    CHECK(result == "Hello, World!");
+}
+
+TEST_CASE("Buffer / static") {
+    std::string sample{loremipsum, std::strlen(loremipsum)};
+    std::string result;
+
+    auto src = pfs::io::make_static_buffer(sample, pfs::io::read_only);
+    auto dst = pfs::io::make_static_buffer(result, pfs::io::write_only);
+
+    REQUIRE(src.type() == pfs::io::device_type::buffer);
+    REQUIRE(src.opened());
+    CHECK(src.is_readable());
+    CHECK_FALSE(src.is_writable());
+    CHECK(dst.is_writable());
+
+    std::error_code ec;
+    char buf[32];
+    ssize_t n = 0;
+
+    while ((n = src.read(buf, sizeof(buf), ec)) > 0) {
+        REQUIRE(dst.write(buf, n, ec) == n);
+    }
+
+    REQUIRE(ec == std::error_code{});
+    CHECK(result == sample);
+
+    src.close();
+    CHECK_FALSE(src.opened());
+    CHECK(src.is_null());
+}
+
+TEST_CASE("Buffer / random access") {
+    std::string sample{"0123456789"};
+    pfs::io::buffer<std::string> b{sample, pfs::io::read_write};
+    std::error_code ec;
+    char buf[4];
+
+    REQUIRE(b.read_at(buf, 4, 3, ec) == 4);
+    CHECK(std::string(buf, 4) == "3456");
+    CHECK(b.tell(ec) == 0);
+
+    REQUIRE(b.read_at(buf, 4, 8, ec) == 2);
+    CHECK(b.read_at(buf, 4, 20, ec) == 0);
+
+    CHECK(b.seek(-3, pfs::io::seek_origin::end, ec) == 7);
+    REQUIRE(b.read(buf, 4, ec) == 3);
+    CHECK(std::string(buf, 3) == "789");
+    CHECK(b.tell(ec) == 10);
+
+    CHECK(b.seek(-1, pfs::io::seek_origin::begin, ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    ec = std::error_code{};
+
+    REQUIRE(b.write_at("ab", 2, 1, ec) == 2);
+    CHECK(sample == "0ab3456789");
+
+    REQUIRE(b.write_at("XYZ", 3, 9, ec) == 3);
+    CHECK(sample == "0ab345678XYZ");
+
+    CHECK(b.write_at("!", 1, 20, ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+}
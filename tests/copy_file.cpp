@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Added self-copy test
+//      2026.10.19 Added empty source test
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/copy_file.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static pfs::io::offset_type const MiB = 1024 * 1024;
+
+static std::string src_path ()
+{
+    return tmp_dir() + "/copy_file_src.bin";
+}
+
+static std::string dest_path ()
+{
+    return tmp_dir() + "/copy_file_dest.bin";
+}
+
+// Source layout: data, hole, data, trailing hole
+static void make_source ()
+{
+    auto d = pfs::io::make_file(src_path()
+        , pfs::io::write_only | pfs::io::truncate
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::none);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    pfs::io::error_code ec;
+    std::string block(64 * 1024, 'a');
+
+    REQUIRE(f->write_at(loremipsum, std::strlen(loremipsum), 0, ec) > 0);
+    REQUIRE(f->write_at(block.data(), block.size(), MiB, ec) > 0);
+    REQUIRE(!f->resize(3 * MiB));
+}
+
+static pfs::io::offset_type allocated_bytes (std::string const & path)
+{
+    struct stat st;
+    REQUIRE(::stat(path.c_str(), & st) == 0);
+    return static_cast<pfs::io::offset_type>(st.st_blocks) * 512;
+}
+
+TEST_CASE("Copy file / basic") {
+    pfs::io::error_code ec;
+    auto method = pfs::io::copy_file("!@#$%", dest_path(), ec);
+    CHECK(method == pfs::io::copy_method::none);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::file_not_found));
+    REQUIRE_THROWS_AS(pfs::io::copy_file("!@#$%", dest_path()), pfs::io::exception);
+}
+
+TEST_CASE("Copy file / methods") {
+    make_source();
+    auto expected = read_all(src_path());
+    REQUIRE(expected.size() == static_cast<size_t>(3 * MiB));
+
+    struct {
+        char const * name;
+        bool reflink;
+        bool copy_file_range;
+        bool sendfile;
+    } cases[] = {
+          {"default" , true , true , true }
+        , {"copy_file_range", false, true , true }
+        , {"sendfile", false, false, true }
+        , {"buffered", false, false, false}
+    };
+
+    for (auto const & c: cases) {
+        INFO(c.name);
+
+        pfs::io::copy_options options;
+        options.allow_reflink = c.reflink;
+        options.allow_copy_file_range = c.copy_file_range;
+        options.allow_sendfile = c.sendfile;
+        options.buffer_size = 256 * 1024;
+
+        pfs::io::error_code ec;
+        auto method = pfs::io::copy_file(src_path(), dest_path(), options, ec);
+
+        REQUIRE(!ec);
+        REQUIRE(method != pfs::io::copy_method::none);
+
+        if (!c.reflink)
+            CHECK(method != pfs::io::copy_method::reflink);
+
+        if (!c.copy_file_range)
+            CHECK(method != pfs::io::copy_method::copy_file_range);
+
+        if (!c.sendfile && !c.copy_file_range)
+            CHECK(method == pfs::io::copy_method::buffered);
+
+        CHECK(read_all(dest_path()) == expected);
+
+        // Holes are preserved (with some slack for file system metadata)
+        CHECK(allocated_bytes(dest_path()) < MiB);
+    }
+}
+
+TEST_CASE("Copy file / empty source") {
+    pfs::io::make_file(src_path()
+        , pfs::io::write_only | pfs::io::truncate
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::none);
+
+    pfs::io::copy_options options;
+    options.allow_reflink = false;
+
+    // No data, no method
+    pfs::io::error_code ec;
+    auto method = pfs::io::copy_file(src_path(), dest_path(), options, ec);
+    CHECK(!ec);
+    CHECK(method == pfs::io::copy_method::none);
+    CHECK(read_all(dest_path()).empty());
+}
+
+TEST_CASE("Copy file / onto itself") {
+    make_source();
+    auto expected = read_all(src_path());
+    std::string link_path = tmp_dir() + "/copy_file_link.bin";
+
+    ::unlink(link_path.c_str());
+    REQUIRE(::symlink(src_path().c_str(), link_path.c_str()) == 0);
+
+    for (auto const & path: {src_path(), link_path}) {
+        pfs::io::error_code ec;
+        auto method = pfs::io::copy_file(src_path(), path, ec);
+        CHECK(method == pfs::io::copy_method::none);
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    }
+
+    ::unlink(link_path.c_str());
+
+    // Source is intact
+    CHECK(read_all(src_path()) == expected);
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/buffer.hpp"
+#include "pfs/io/delimited_reader.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+static std::vector<pfs::io::simd_isa> const ISAS {
+      pfs::io::simd_isa::scalar
+    , pfs::io::simd_isa::sse2
+    , pfs::io::simd_isa::avx2
+};
+
+static std::vector<std::string> split (std::string const & s, std::string const & delimiter)
+{
+    std::vector<std::string> result;
+    size_t pos = 0;
+
+    for (;;) {
+        auto p = s.find(delimiter, pos);
+
+        if (p == std::string::npos) {
+            if (pos < s.size())
+                result.push_back(s.substr(pos));
+            break;
+        }
+
+        result.push_back(s.substr(pos, p - pos));
+        pos = p + delimiter.size();
+    }
+
+    return result;
+}
+
+TEST_CASE("Delimited reader / find byte") {
+    std::string haystack(300, 'a');
+
+    for (auto isa: ISAS) {
+        auto find = pfs::io::details::select_find_byte(isa);
+
+        for (size_t len = 0; len < haystack.size(); len += 7) {
+            auto first = haystack.data();
+            auto last = first + len;
+
+            // Not found
+            CHECK(find(first, last, 'x') == last);
+
+            for (size_t pos = 0; pos < len; pos++) {
+                haystack[pos] = 'x';
+
+                // Second occurrence must not be taken for the first one
+                if (pos + 3 < len)
+                    haystack[pos + 3] = 'x';
+
+                CHECK(find(first, last, 'x') == first + pos);
+
+                haystack[pos] = 'a';
+
+                if (pos + 3 < len)
+                    haystack[pos + 3] = 'a';
+            }
+        }
+
+        // High bytes
+        std::string bytes(100, '\x7F');
+        bytes[77] = '\x80';
+        CHECK(find(bytes.data(), bytes.data() + bytes.size(), '\x80') == bytes.data() + 77);
+    }
+
+    auto end = loremipsum + sizeof(loremipsum) - 1;
+    CHECK(pfs::io::find_byte(loremipsum, end, '\n') == std::find(loremipsum, end, '\n'));
+}
+
+TEST_CASE("Delimited reader / records") {
+    std::string source {loremipsum};
+
+    struct {
+        std::string content;
+        std::string delimiter;
+    } samples[] = {
+          {source, "\n"}
+        , {source + "no trailing delimiter", "\n"}
+        , {"\n\nempty\n\nrecords\n", "\n"}
+        , {"a\r\nb\rc\r\n\r\nd", "\r\n"}
+        , {source, "dolor"}
+    };
+
+    for (auto const & sample: samples) {
+        auto expected = split(sample.content, sample.delimiter);
+
+        for (auto isa: ISAS) {
+            for (size_t buffer_size: {size_t{1}, size_t{3}, size_t{64}, size_t{64 * 1024}}) {
+                std::string content = sample.content;
+                auto d = pfs::io::make_buffer(content, pfs::io::read_only);
+
+                pfs::io::delimited_reader_options options;
+                options.delimiter = sample.delimiter;
+                options.buffer_size = buffer_size;
+                options.isa = isa;
+
+                pfs::io::delimited_reader reader {d, options};
+                pfs::io::bytes_view record;
+                std::vector<std::string> result;
+
+                while (reader.read_record(record))
+                    result.push_back(record.to_string());
+
+                CHECK(reader.at_end());
+                CHECK(result == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Delimited reader / static device and limits") {
+    std::string content = "short\n" + std::string(100, 'x') + "\nshort\n";
+    auto d = pfs::io::make_static_buffer(content, pfs::io::read_only);
+
+    pfs::io::delimited_reader_options options;
+    options.buffer_size = 8;
+    options.max_record_size = 50;
+
+    pfs::io::basic_delimited_reader<decltype(d)> reader {d, options};
+    pfs::io::bytes_view record;
+    pfs::io::error_code ec;
+
+    REQUIRE(reader.read_record(record, ec));
+    CHECK(record == pfs::io::bytes_view{"short", 5});
+
+    CHECK_FALSE(reader.read_record(record, ec));
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+    CHECK_THROWS_AS(reader.read_record(record), pfs::io::exception);
+}
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Loss statistics and late packets
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/fec.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using packet_list = std::vector<std::string>;
+
+static std::string make_payload (int i)
+{
+    return std::string(static_cast<size_t>(i * 53 % 1000), static_cast<char>('a' + i % 26))
+        + std::to_string(i);
+}
+
+static packet_list encode (pfs::io::fec_options const & options, int count, bool flush)
+{
+    packet_list packets;
+    pfs::io::fec_encoder encoder {options};
+    pfs::io::error_code ec;
+    auto send = [& packets] (char const * data, size_t n, pfs::io::error_code &) {
+        packets.emplace_back(data, n);
+        return true;
+    };
+
+    for (int i = 0; i < count; i++) {
+        auto payload = make_payload(i);
+        REQUIRE(encoder.encode(payload.data(), payload.size(), send, ec));
+    }
+
+    if (flush)
+        REQUIRE(encoder.flush(send, ec));
+
+    return packets;
+}
+
+static std::multiset<std::string> decode (pfs::io::fec_decoder & decoder, packet_list const & packets)
+{
+    std::multiset<std::string> received;
+    pfs::io::error_code ec;
+
+    for (auto const & p: packets) {
+        CHECK(decoder.decode(p.data(), p.size(), [& received] (char const * data, size_t n) {
+            received.emplace(data, n);
+        }, ec));
+    }
+
+    return received;
+}
+
+TEST_CASE("FEC / GF(2^8) kernels") {
+    for (int a = 1; a < 256; a++) {
+        auto x = static_cast<std::uint8_t>(a);
+        CHECK(pfs::io::gf256_mul(x, pfs::io::gf256_inv(x)) == 1);
+        CHECK(pfs::io::gf256_mul(x, 0) == 0);
+    }
+
+    std::mt19937 gen {1};
+    auto scalar = pfs::io::details::select_gf256_kernels(pfs::io::simd_isa::scalar);
+
+    for (auto isa: {pfs::io::simd_isa::ssse3, pfs::io::simd_isa::avx2}) {
+        if (!pfs::io::simd_isa_supported(isa))
+            continue;
+
+        auto kernels = pfs::io::details::select_gf256_kernels(isa);
+
+        for (size_t n: {size_t{0}, size_t{1}, size_t{15}, size_t{33}, size_t{100}, size_t{1500}}) {
+            std::string src(n, '\0');
+            std::string dst(n, '\0');
+
+            for (auto & c: src) c = static_cast<char>(gen());
+            for (auto & c: dst) c = static_cast<char>(gen());
+
+            for (int c = 0; c < 256; c++) {
+                auto coef = static_cast<std::uint8_t>(c);
+                auto expected = dst;
+                auto result = dst;
+
+                scalar.mul_add_region(coef, & src[0], & expected[0], n);
+                kernels.mul_add_region(coef, & src[0], & result[0], n);
+                REQUIRE(result == expected);
+
+                scalar.mul_region(coef, & src[0], & expected[0], n);
+                kernels.mul_region(coef, & src[0], & result[0], n);
+                REQUIRE(result == expected);
+            }
+
+            auto expected = dst;
+            scalar.xor_region(& src[0], & expected[0], n);
+            kernels.xor_region(& src[0], & dst[0], n);
+            CHECK(dst == expected);
+        }
+    }
+}
+
+TEST_CASE("FEC / XOR parity") {
+    pfs::io::fec_options options;
+    options.source_count = 4;
+    options.repair_count = 1;
+
+    // Two full groups and one closed by flush()
+    auto packets = encode(options, 10, true);
+    REQUIRE(packets.size() == 10 + 3);
+
+    // One source packet of every group is lost
+    packet_list lossy;
+
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (i != 1 && i != 5 && i != 10)
+            lossy.push_back(packets[i]);
+    }
+
+    pfs::io::fec_decoder decoder {options};
+    auto received = decode(decoder, lossy);
+
+    CHECK(received.size() == 10);
+
+    for (int i = 0; i < 10; i++)
+        CHECK(received.count(make_payload(i)) == 1);
+
+    CHECK(decoder.stats().recovered == 3);
+    CHECK(decoder.stats().unrecoverable == 0);
+
+    // Duplicates are dropped
+    decode(decoder, packets);
+    CHECK(decoder.stats().duplicates == packets.size());
+}
+
+TEST_CASE("FEC / loss statistics") {
+    pfs::io::fec_options options;
+    options.source_count = 4;
+    options.repair_count = 1;
+    options.decoder_window = 2;
+
+    auto packets = encode(options, 16, false);
+    REQUIRE(packets.size() == 20);
+
+    // Group 0 loses source 1 and the repair packet, group 1 loses trailing
+    // source 3 and the repair packet (can not be told from early closed group)
+    packet_list lossy;
+
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (i != 1 && i != 4 && i != 8 && i != 9)
+            lossy.push_back(packets[i]);
+    }
+
+    pfs::io::fec_decoder decoder {options};
+    auto received = decode(decoder, lossy);
+
+    CHECK(received.size() == 14);
+    CHECK(decoder.stats().recovered == 0);
+    CHECK(decoder.stats().unrecoverable == 1);
+
+    // Groups 0 and 1 are given up
+    decode(decoder, packet_list{packets[0], packets[5]});
+    CHECK(decoder.stats().late == 2);
+    CHECK(decoder.stats().duplicates == 0);
+
+    decode(decoder, packet_list{packets[15]});
+    CHECK(decoder.stats().late == 2);
+    CHECK(decoder.stats().duplicates == 1);
+}
+
+TEST_CASE("FEC / Reed-Solomon") {
+    pfs::io::fec_options options;
+    options.source_count = 10;
+    options.repair_count = 4;
+    options.decoder_window = 4;
+
+    int const group_count = 200;
+    auto packets = encode(options, 10 * group_count, false);
+    REQUIRE(packets.size() == 14 * group_count);
+
+    std::mt19937 gen {2};
+    packet_list lossy;
+    size_t group0_lost = 0;
+
+    for (int g = 0; g < group_count; g++) {
+        // Up to repair_count losses are recovered, group 0 loses more
+        std::vector<size_t> indices(14);
+
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = i;
+
+        std::shuffle(indices.begin(), indices.end(), gen);
+        auto losses = g == 0 ? size_t{5} : static_cast<size_t>(gen() % 5);
+        std::set<size_t> lost(indices.begin(), indices.begin() + losses);
+
+        for (size_t i = 0; i < 14; i++) {
+            if (lost.count(i) == 0)
+                lossy.push_back(packets[g * 14 + i]);
+            else if (i < 10 && g == 0)
+                group0_lost++;
+        }
+    }
+
+    // Packets are reordered within groups
+    for (size_t i = 0; i + 1 < lossy.size(); i += 2)
+        std::swap(lossy[i], lossy[i + 1]);
+
+    pfs::io::fec_decoder decoder {options};
+    auto received = decode(decoder, lossy);
+
+    CHECK(decoder.stats().recovered > 0);
+    CHECK(decoder.stats().unrecoverable == group0_lost);
+    CHECK(received.size() == 10 * group_count - group0_lost);
+
+    for (int i = 10; i < 10 * group_count; i++)
+        CHECK(received.count(make_payload(i)) == 1);
+
+    // Malformed packet
+    pfs::io::error_code ec;
+    CHECK_FALSE(decoder.decode("\x00\x01", 2, [] (char const *, size_t) {}, ec));
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::bad_message));
+
+    // Oversized payload
+    pfs::io::fec_encoder encoder {options};
+    std::string oversized(options.max_payload + 1, 'x');
+    ec.clear();
+    CHECK_FALSE(encoder.encode(oversized.data(), oversized.size()
+        , [] (char const *, size_t, pfs::io::error_code &) { return true; }, ec));
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+}
+
+// Drops every seventh datagram
+class lossy_socket
+{
+    pfs::io::udp_socket * _s;
+    int _count {0};
+
+public:
+    lossy_socket (pfs::io::udp_socket & s) : _s(& s) {}
+
+    ssize_t write (char const * bytes, size_t n, pfs::io::error_code & ec)
+    {
+        if (++_count % 7 == 0)
+            return static_cast<ssize_t>(n);
+
+        return _s->write(bytes, n, ec);
+    }
+
+    ssize_t read (char * bytes, size_t n, pfs::io::error_code & ec)
+    {
+        return _s->read(bytes, n, ec);
+    }
+};
+
+TEST_CASE("FEC / UDP channel") {
+    pfs::io::fec_options options;
+    options.source_count = 6;
+    options.repair_count = 2;
+
+    auto server = pfs::io::make_udp_server("127.0.0.1", 41990, false);
+    auto client = pfs::io::make_static_udp_socket("127.0.0.1", 41990, false);
+    lossy_socket lossy {client.underlying()};
+
+    pfs::io::basic_fec_channel<lossy_socket> sender {lossy, options};
+    pfs::io::basic_fec_channel<pfs::io::udp_socket> receiver {server, options};
+
+    int const count = 60;
+    pfs::io::error_code ec;
+
+    for (int i = 0; i < count; i++) {
+        auto payload = make_payload(i);
+        REQUIRE(sender.write(payload.data(), payload.size(), ec) == static_cast<ssize_t>(payload.size()));
+    }
+
+    CHECK_FALSE(sender.flush());
+
+    std::set<std::string> received;
+    std::string payload;
+
+    while (received.size() < count && receiver.read(payload, ec))
+        received.insert(payload);
+
+    CHECK_FALSE(ec);
+    CHECK(received.size() == count);
+    CHECK(receiver.stats().recovered > 0);
+}
@@ -10,17 +10,19 @@
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include "pfs/io/aligned_allocator.hpp"
 #include "pfs/io/file.hpp"
+#include "pfs/io/group_commit.hpp"
 #include "utils.hpp"
+#include <algorithm>
 #include <cstring>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 // TODO Make real unique filename
-static std::string tmp_path ()
-{
-    return tmp_dir() + "/loremipsum.txt";
-}
-
 static std::string test_file_path;
 
 TEST_CASE("File / basic") {
@@ -33,7 +35,7 @@ TEST_CASE("File / basic") {
 TEST_CASE("File / write") {
     std::string source{loremipsum};
     std::error_code ec;
-    test_file_path = tmp_path();
+    test_file_path = tmp_path("loremipsum.txt");
     auto d = pfs::io::make_file(test_file_path, pfs::io::write_only, ec);
 
     if (ec)
@@ -71,7 +73,7 @@ TEST_CASE("File / write") {
 
 TEST_CASE("File / read") {
     std::error_code ec;
-    test_file_path = tmp_path();
+    test_file_path = tmp_path("loremipsum.txt");
     auto d = pfs::io::make_file(test_file_path, pfs::io::read_only, ec);
 
     if (ec)
@@ -102,3 +104,549 @@ TEST_CASE("File / read") {
     REQUIRE(!ec);
     CHECK(result == loremipsum);
 }
+
+TEST_CASE("File / static") {
+    std::error_code ec;
+    auto d = pfs::io::make_static_file("!@#$%", pfs::io::read_only, ec);
+    REQUIRE(d.is_null());
+    REQUIRE_THROWS_AS(pfs::io::make_static_file("!@#$%", pfs::io::read_only)
+        , pfs::io::exception);
+
+    ec = std::error_code{};
+    test_file_path = tmp_path("loremipsum.txt");
+    auto f = pfs::io::make_static_file(test_file_path, pfs::io::read_only, ec);
+
+    REQUIRE(!ec);
+    REQUIRE(f.opened());
+    REQUIRE(f.type() == pfs::io::device_type::file);
+    REQUIRE(f.is_readable());
+
+    char buf[32];
+    ssize_t n = 0;
+    std::string result;
+
+    while ((n = f.read(buf, sizeof(buf), ec)) > 0) {
+        result.append(buf, n);
+    }
+
+    REQUIRE(!ec);
+    CHECK(result == loremipsum);
+}
+
+TEST_CASE("File / random access") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/random_access.bin";
+    auto d = pfs::io::make_file(path
+        , pfs::io::read_write | pfs::io::truncate, ec);
+
+    REQUIRE(!ec);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    REQUIRE(f != nullptr);
+
+    std::string source{loremipsum};
+    auto size = static_cast<pfs::io::offset_type>(source.size());
+    auto half = size / 2;
+
+    // Write second half first, then first half
+    REQUIRE(f->write_at(source.data() + half, source.size() - half, half, ec) == size - half);
+    REQUIRE(f->write_at(source.data(), half, 0, ec) == half);
+
+    // Positional writes do not move file position
+    CHECK(f->tell(ec) == 0);
+    CHECK(f->seek(0, pfs::io::seek_origin::end, ec) == size);
+    CHECK(f->seek(-10, pfs::io::seek_origin::current, ec) == size - 10);
+
+    char tail[10];
+    REQUIRE(d.read(tail, sizeof(tail), ec) == 10);
+    CHECK(std::string(tail, 10) == source.substr(source.size() - 10));
+
+    // Vectored read
+    char head[5];
+    char next[7];
+    pfs::io::io_vector iov[2] = {{head, sizeof(head)}, {next, sizeof(next)}};
+    REQUIRE(f->read_at(iov, 2, 2, ec) == 12);
+    CHECK(std::string(head, 5) == source.substr(2, 5));
+    CHECK(std::string(next, 7) == source.substr(7, 7));
+
+    // Concurrent reads from the same descriptor
+    int const THREADS = 4;
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(THREADS);
+    std::atomic<int> failures {0};
+
+    for (int i = 0; i < THREADS; i++) {
+        threads.emplace_back([f, i, size, & results, & failures] {
+            std::error_code ec;
+            auto chunk = size / THREADS;
+            auto offset = chunk * i;
+            auto n = i == THREADS - 1 ? size - offset : chunk;
+            std::string buf(static_cast<size_t>(n), '\0');
+
+            for (int j = 0; j < 100; j++) {
+                auto r = f->read_at(& buf[0], buf.size(), offset, ec);
+
+                if (r != n)
+                    ++failures;
+            }
+
+            results[i] = buf;
+        });
+    }
+
+    for (auto & t: threads)
+        t.join();
+
+    REQUIRE(failures == 0);
+
+    std::string result;
+
+    for (auto const & r: results)
+        result += r;
+
+    CHECK(result == source);
+}
+
+TEST_CASE("File / writev") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/writev.bin";
+    auto d = pfs::io::make_file(path, pfs::io::write_only | pfs::io::truncate, ec);
+
+    REQUIRE(!ec);
+
+    std::string source{loremipsum};
+    auto half = source.size() / 2;
+    pfs::io::io_vector iov[2] = {
+          {& source[0], half}
+        , {& source[half], source.size() - half}
+    };
+
+    REQUIRE(d.writev(iov, 2, ec) == static_cast<ssize_t>(source.size()));
+    d.close();
+
+    auto r = pfs::io::make_file(path, pfs::io::read_only);
+    std::string result(source.size(), '\0');
+    REQUIRE(r.read(& result[0], result.size()) == static_cast<ssize_t>(source.size()));
+    CHECK(result == source);
+}
+
+TEST_CASE("File / durability") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/durability.bin";
+
+    for (auto policy: {pfs::io::durability::none
+            , pfs::io::durability::data_sync
+            , pfs::io::durability::full_sync
+            , pfs::io::durability::writeback}) {
+        auto d = pfs::io::make_file(path
+            , pfs::io::write_only | pfs::io::truncate
+            , pfs::io::owner_read | pfs::io::owner_write
+            , policy
+            , ec);
+
+        REQUIRE(!ec);
+
+        auto f = pfs::io::underlying_device<pfs::io::file>(d);
+        REQUIRE(f != nullptr);
+        CHECK(f->durability_policy() == policy);
+
+        REQUIRE(d.write(loremipsum, std::strlen(loremipsum), ec) > 0);
+        CHECK(!f->sync(policy));
+        CHECK(!d.close());
+    }
+}
+
+TEST_CASE("File / group commit") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/group_commit.bin";
+    auto d = pfs::io::make_file(path
+        , pfs::io::write_only | pfs::io::truncate
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::none
+        , ec);
+
+    REQUIRE(!ec);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    pfs::io::group_commit gc{*f};
+
+    int const WRITERS = 8;
+    int const RECORDS = 50;
+    std::atomic<int> failures {0};
+    std::vector<std::thread> writers;
+
+    for (int i = 0; i < WRITERS; i++) {
+        writers.emplace_back([f, i, & gc, & failures] {
+            char record[16];
+            std::memset(record, 'a' + i, sizeof(record));
+
+            for (int j = 0; j < RECORDS; j++) {
+                std::error_code ec;
+                pfs::io::offset_type offset = (j * WRITERS + i) * sizeof(record);
+
+                if (f->write_at(record, sizeof(record), offset, ec) < 0 || gc.sync())
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto & t: writers)
+        t.join();
+
+    CHECK(failures == 0);
+    CHECK(gc.sync_count() > 0);
+    CHECK(gc.sync_count() <= static_cast<std::uint64_t>(WRITERS * RECORDS));
+    CHECK(f->seek(0, pfs::io::seek_origin::end, ec) == WRITERS * RECORDS * 16);
+}
+
+// Flush takes a while, so writers arriving meanwhile must be batched
+struct slow_sync_file
+{
+    std::atomic<int> syncs {0};
+
+    std::error_code sync (pfs::io::durability)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        ++syncs;
+        return std::error_code{};
+    }
+};
+
+TEST_CASE("File / group commit batching") {
+    slow_sync_file f;
+    pfs::io::basic_group_commit<slow_sync_file> gc{f};
+
+    int const WRITERS = 8;
+    int const RECORDS = 10;
+    std::atomic<int> ready {0};
+    std::atomic<int> failures {0};
+    std::vector<std::thread> writers;
+
+    for (int i = 0; i < WRITERS; i++) {
+        writers.emplace_back([& gc, & ready, & failures] {
+            // Gate: all writers start syncing together
+            ++ready;
+
+            while (ready < WRITERS)
+                std::this_thread::yield();
+
+            for (int j = 0; j < RECORDS; j++) {
+                if (gc.sync())
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto & t: writers)
+        t.join();
+
+    CHECK(failures == 0);
+    CHECK(gc.sync_count() == static_cast<std::uint64_t>(f.syncs));
+    CHECK(gc.sync_count() < static_cast<std::uint64_t>(WRITERS * RECORDS));
+}
+
+// Every flush fails with its own number as error value
+struct numbered_sync_file
+{
+    std::atomic<int> started {0};
+
+    std::error_code sync (pfs::io::durability)
+    {
+        auto n = ++started;
+        return std::error_code{n, std::generic_category()};
+    }
+};
+
+TEST_CASE("File / group commit result") {
+    numbered_sync_file f;
+    pfs::io::basic_group_commit<numbered_sync_file> gc{f};
+
+    int const WRITERS = 8;
+    int const RECORDS = 500;
+    std::atomic<int> failures {0};
+    std::vector<std::thread> writers;
+
+    for (int i = 0; i < WRITERS; i++) {
+        writers.emplace_back([& f, & gc, & failures] {
+            for (int j = 0; j < RECORDS; j++) {
+                // Flush running at the moment does not cover this call, the
+                // next one started does (or the one after it if a flush
+                // starts before this call takes its ticket)
+                auto before = f.started.load();
+                auto ec = gc.sync();
+
+                if (ec.value() <= before || ec.value() > before + 2)
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto & t: writers)
+        t.join();
+
+    CHECK(failures == 0);
+    CHECK(gc.sync_count() == static_cast<std::uint64_t>(f.started));
+}
+
+TEST_CASE("File / direct I/O") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/direct.bin";
+    auto d = pfs::io::make_file(path
+        , pfs::io::read_write | pfs::io::truncate | pfs::io::direct, ec);
+
+    // Some file systems (e.g. tmpfs) do not support direct I/O
+    if (ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument)) {
+        MESSAGE("Direct I/O is not supported for: " << path);
+        return;
+    }
+
+    REQUIRE(!ec);
+    CHECK((d.open_mode() & pfs::io::direct) != 0);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    auto alignment = f->direct_io_alignment();
+    REQUIRE(alignment > 0);
+    REQUIRE(alignment <= 4096);
+
+    // Two aligned blocks followed by unaligned tail
+    pfs::io::aligned_buffer<4096> out(2 * alignment + 100);
+
+    for (size_t i = 0; i < out.size(); i++)
+        out[i] = static_cast<char>(i % 251);
+
+    REQUIRE(d.write(out.data(), out.size(), ec) == static_cast<ssize_t>(out.size()));
+    REQUIRE(!ec);
+
+    // Unaligned buffer address is rejected
+    CHECK(f->write_at(out.data() + 1, alignment, 0, ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    ec = std::error_code{};
+
+    // Unaligned offset is rejected
+    CHECK(f->read_at(out.data(), alignment, 1, ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    ec = std::error_code{};
+
+    pfs::io::aligned_buffer<4096> in(out.size());
+    REQUIRE(f->read_at(in.data(), in.size(), 0, ec) == static_cast<ssize_t>(in.size()));
+    CHECK(in == out);
+
+    // Sequential write continues from unaligned position left by the tail
+    REQUIRE(d.write(out.data(), alignment, ec) == static_cast<ssize_t>(alignment));
+    CHECK(f->seek(0, pfs::io::seek_origin::current, ec)
+        == static_cast<pfs::io::offset_type>(out.size() + alignment));
+
+    pfs::io::aligned_buffer<4096> block(2 * alignment);
+    REQUIRE(f->read_at(block.data(), block.size(), 2 * alignment, ec)
+        == static_cast<ssize_t>(100 + alignment));
+    CHECK(std::equal(block.data() + 100, block.data() + 100 + alignment, out.data()));
+
+    // Unaligned head up to the alignment boundary, direct middle and
+    // unaligned tail: position is realigned for the following writes
+    auto pos = static_cast<size_t>(f->seek(0, pfs::io::seek_origin::current, ec));
+    auto head = alignment - pos % alignment;
+    pfs::io::aligned_buffer<4096> src(2 * alignment + 10);
+
+    for (size_t i = 0; i < src.size(); i++)
+        src[i] = static_cast<char>(i % 241);
+
+    auto n = head + alignment + 10;
+    REQUIRE(d.write(src.data() + alignment - head, n, ec) == static_cast<ssize_t>(n));
+    REQUIRE(!ec);
+    CHECK(f->seek(0, pfs::io::seek_origin::current, ec)
+        == static_cast<pfs::io::offset_type>(pos + n));
+
+    pfs::io::aligned_buffer<4096> check(3 * alignment);
+    auto check_pos = pos - pos % alignment;
+    REQUIRE(f->read_at(check.data(), check.size(), check_pos, ec)
+        == static_cast<ssize_t>(pos % alignment + n));
+    CHECK(std::equal(check.data() + pos % alignment, check.data() + pos % alignment + n
+        , src.data() + alignment - head));
+
+    // Direct mode of the descriptor is never changed
+    CHECK((d.open_mode() & pfs::io::direct) != 0);
+}
+
+TEST_CASE("File / preallocation and holes") {
+    std::error_code ec;
+    std::string path = tmp_dir() + "/sparse.bin";
+    auto d = pfs::io::make_file(path
+        , pfs::io::read_write | pfs::io::truncate
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::none
+        , ec);
+
+    REQUIRE(!ec);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+    pfs::io::offset_type const MiB = 1024 * 1024;
+    pfs::io::offset_type const BLOCK = 64 * 1024;
+
+    ec = f->allocate(0, MiB, true);
+
+    if (ec == std::errc::operation_not_supported) {
+        MESSAGE("fallocate() is not supported for: " << path);
+        return;
+    }
+
+    REQUIRE(!ec);
+    CHECK(f->size(ec) == 0);
+
+    REQUIRE(!f->allocate(0, 2 * MiB));
+    CHECK(f->size(ec) == 2 * MiB);
+
+    // Fresh sparse layout: data at [0, BLOCK) and [MiB, MiB + BLOCK)
+    REQUIRE(!f->punch_hole(0, 2 * MiB));
+
+    std::string block(BLOCK, 'x');
+    REQUIRE(f->write_at(block.data(), block.size(), 0, ec) == BLOCK);
+    REQUIRE(f->write_at(block.data(), block.size(), MiB, ec) == BLOCK);
+
+    std::vector<std::pair<pfs::io::offset_type, pfs::io::offset_type>> extents;
+
+    REQUIRE(!f->for_each_data_extent([& extents] (pfs::io::offset_type offset
+            , pfs::io::offset_type length) {
+        extents.emplace_back(offset, length);
+    }));
+
+    REQUIRE(extents.size() == 2);
+    CHECK(extents[0].first == 0);
+    CHECK(extents[0].second == BLOCK);
+    CHECK(extents[1].first == MiB);
+    CHECK(extents[1].second == BLOCK);
+
+    CHECK(f->next_data(MiB + BLOCK, ec) < 0);
+    CHECK(!ec);
+
+    // Reclaim first block
+    REQUIRE(!f->punch_hole(0, BLOCK));
+    CHECK(f->next_data(0, ec) == MiB);
+    CHECK(f->size(ec) == 2 * MiB);
+
+    char buf[16];
+    REQUIRE(f->read_at(buf, sizeof(buf), 0, ec) == sizeof(buf));
+    CHECK(std::string(buf, sizeof(buf)) == std::string(sizeof(buf), '\0'));
+
+    ec = f->zero_range(MiB, BLOCK);
+
+    if (ec != std::errc::operation_not_supported) {
+        REQUIRE(!ec);
+        REQUIRE(f->read_at(buf, sizeof(buf), MiB, ec) == sizeof(buf));
+        CHECK(std::string(buf, sizeof(buf)) == std::string(sizeof(buf), '\0'));
+    }
+}
+
+TEST_CASE("File / access advice") {
+    std::error_code ec;
+    test_file_path = tmp_path("loremipsum.txt");
+    auto d = pfs::io::make_file(test_file_path, pfs::io::read_only, ec);
+
+    REQUIRE(!ec);
+
+    auto f = pfs::io::underlying_device<pfs::io::file>(d);
+
+    for (auto advice: {pfs::io::access_advice::normal
+            , pfs::io::access_advice::sequential
+            , pfs::io::access_advice::random
+            , pfs::io::access_advice::willneed
+            , pfs::io::access_advice::dontneed
+            , pfs::io::access_advice::noreuse}) {
+        CHECK(!f->advise(advice));
+    }
+
+    CHECK(!f->prefetch(0, 4096));
+
+    REQUIRE(!f->set_adaptive_advice(true));
+    CHECK(f->adaptive_advice());
+    CHECK(f->current_advice() == pfs::io::access_advice::normal);
+
+    char buf[16];
+
+    // Sequential scan
+    for (int i = 0; i < 8; i++)
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    // Single seek does not change classification, read() continues from
+    // the actual position after positional read
+    REQUIRE(f->read_at(buf, sizeof(buf), 1000, ec) == sizeof(buf));
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    for (int i = 0; i < 4; i++)
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    pfs::io::offset_type offsets[] = {500, 32, 1500, 200, 1200, 64, 900, 300, 20};
+
+    // Random access by seek() and read()
+    for (auto offset: offsets) {
+        REQUIRE(f->seek(offset, pfs::io::seek_origin::begin, ec) == offset);
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+    }
+
+    CHECK(f->current_advice() == pfs::io::access_advice::random);
+
+    // Sequential scan after seek (first read is not adjacent to the previous)
+    REQUIRE(f->seek(0, pfs::io::seek_origin::begin, ec) == 0);
+
+    for (int i = 0; i < 9; i++)
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    // Random access by next_data() and read() (file has no holes)
+    for (auto offset: offsets) {
+        REQUIRE(f->next_data(offset, ec) == offset);
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+    }
+
+    CHECK(f->current_advice() == pfs::io::access_advice::random);
+
+    REQUIRE(f->seek(0, pfs::io::seek_origin::begin, ec) == 0);
+
+    for (int i = 0; i < 9; i++)
+        REQUIRE(d.read(buf, sizeof(buf), ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    // Random positional lookups
+    for (auto offset: offsets)
+        REQUIRE(f->read_at(buf, sizeof(buf), offset, ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::random);
+
+    // Sequential positional scan
+    for (int i = 0; i < 9; i++)
+        REQUIRE(f->read_at(buf, sizeof(buf), i * 16, ec) == sizeof(buf));
+
+    CHECK(f->current_advice() == pfs::io::access_advice::sequential);
+
+    // Concurrent scattered positional reads feed the detector under lock
+    std::vector<std::thread> readers;
+    std::atomic<int> failures {0};
+
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&, t] {
+            std::error_code rec;
+            char rbuf[16];
+
+            for (int i = 0; i < 100; i++) {
+                pfs::io::offset_type offset = (t * 100 + i) * 50 % 61 * 16;
+
+                if (f->read_at(rbuf, sizeof(rbuf), offset, rec) != sizeof(rbuf))
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto & r: readers)
+        r.join();
+
+    CHECK(failures == 0);
+    CHECK(f->current_advice() == pfs::io::access_advice::random);
+
+    REQUIRE(!f->set_adaptive_advice(false));
+    CHECK(f->current_advice() == pfs::io::access_advice::normal);
+}
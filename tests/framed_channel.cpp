@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Added test for nonblocking device that accepts no data
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/buffer.hpp"
+#include "pfs/io/framed_channel.hpp"
+#include "utils.hpp"
+#include <string>
+#include <vector>
+
+static pfs::io::frame_prefix const PREFIXES[] = {
+      pfs::io::frame_prefix::fixed8
+    , pfs::io::frame_prefix::fixed16
+    , pfs::io::frame_prefix::fixed32
+    , pfs::io::frame_prefix::fixed64
+    , pfs::io::frame_prefix::varint
+};
+
+// Nonblocking device that accepts at most `capacity` bytes
+struct limited_device
+{
+    std::string data;
+    size_t capacity {0};
+
+    ssize_t writev (pfs::io::io_vector const * iov, int iovcnt, pfs::io::error_code &)
+    {
+        size_t total = 0;
+
+        for (int i = 0; i < iovcnt && data.size() < capacity; i++) {
+            auto n = std::min(iov[i].iov_len, capacity - data.size());
+            data.append(static_cast<char const *>(iov[i].iov_base), n);
+            total += n;
+        }
+
+        return static_cast<ssize_t>(total);
+    }
+
+    ssize_t read (char *, size_t, pfs::io::error_code &) { return 0; }
+    bool is_nonblocking () const { return true; }
+};
+
+static std::vector<std::string> sample_frames ()
+{
+    std::vector<std::string> frames {"", "a", "hello"};
+    std::string lorem {loremipsum};
+
+    for (size_t n: {size_t{127}, size_t{128}, size_t{255}})
+        frames.push_back(lorem.substr(0, n));
+
+    return frames;
+}
+
+TEST_CASE("Framed channel / varint") {
+    char buf[pfs::io::varint_max_size];
+
+    for (std::uint64_t v: {std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{127}
+            , std::uint64_t{128}, std::uint64_t{300}, std::uint64_t{0xFFFFFFFF}
+            , ~std::uint64_t{0}}) {
+        auto n = pfs::io::encode_varint(v, buf);
+        CHECK(n == pfs::io::varint_size(v));
+
+        std::uint64_t decoded = 0;
+        CHECK(pfs::io::decode_varint(buf, buf + n, decoded) == static_cast<int>(n));
+        CHECK(decoded == v);
+
+        // Incomplete
+        CHECK(pfs::io::decode_varint(buf, buf + n - 1, decoded) == 0);
+    }
+
+    // 300 = 0xAC 0x02
+    CHECK(pfs::io::encode_varint(300, buf) == 2);
+    CHECK(buf[0] == '\xAC');
+    CHECK(buf[1] == '\x02');
+
+    // Overflow
+    std::string bad(10, '\xFF');
+    bad.back() = '\x02';
+    std::uint64_t value = 0;
+    CHECK(pfs::io::decode_varint(bad.data(), bad.data() + bad.size(), value) == -1);
+}
+
+TEST_CASE("Framed channel / round trip") {
+    auto frames = sample_frames();
+
+    for (auto prefix: PREFIXES) {
+        pfs::io::framed_channel_options options;
+        options.prefix = prefix;
+        options.buffer_size = 16;
+
+        std::string wire;
+
+        {
+            auto d = pfs::io::make_buffer(wire, pfs::io::write_only);
+            pfs::io::framed_channel channel {d, options};
+            pfs::io::error_code ec;
+
+            REQUIRE(channel.write_frame(frames[0].data(), frames[0].size(), ec) == 0);
+
+            std::vector<pfs::io::bytes_view> batch;
+
+            for (size_t i = 1; i < frames.size(); i++)
+                batch.emplace_back(frames[i]);
+
+            REQUIRE(channel.write_frames(batch.data(), batch.size(), ec) > 0);
+        }
+
+        // One by one
+        {
+            auto d = pfs::io::make_buffer(wire, pfs::io::read_only);
+            pfs::io::framed_channel channel {d, options};
+            pfs::io::bytes_view frame;
+            std::vector<std::string> result;
+
+            while (channel.read_frame(frame))
+                result.push_back(frame.to_string());
+
+            CHECK(channel.at_end());
+            CHECK(result == frames);
+        }
+
+        // Batch decode
+        {
+            options.buffer_size = 64 * 1024;
+            auto d = pfs::io::make_buffer(wire, pfs::io::read_only);
+            pfs::io::framed_channel channel {d, options};
+            std::vector<pfs::io::bytes_view> batch;
+            pfs::io::error_code ec;
+
+            // All frames arrive with the first read
+            CHECK(channel.read_frames(batch, ec) == frames.size());
+            REQUIRE(!ec);
+
+            std::vector<std::string> result;
+
+            for (auto const & f: batch)
+                result.push_back(f.to_string());
+
+            CHECK(result == frames);
+
+            batch.clear();
+            CHECK(channel.read_frames(batch, ec) == 0);
+            CHECK(!ec);
+            CHECK(channel.at_end());
+        }
+    }
+}
+
+TEST_CASE("Framed channel / limits and errors") {
+    pfs::io::framed_channel_options options;
+    options.prefix = pfs::io::frame_prefix::fixed8;
+    options.max_frame_size = 1000;
+
+    std::string wire;
+    auto d = pfs::io::make_buffer(wire, pfs::io::write_only);
+    pfs::io::framed_channel writer {d, options};
+    pfs::io::error_code ec;
+
+    // Prefix can not hold the length
+    std::string big(256, 'x');
+    CHECK(writer.write_frame(big.data(), big.size(), ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+    CHECK(wire.empty());
+
+    // Receiver limit
+    wire = std::string{"\x00\x00\x00\x10", 4} + std::string(16, 'x');
+    options.prefix = pfs::io::frame_prefix::fixed32;
+    options.max_frame_size = 8;
+
+    {
+        auto r = pfs::io::make_buffer(wire, pfs::io::read_only);
+        pfs::io::framed_channel reader {r, options};
+        pfs::io::bytes_view frame;
+        ec.clear();
+        CHECK_FALSE(reader.read_frame(frame, ec));
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+        CHECK_THROWS_AS(reader.read_frame(frame), pfs::io::exception);
+    }
+
+    // Truncated frame at the end of stream
+    wire = std::string{"\x00\x00\x00\x10", 4} + "abc";
+    options.max_frame_size = 100;
+
+    {
+        auto r = pfs::io::make_buffer(wire, pfs::io::read_only);
+        pfs::io::framed_channel reader {r, options};
+        pfs::io::bytes_view frame;
+        ec.clear();
+        CHECK_FALSE(reader.read_frame(frame, ec));
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::bad_message));
+    }
+}
+
+TEST_CASE("Framed channel / nonblocking device is not writable") {
+    limited_device d;
+    d.capacity = 6;
+
+    pfs::io::basic_framed_channel<limited_device> channel {d};
+    pfs::io::error_code ec;
+
+    // Partial write followed by write that accepts nothing
+    CHECK(channel.write_frame("hello", 5, ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::operation_would_block));
+    CHECK(d.data.size() == 6);
+
+    // Empty frame fits entirely
+    d.data.clear();
+    ec.clear();
+    CHECK(channel.write_frame("", 0, ec) == 0);
+    CHECK(!ec);
+    CHECK(d.data.size() == 4);
+}
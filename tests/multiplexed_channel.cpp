@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/local_server.hpp"
+#include "pfs/io/multiplexed_channel.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static std::string server_name ()
+{
+    return tmp_dir() + "/pfs_multiplexed_channel";
+}
+
+static pfs::io::device accept_one (pfs::io::error_code & ec)
+{
+    auto s = pfs::io::make_local_server(server_name(), false, ec);
+
+    if (ec)
+        return pfs::io::device{};
+
+    return s.accept(ec);
+}
+
+TEST_CASE("Multiplexed channel / out of order responses") {
+    int const request_count = 64;
+    int const batch_size = 8;
+
+    std::thread server_thread([&] {
+        pfs::io::error_code ec;
+        auto peer = accept_one(ec);
+        REQUIRE_FALSE(ec);
+
+        pfs::io::multiplexed_server server {std::move(peer)};
+        std::vector<std::pair<std::uint64_t, std::string>> batch;
+        std::uint64_t id = 0;
+        pfs::io::bytes_view request;
+
+        while (server.read_request(id, request, ec)) {
+            batch.emplace_back(id, "re:" + request.to_string());
+
+            // Answer each batch in reverse order
+            if (batch.size() == batch_size) {
+                std::reverse(batch.begin(), batch.end());
+
+                for (auto const & item: batch)
+                    server.respond(item.first, item.second.data(), item.second.size());
+
+                batch.clear();
+            }
+        }
+
+        CHECK_FALSE(ec);
+        CHECK(server.at_end());
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    {
+        pfs::io::multiplexed_client client {pfs::io::make_local_socket(server_name(), false)};
+        std::vector<std::future<std::string>> responses;
+
+        // All requests are outstanding at once
+        for (int i = 0; i < request_count; i++) {
+            auto body = std::to_string(i);
+            responses.push_back(client.request(body.data(), body.size()));
+        }
+
+        for (int i = 0; i < request_count; i++)
+            CHECK(responses[i].get() == "re:" + std::to_string(i));
+
+        CHECK(client.pending_count() == 0);
+
+        // Callback interface from several threads
+        std::vector<std::thread> threads;
+        std::vector<std::promise<bool>> matched(batch_size);
+
+        for (int i = 0; i < batch_size; i++) {
+            threads.emplace_back([&, i] {
+                auto body = "t" + std::to_string(i);
+                pfs::io::error_code ec;
+
+                auto sent = client.request(body.data(), body.size()
+                    , [&, i, body] (pfs::io::error_code const & ec, pfs::io::bytes_view response) {
+                        matched[i].set_value(!ec && response.to_string() == "re:" + body);
+                    }, ec);
+
+                CHECK(sent);
+            });
+        }
+
+        for (auto & t: threads)
+            t.join();
+
+        for (auto & m: matched)
+            CHECK(m.get_future().get());
+    }
+
+    server_thread.join();
+}
+
+TEST_CASE("Multiplexed channel / pending requests fail on disconnect") {
+    std::thread server_thread([] {
+        pfs::io::error_code ec;
+        auto peer = accept_one(ec);
+        REQUIRE_FALSE(ec);
+
+        pfs::io::multiplexed_server server {std::move(peer)};
+        std::uint64_t id = 0;
+        pfs::io::bytes_view request;
+
+        // Answer the second request only, then drop the connection
+        REQUIRE(server.read_request(id, request));
+        REQUIRE(server.read_request(id, request));
+        server.respond(id, "ok", 2);
+        server.close();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    pfs::io::multiplexed_client client {pfs::io::make_local_socket(server_name(), false)};
+    auto first = client.request("a", 1);
+    auto second = client.request("b", 1);
+
+    CHECK(second.get() == "ok");
+    CHECK_THROWS_AS(first.get(), pfs::io::exception);
+
+    server_thread.join();
+
+    // Connection is gone
+    pfs::io::error_code ec;
+    CHECK_FALSE(client.request("c", 1, [] (pfs::io::error_code const &, pfs::io::bytes_view) {}, ec));
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::connection_aborted));
+}
+
+TEST_CASE("Multiplexed channel / close cancels pending requests") {
+    std::promise<void> done;
+
+    std::thread server_thread([&] {
+        pfs::io::error_code ec;
+        auto peer = accept_one(ec);
+        REQUIRE_FALSE(ec);
+
+        pfs::io::multiplexed_server server {std::move(peer)};
+        std::uint64_t id = 0;
+        pfs::io::bytes_view request;
+
+        // Never answers
+        while (server.read_request(id, request, ec))
+            ;
+
+        done.set_value();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    auto client = pfs::io::make_static_local_socket(server_name(), false);
+    pfs::io::basic_multiplexed_client<decltype(client)> mc {std::move(client)};
+    auto response = mc.request("x", 1);
+
+    CHECK(mc.close() == pfs::io::error_code{});
+
+    try {
+        response.get();
+        CHECK(false);
+    } catch (pfs::io::exception const & ex) {
+        CHECK(ex.code() == pfs::io::make_error_code(pfs::io::errc::operation_canceled));
+    }
+
+    done.get_future().wait();
+    server_thread.join();
+}
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Added tests for wrapped devices and partial writes
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/buffer.hpp"
+#include "pfs/io/pacing.hpp"
+#include "pfs/io/tcp_server.hpp"
+#include "pfs/io/tcp_socket.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <string>
+#include <vector>
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using clock_type = pfs::io::token_bucket::clock_type;
+
+TEST_CASE("Pacing / token bucket") {
+    clock_type::time_point t0 {std::chrono::seconds{100}};
+
+    pfs::io::token_bucket unlimited;
+    CHECK(unlimited.reserve(1000000, t0) == t0);
+    CHECK(unlimited.reserve(1000000, t0) == t0);
+
+    pfs::io::token_bucket bucket {1000};
+    CHECK(bucket.tolerance() == clock_type::duration{0});
+    CHECK(bucket.reserve(100, t0) == t0);
+    CHECK(bucket.reserve(100, t0) == t0 + milliseconds{100});
+    CHECK(bucket.reserve(50, t0 + milliseconds{50}) == t0 + milliseconds{200});
+
+    // Idle time is not accumulated
+    CHECK(bucket.reserve(10, t0 + std::chrono::seconds{10}) == t0 + std::chrono::seconds{10});
+    CHECK(bucket.reserve(10, t0 + std::chrono::seconds{10}) == t0 + milliseconds{10010});
+
+    // Fractions of nanosecond are carried
+    pfs::io::token_bucket slow {3};
+    CHECK(slow.reserve(1, t0) == t0);
+    CHECK(slow.reserve(1, t0) == t0 + nanoseconds{333333333});
+    CHECK(slow.reserve(1, t0) == t0 + nanoseconds{666666666});
+    CHECK(slow.reserve(1, t0) == t0 + std::chrono::seconds{1});
+
+    pfs::io::token_bucket bursty {1000, 500};
+    CHECK(bursty.tolerance() == milliseconds{500});
+
+    slow.reset();
+    CHECK(slow.reserve(1, t0) == t0);
+}
+
+// Records time of every write
+struct recording_device
+{
+    std::vector<clock_type::time_point> writes;
+    size_t bytes {0};
+
+    ssize_t write (char const *, size_t n, pfs::io::error_code &)
+    {
+        writes.push_back(clock_type::now());
+        bytes += n;
+        return static_cast<ssize_t>(n);
+    }
+
+    ssize_t writev (pfs::io::io_vector const * iov, int iovcnt, pfs::io::error_code & ec)
+    {
+        size_t n = 0;
+
+        for (int i = 0; i < iovcnt; i++)
+            n += iov[i].iov_len;
+
+        return write(nullptr, n, ec);
+    }
+};
+
+// Accepts at most `limit` bytes per write
+struct partial_device : recording_device
+{
+    size_t limit {0};
+
+    ssize_t write (char const * bytes, size_t n, pfs::io::error_code & ec)
+    {
+        return recording_device::write(bytes, std::min(n, limit), ec);
+    }
+};
+
+TEST_CASE("Pacing / userspace") {
+    std::string chunk(5000, 'x');
+    pfs::io::error_code ec;
+
+    // One write per 5 ms, default burst lets writes go 200 us early
+    {
+        recording_device d;
+        pfs::io::pacing_options options;
+        options.rate = 1000000;
+        options.mode = pfs::io::pacing_mode::txtime;
+
+        pfs::io::basic_paced_device<recording_device> paced {d, options};
+        CHECK(paced.mode() == pfs::io::pacing_mode::userspace);
+
+        for (int i = 0; i < 20; i++)
+            REQUIRE(paced.write(chunk.data(), chunk.size(), ec) == 5000);
+
+        pfs::io::io_vector iov[2] = {{& chunk[0], 2500}, {& chunk[0], 2500}};
+        REQUIRE(paced.writev(iov, 2, ec) == 5000);
+
+        REQUIRE(d.writes.size() == 21);
+        CHECK(d.bytes == 21 * chunk.size());
+        CHECK(d.writes.back() - d.writes.front() >= milliseconds{100} - microseconds{200});
+        CHECK(d.writes.back() - d.writes.front() < milliseconds{400});
+
+        for (size_t i = 1; i < d.writes.size(); i++)
+            CHECK(d.writes[i] - d.writes.front() >= milliseconds{5} * i - microseconds{200});
+    }
+
+    // Burst of 20000 bytes goes at once
+    {
+        recording_device d;
+        pfs::io::pacing_options options;
+        options.rate = 1000000;
+        options.burst = 20000;
+
+        pfs::io::basic_paced_device<recording_device> paced {d, options};
+
+        for (int i = 0; i < 10; i++)
+            paced.write(chunk.data(), chunk.size());
+
+        REQUIRE(d.writes.size() == 10);
+        CHECK(d.writes[4] - d.writes.front() < milliseconds{5});
+        CHECK(d.writes[9] - d.writes.front() >= milliseconds{25});
+    }
+}
+
+TEST_CASE("Pacing / partial writes") {
+    std::string chunk(5000, 'x');
+    pfs::io::error_code ec;
+
+    partial_device d;
+    d.limit = 1000;
+
+    pfs::io::pacing_options options;
+    options.rate = 1000000;
+
+    pfs::io::basic_paced_device<partial_device> paced {d, options};
+
+    // Only written bytes are charged: 20 * 1000 bytes take 20 ms, not 100 ms
+    auto start = clock_type::now();
+
+    for (int i = 0; i < 20; i++)
+        REQUIRE(paced.write(chunk.data(), chunk.size(), ec) == 1000);
+
+    CHECK(clock_type::now() - start >= milliseconds{19} - microseconds{200});
+    CHECK(clock_type::now() - start < milliseconds{60});
+}
+
+TEST_CASE("Pacing / UDP socket") {
+    using pfs::io::pacing_mode;
+
+    std::string datagram(1000, 'u');
+    char buf[2048];
+    pfs::io::error_code ec;
+
+    for (auto mode: {pacing_mode::userspace, pacing_mode::max_pacing_rate, pacing_mode::txtime}) {
+        auto port = static_cast<std::uint16_t>(41991 + static_cast<int>(mode));
+        auto server = pfs::io::make_udp_server("127.0.0.1", port, true);
+        auto client = pfs::io::make_static_udp_socket("127.0.0.1", port, false);
+
+        pfs::io::pacing_options options;
+        options.rate = 200000; // one datagram per 5 ms
+        options.mode = mode;
+
+        pfs::io::basic_paced_device<pfs::io::udp_socket> paced {client.underlying(), options};
+        CHECK(paced.mode() == mode);
+
+        auto start = clock_type::now();
+
+        for (int i = 0; i < 20; i++)
+            REQUIRE(paced.write(datagram.data(), datagram.size(), ec) == 1000);
+
+        // Kernel modes may go ahead of the rate by kernel_horizon
+        CHECK(clock_type::now() - start >= milliseconds{90});
+
+        int received = 0;
+
+        while (received < 20 && server.wait_for_read(milliseconds{1000}, ec))
+            received += server.read(buf, sizeof(buf), ec) == 1000 ? 1 : 0;
+
+        CHECK(received == 20);
+
+        paced.set_rate(0);
+        CHECK(paced.write(datagram.data(), datagram.size(), ec) == 1000);
+    }
+
+    // Departure time in the past means now
+    auto server = pfs::io::make_udp_server("127.0.0.1", 41994, true);
+    auto client = pfs::io::make_static_udp_socket("127.0.0.1", 41994, false);
+    auto & s = client.underlying();
+
+    REQUIRE_FALSE(s.enable_txtime());
+    CHECK(s.write_at(datagram.data(), datagram.size(), clock_type::time_point{}, ec) == 1000);
+    REQUIRE(server.wait_for_read(milliseconds{1000}, ec));
+    CHECK(server.read(buf, sizeof(buf), ec) == 1000);
+
+    CHECK_FALSE(s.set_max_pacing_rate(1000000));
+    CHECK_FALSE(s.set_max_pacing_rate(0));
+}
+
+TEST_CASE("Pacing / wrapped devices") {
+    using pfs::io::pacing_mode;
+
+    pfs::io::pacing_options options;
+    options.rate = 1000000;
+
+    for (auto mode: {pacing_mode::max_pacing_rate, pacing_mode::txtime}) {
+        options.mode = mode;
+
+        auto server = pfs::io::make_udp_server("127.0.0.1", 41996, true);
+
+        {
+            auto d = pfs::io::make_udp_socket("127.0.0.1", 41996, false);
+            pfs::io::paced_device paced {d, options};
+            CHECK(paced.mode() == mode);
+            CHECK(paced.write("hello", 5) == 5);
+        }
+
+        {
+            auto d = pfs::io::make_static_udp_socket("127.0.0.1", 41996, false);
+            pfs::io::basic_paced_device<pfs::io::static_device<pfs::io::udp_socket>> paced {d, options};
+            CHECK(paced.mode() == mode);
+            CHECK(paced.write("hello", 5) == 5);
+        }
+    }
+
+    auto server = pfs::io::make_tcp_server("127.0.0.1", 41997, false, 5);
+    options.mode = pacing_mode::max_pacing_rate;
+
+    {
+        auto d = pfs::io::make_tcp_socket("127.0.0.1", 41997, false);
+        pfs::io::paced_device paced {d, options};
+        CHECK(paced.mode() == pacing_mode::max_pacing_rate);
+    }
+
+    {
+        auto d = pfs::io::make_static_tcp_socket("127.0.0.1", 41997, false);
+        pfs::io::basic_paced_device<pfs::io::static_device<pfs::io::tcp_socket>> paced {d, options};
+        CHECK(paced.mode() == pacing_mode::max_pacing_rate);
+    }
+
+    // Devices without kernel pacing fall back to userspace mode
+    std::string data;
+    auto b = pfs::io::make_buffer(data, pfs::io::write_only);
+    pfs::io::paced_device paced {b, options};
+    CHECK(paced.mode() == pacing_mode::userspace);
+}
+
+TEST_CASE("Pacing / TCP socket") {
+    auto server = pfs::io::make_tcp_server("127.0.0.1", 41995, false, 5);
+    auto client = pfs::io::make_static_tcp_socket("127.0.0.1", 41995, false);
+    auto & s = client.underlying();
+
+    CHECK_FALSE(s.set_max_pacing_rate(1000000));
+
+    pfs::io::pacing_options options;
+    options.rate = 1000000;
+    options.mode = pfs::io::pacing_mode::max_pacing_rate;
+
+    pfs::io::basic_paced_device<pfs::io::tcp_socket> paced {s, options};
+    CHECK(paced.mode() == pfs::io::pacing_mode::max_pacing_rate);
+    CHECK(paced.write("hello", 5) == 5);
+
+    pfs::io::error_code ec;
+    auto peer = server.accept(ec);
+    REQUIRE_FALSE(ec);
+
+    char buf[8];
+    CHECK(peer.read(buf, sizeof(buf), ec) == 5);
+}
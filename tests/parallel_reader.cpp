@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Chunk sizes not less than minimum
+//      2026.10.19 File truncated while reading
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/parallel_reader.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Records of varying length, some of them longer than chunk size used in tests
+static std::vector<std::string> make_records (int count)
+{
+    std::vector<std::string> records;
+
+    for (int i = 0; i < count; i++) {
+        auto rec = std::to_string(i) + ":";
+        rec.append(static_cast<size_t>(i % 250 == 7 ? 10000 : (i * 37) % 300), 'a' + i % 26);
+        records.push_back(rec);
+    }
+
+    // Empty record
+    records[count / 2].clear();
+    return records;
+}
+
+static void write_file (std::vector<std::string> const & records, bool trailing_delimiter)
+{
+    std::string content;
+
+    for (auto const & rec: records)
+        content += rec + "\n";
+
+    if (!trailing_delimiter)
+        content.pop_back();
+
+    auto d = pfs::io::make_file(tmp_path("parallel_reader.txt")
+        , pfs::io::write_only | pfs::io::truncate
+        , pfs::io::owner_read | pfs::io::owner_write
+        , pfs::io::durability::none);
+
+    pfs::io::error_code ec;
+    REQUIRE(d.write(content.data(), content.size(), ec) == static_cast<ssize_t>(content.size()));
+}
+
+TEST_CASE("Parallel reader / records") {
+    auto expected = make_records(2000);
+
+    for (bool trailing_delimiter: {true, false}) {
+        write_file(expected, trailing_delimiter);
+
+        for (bool use_mmap: {true, false}) {
+            for (size_t chunk_size: {size_t{4096}, size_t{5000}, size_t{64 * 1024}, size_t{1024 * 1024}}) {
+                pfs::io::parallel_reader_options options;
+                options.thread_count = 4;
+                options.chunk_size = chunk_size;
+                options.use_mmap = use_mmap;
+
+                // Ordered
+                {
+                    std::vector<std::string> result;
+                    pfs::io::parallel_reader reader {tmp_path("parallel_reader.txt"), options};
+
+                    auto ec = reader.for_each_record([& result] (char const * data, size_t n) {
+                        result.emplace_back(data, n);
+                    });
+
+                    REQUIRE(!ec);
+                    CHECK(result == expected);
+                }
+
+                // Unordered
+                {
+                    options.order = pfs::io::delivery_order::unordered;
+                    std::mutex mtx;
+                    std::vector<std::string> result;
+                    pfs::io::parallel_reader reader {tmp_path("parallel_reader.txt"), options};
+
+                    auto ec = reader.for_each_record([& result, & mtx] (char const * data, size_t n) {
+                        std::lock_guard<std::mutex> lk(mtx);
+                        result.emplace_back(data, n);
+                    });
+
+                    REQUIRE(!ec);
+
+                    auto sorted_expected = expected;
+                    std::sort(result.begin(), result.end());
+                    std::sort(sorted_expected.begin(), sorted_expected.end());
+                    CHECK(result == sorted_expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel reader / chunks") {
+    auto records = make_records(500);
+    write_file(records, true);
+
+    pfs::io::parallel_reader_options options;
+    options.thread_count = 3;
+    options.chunk_size = 5000;
+
+    pfs::io::offset_type next_offset = 0;
+    pfs::io::parallel_reader reader {tmp_path("parallel_reader.txt"), options};
+
+    auto ec = reader.for_each_chunk([& next_offset] (pfs::io::offset_type offset
+            , char const * data, size_t n) {
+        // Chunks are contiguous and end on record boundary
+        CHECK(offset == next_offset);
+        CHECK(data[n - 1] == '\n');
+        next_offset = offset + static_cast<pfs::io::offset_type>(n);
+    });
+
+    REQUIRE(!ec);
+
+    size_t total = 0;
+
+    for (auto const & rec: records)
+        total += rec.size() + 1;
+
+    CHECK(next_offset == static_cast<pfs::io::offset_type>(total));
+}
+
+TEST_CASE("Parallel reader / errors") {
+    pfs::io::parallel_reader reader {"!@#$%"};
+    auto ec = reader.for_each_record([] (char const *, size_t) {});
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::file_not_found));
+
+    // Empty file
+    write_file(std::vector<std::string>{""}, false);
+    int count = 0;
+    pfs::io::parallel_reader empty {tmp_path("parallel_reader.txt")};
+    REQUIRE(!empty.for_each_record([& count] (char const *, size_t) { count++; }));
+    CHECK(count == 0);
+}
+
+TEST_CASE("Parallel reader / truncated file") {
+    write_file(make_records(500), true);
+
+    pfs::io::parallel_reader_options options;
+    options.thread_count = 1;
+    options.chunk_size = 4096;
+    options.use_mmap = false;
+
+    int count = 0;
+    pfs::io::parallel_reader reader {tmp_path("parallel_reader.txt"), options};
+
+    auto ec = reader.for_each_chunk([& count] (pfs::io::offset_type, char const *, size_t) {
+        // Truncate file after the first chunk
+        if (count++ == 0)
+            pfs::io::make_file(tmp_path("parallel_reader.txt"), pfs::io::write_only | pfs::io::truncate);
+    });
+
+    CHECK(count == 1);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::unexpected_end_of_file));
+}
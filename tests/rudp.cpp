@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.19 Added test for SYN send failure
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/rudp.hpp"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string const SERVER_ADDR {"127.0.0.1"};
+
+static pfs::io::rudp_options lossy_options (double loss, std::uint32_t seed)
+{
+    pfs::io::rudp_options options;
+    options.max_payload = 1000;
+    options.impairment.loss = loss;
+    options.impairment.delay = std::chrono::milliseconds{2};
+    options.impairment.jitter = std::chrono::milliseconds{3};
+    options.impairment.seed = seed;
+    return options;
+}
+
+static std::string make_message (int i)
+{
+    // Some messages span several packets
+    return std::string(static_cast<size_t>(i * 37 % 3500), static_cast<char>('a' + i % 26))
+        + std::to_string(i);
+}
+
+TEST_CASE("RUDP / sequence numbers") {
+    using pfs::io::details::rudp::expand_seq;
+
+    CHECK(expand_seq(5, 0) == 5);
+    CHECK(expand_seq(0xFFFFFFF0, 0x1FFFFFFF0ULL) == 0x1FFFFFFF0ULL);
+    CHECK(expand_seq(0x00000010, 0x1FFFFFFF0ULL) == 0x200000010ULL);
+    CHECK(expand_seq(0xFFFFFFF0, 0x200000010ULL) == 0x1FFFFFFF0ULL);
+    CHECK(expand_seq(0xFFFFFFFF, 0) == 0xFFFFFFFFULL);
+}
+
+TEST_CASE("RUDP / ordered delivery over lossy link") {
+    int const message_count = 400;
+    std::vector<std::string> received;
+    pfs::io::rudp_stats client_stats;
+
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, 41980, lossy_options(0.05, 1));
+
+    std::thread peer {[&] {
+        auto d = server.accept(std::chrono::milliseconds{5000});
+        REQUIRE_FALSE(d.is_null());
+        auto s = pfs::io::underlying_device<pfs::io::rudp_socket>(d);
+        REQUIRE(s != nullptr);
+        CHECK(s->ordered());
+
+        std::string message;
+
+        while (s->read_message(message))
+            received.push_back(message);
+    }};
+
+    {
+        auto d = pfs::io::make_rudp_socket(SERVER_ADDR, 41980, lossy_options(0.05, 2));
+        REQUIRE(d.type() == pfs::io::device_type::rudp_socket);
+
+        for (int i = 0; i < message_count; i++) {
+            auto message = make_message(i);
+            pfs::io::error_code ec;
+            REQUIRE(d.write(message.data(), message.size(), ec) == static_cast<ssize_t>(message.size()));
+        }
+
+        CHECK_FALSE(d.close());
+        client_stats = pfs::io::underlying_device<pfs::io::rudp_socket>(d)->stats();
+    }
+
+    peer.join();
+
+    REQUIRE(received.size() == message_count);
+
+    for (int i = 0; i < message_count; i++)
+        CHECK(received[i] == make_message(i));
+
+    CHECK(client_stats.packets_dropped > 0);
+    CHECK(client_stats.packets_retransmitted > 0);
+    CHECK(client_stats.srtt.count() > 0);
+}
+
+TEST_CASE("RUDP / unordered delivery") {
+    int const message_count = 300;
+    std::set<std::string> received;
+    size_t duplicates = 0;
+
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, 41981, lossy_options(0.1, 3));
+
+    std::thread peer {[&] {
+        auto d = server.accept(std::chrono::milliseconds{5000});
+        REQUIRE_FALSE(d.is_null());
+        auto s = pfs::io::underlying_device<pfs::io::rudp_socket>(d);
+        CHECK_FALSE(s->ordered());
+
+        std::string message;
+
+        while (s->read_message(message)) {
+            if (!received.insert(message).second)
+                duplicates++;
+        }
+    }};
+
+    {
+        auto options = lossy_options(0.1, 4);
+        options.ordered = false;
+
+        auto d = pfs::io::make_rudp_socket(SERVER_ADDR, 41981, options);
+        pfs::io::error_code ec;
+
+        // Unordered message must fit into a packet
+        std::string oversized(options.max_payload + 1, 'x');
+        CHECK(d.write(oversized.data(), oversized.size(), ec) < 0);
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::message_size));
+
+        for (int i = 0; i < message_count; i++) {
+            auto message = std::to_string(i);
+            ec.clear();
+            REQUIRE(d.write(message.data(), message.size(), ec) > 0);
+        }
+
+        CHECK_FALSE(d.close());
+    }
+
+    peer.join();
+
+    CHECK(duplicates == 0);
+    REQUIRE(received.size() == message_count);
+
+    for (int i = 0; i < message_count; i++)
+        CHECK(received.count(std::to_string(i)) == 1);
+}
+
+TEST_CASE("RUDP / byte stream echo") {
+    int const round_count = 50;
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, 41982, lossy_options(0.05, 5));
+
+    std::thread peer {[&] {
+        auto d = server.accept(std::chrono::milliseconds{5000});
+        REQUIRE_FALSE(d.is_null());
+
+        char buf[256];
+        pfs::io::error_code ec;
+
+        for (;;) {
+            auto n = d.read(buf, sizeof(buf), ec);
+
+            if (n <= 0)
+                break;
+
+            REQUIRE(d.write(buf, static_cast<size_t>(n), ec) == n);
+        }
+
+        CHECK_FALSE(ec);
+    }};
+
+    auto d = pfs::io::make_rudp_socket(SERVER_ADDR, 41982, lossy_options(0.05, 6));
+    std::string sent;
+    std::string echoed;
+
+    for (int i = 0; i < round_count; i++) {
+        auto message = "ping-" + std::to_string(i);
+        pfs::io::error_code ec;
+        REQUIRE(d.write(message.data(), message.size(), ec) > 0);
+        sent += message;
+
+        char buf[256];
+
+        while (echoed.size() < sent.size()) {
+            auto n = d.read(buf, sizeof(buf));
+            REQUIRE(n > 0);
+            echoed.append(buf, static_cast<size_t>(n));
+        }
+    }
+
+    CHECK(echoed == sent);
+    d.close();
+    peer.join();
+
+    // Connection is closed
+    pfs::io::error_code ec;
+    CHECK(d.write("x", 1, ec) < 0);
+}
+
+TEST_CASE("RUDP / connection errors") {
+    pfs::io::rudp_options options;
+    options.connect_timeout = std::chrono::milliseconds{300};
+    options.initial_rto = std::chrono::milliseconds{50};
+
+    // Nobody listens
+    pfs::io::error_code ec;
+    auto d = pfs::io::make_rudp_socket(SERVER_ADDR, 41983, options, ec);
+    CHECK(d.is_null());
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::timedout));
+
+    // SYN can not be sent (broadcast is not enabled): fails at once and
+    // closes without lingering
+    auto start = std::chrono::steady_clock::now();
+    ec.clear();
+    d = pfs::io::make_rudp_socket("255.255.255.255", 41983, options, ec);
+    CHECK(d.is_null());
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::permission_denied));
+    CHECK(std::chrono::steady_clock::now() - start < options.connect_timeout);
+
+    // No incoming connection
+    auto server = pfs::io::make_rudp_server(SERVER_ADDR, 41983, options);
+    ec.clear();
+    CHECK(server.accept(std::chrono::milliseconds{50}, ec).is_null());
+    CHECK_FALSE(ec);
+
+    // Peer disappears while data is outstanding
+    options.min_rto = std::chrono::milliseconds{5};
+    options.max_rto = std::chrono::milliseconds{20};
+    options.max_retransmits = 3;
+
+    std::thread peer {[&] {
+        auto s = server.accept(std::chrono::milliseconds{5000});
+        REQUIRE_FALSE(s.is_null());
+        s.invalidate();
+    }};
+
+    auto c = pfs::io::make_rudp_socket(SERVER_ADDR, 41983, options);
+    peer.join();
+
+    std::string message {"lost"};
+    ssize_t rc = 0;
+
+    for (int i = 0; i < 100 && rc >= 0; i++) {
+        ec.clear();
+        rc = c.write(message.data(), message.size(), ec);
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    CHECK(rc < 0);
+    CHECK((ec == pfs::io::make_error_code(pfs::io::errc::timedout) || ec == pfs::io::make_error_code(pfs::io::errc::broken_pipe)));
+}
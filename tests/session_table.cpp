@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/session_table.hpp"
+#include "pfs/io/udp_server.hpp"
+#include "pfs/io/udp_socket.hpp"
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+using host_address = pfs::io::udp_socket::host_address;
+
+static host_address make_address4 (std::uint32_t ip, std::uint16_t port)
+{
+    host_address a;
+    a.addr.addr4.sin_family = AF_INET;
+    a.addr.addr4.sin_addr.s_addr = htonl(ip);
+    a.addr.addr4.sin_port = htons(port);
+    return a;
+}
+
+static host_address make_address6 (std::string const & ip, std::uint16_t port, std::uint32_t scope = 0)
+{
+    host_address a;
+    a.addr.addr6.sin6_family = AF_INET6;
+    inet_pton(AF_INET6, ip.c_str(), & a.addr.addr6.sin6_addr);
+    a.addr.addr6.sin6_port = htons(port);
+    a.addr.addr6.sin6_scope_id = scope;
+    return a;
+}
+
+TEST_CASE("Session table / host address") {
+    auto a = make_address4(0xC0000201, 53);   // 192.0.2.1
+    auto b = make_address4(0xC0000201, 54);
+    auto c = make_address4(0xC0000202, 53);
+    auto d = make_address6("2001:db8::1", 53);
+    auto e = make_address6("2001:db8::1", 53, 1);
+
+    CHECK(a == make_address4(0xC0000201, 53));
+    CHECK(a != b);
+    CHECK(a < b);
+    CHECK(b < c);
+    CHECK(c < d);
+    CHECK(d != e);
+
+    // Ignored fields
+    auto f = d;
+    f.addr.addr6.sin6_flowinfo = 7;
+    CHECK(f == d);
+    CHECK(std::hash<host_address>{}(f) == std::hash<host_address>{}(d));
+
+    CHECK(to_string(a) == "192.0.2.1:53");
+    CHECK(to_string(d) == "[2001:db8::1]:53");
+    CHECK(to_string(make_address6("fe80::1", 80, if_nametoindex("lo"))) == "[fe80::1%lo]:80");
+    CHECK(to_string(host_address{}).empty());
+
+    std::set<host_address> ordered {a, b, c, d, e, a};
+    CHECK(ordered.size() == 5);
+
+    std::unordered_set<std::size_t> hashes;
+
+    for (std::uint32_t i = 0; i < 10000; i++)
+        hashes.insert(std::hash<host_address>{}(make_address4(0x0A000000 + i / 10, 1000 + i % 10)));
+
+    CHECK(hashes.size() == 10000);
+}
+
+// Degenerate hash, every key collides
+struct constant_hash
+{
+    std::size_t operator () (host_address const &) const { return 42; }
+};
+
+TEST_CASE("Session table / insert, find and erase") {
+    using std::chrono::seconds;
+    pfs::io::session_table<int>::time_point now;
+
+    for (bool collide: {false, true}) {
+        pfs::io::session_table<int, host_address, constant_hash> colliding {seconds{60}};
+        pfs::io::session_table<int> table {seconds{60}};
+        std::size_t const count = collide ? 500 : 100000;
+
+        auto touch = [&] (host_address const & peer) {
+            return collide ? colliding.touch(peer, now) : table.touch(peer, now);
+        };
+
+        auto find = [&] (host_address const & peer) {
+            return collide ? colliding.find(peer) : table.find(peer);
+        };
+
+        auto erase = [&] (host_address const & peer) {
+            return collide ? colliding.erase(peer) : table.erase(peer);
+        };
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            auto result = touch(make_address4(0x0A000000 + i, 5000));
+            REQUIRE(result.second);
+            *result.first = static_cast<int>(i);
+        }
+
+        CHECK((collide ? colliding.size() : table.size()) == count);
+        CHECK_FALSE(touch(make_address4(0x0A000000, 5000)).second);
+        CHECK(find(make_address4(0x0A000000, 5001)) == nullptr);
+
+        // Erase every other session
+        for (std::uint32_t i = 0; i < count; i += 2)
+            REQUIRE(erase(make_address4(0x0A000000 + i, 5000)));
+
+        CHECK_FALSE(erase(make_address4(0x0A000000, 5000)));
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            auto s = find(make_address4(0x0A000000 + i, 5000));
+
+            if (i % 2 == 0) {
+                REQUIRE(s == nullptr);
+            } else {
+                REQUIRE(s != nullptr);
+                CHECK(*s == static_cast<int>(i));
+            }
+        }
+
+        CHECK((collide ? colliding.size() : table.size()) == count / 2);
+    }
+}
+
+TEST_CASE("Session table / idle expiry") {
+    using std::chrono::seconds;
+    pfs::io::session_table<std::string> table {seconds{30}, 1000};
+    pfs::io::session_table<std::string>::time_point start;
+    auto capacity = table.capacity();
+
+    for (std::uint32_t i = 0; i < 1000; i++)
+        table.touch(make_address4(0x0A000000 + i, 7), start).first->assign(std::to_string(i));
+
+    CHECK(table.capacity() == capacity);
+
+    // Every third peer stays active
+    for (std::uint32_t i = 0; i < 1000; i += 3)
+        table.touch(make_address4(0x0A000000 + i, 7), start + seconds{20});
+
+    std::set<std::string> expired;
+    auto now = start + seconds{40};
+
+    // One sweep in steps of 64 slots
+    for (std::size_t i = 0; i < capacity / 64; i++) {
+        table.expire(now, 64, [&] (host_address const &, std::string & s) {
+            expired.insert(s);
+        });
+    }
+
+    CHECK(expired.size() == 666);
+    CHECK(table.size() == 334);
+
+    table.for_each([&] (host_address const & peer, std::string & s) {
+        auto i = ntohl(peer.addr.addr4.sin_addr.s_addr) - 0x0A000000;
+        CHECK(i % 3 == 0);
+        CHECK(s == std::to_string(i));
+    });
+
+    CHECK(table.expire(start + seconds{60}) == 334);
+    CHECK(table.empty());
+}
+
+TEST_CASE("Session table / UDP server") {
+    struct session
+    {
+        int datagrams {0};
+    };
+
+    auto server = pfs::io::make_udp_server("127.0.0.1", 41984, true);
+    auto a = pfs::io::make_static_udp_socket("127.0.0.1", 41984, false);
+    auto b = pfs::io::make_static_udp_socket("127.0.0.1", 41984, false);
+    pfs::io::error_code ec;
+
+    for (int i = 0; i < 3; i++)
+        a.write("a", 1, ec);
+
+    b.write("b", 1, ec);
+
+    pfs::io::session_table<session> sessions {std::chrono::seconds{60}};
+    char buf[16];
+    int received = 0;
+
+    for (int i = 0; i < 200 && received < 4; i++) {
+        pfs::io::udp_server::host_address sender;
+        auto n = server.read_from(buf, sizeof(buf), & sender, ec);
+
+        if (n > 0) {
+            sessions.touch(sender).first->datagrams++;
+            received++;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+
+    REQUIRE(received == 4);
+    CHECK(sessions.size() == 2);
+
+    std::map<std::string, int> counts;
+
+    sessions.for_each([&] (host_address const & peer, session & s) {
+        counts[to_string(peer).substr(0, 10)] += s.datagrams;
+    });
+
+    CHECK(counts["127.0.0.1:"] == 4);
+}
@@ -124,3 +124,54 @@ TEST_CASE("TCP socket / server") {
     server_thread.join();
     watchdog_thread.join();
 }
+
+TEST_CASE("TCP socket / timestamping") {
+    uint16_t const timestamping_port = 41997;
+
+    auto server = pfs::io::make_tcp_server("127.0.0.1", timestamping_port, false);
+    auto client = pfs::io::make_static_tcp_socket("127.0.0.1", timestamping_port, false);
+    auto & s = client.underlying();
+
+    pfs::io::error_code ec;
+    auto peer = server.accept(ec);
+    REQUIRE_FALSE(ec);
+
+    REQUIRE_FALSE(s.enable_timestamping());
+
+    // Kernel starts taking receive timestamps asynchronously
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+    auto realtime = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+    };
+
+    auto before = realtime();
+    REQUIRE(s.write("ping", 4, ec) == 4);
+
+    // Identifier is offset of the last byte written
+    std::uint32_t id = 0;
+    pfs::io::packet_timestamps tx;
+    bool taken = false;
+
+    for (int i = 0; i < 200 && !taken; i++) {
+        taken = s.read_tx_timestamp(id, tx, ec);
+
+        if (!taken)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    REQUIRE(taken);
+    CHECK(id == 3);
+    CHECK(tx.software >= before);
+
+    char buf[32];
+    CHECK(peer.read(buf, sizeof(buf), ec) == 4);
+    REQUIRE(peer.write("pong", 4, ec) == 4);
+
+    pfs::io::packet_timestamps rx;
+    REQUIRE(s.read(buf, sizeof(buf), rx, ec) == 4);
+    CHECK(std::string(buf, 4) == "pong");
+    CHECK(rx.software >= tx.software);
+    CHECK(rx.software <= realtime());
+}
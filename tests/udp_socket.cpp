@@ -10,15 +10,19 @@
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include "pfs/io/netdevice.hpp"
 #include "pfs/io/udp_server.hpp"
 #include "pfs/io/udp_socket.hpp"
 #include "utils.hpp"
+#include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <iostream>
 #include <mutex>
 #include <condition_variable>
+#include <string>
 #include <thread>
+#include <vector>
 
 static const std::string servername = "localhost";
 static uint16_t const port = 41972;
@@ -115,3 +119,435 @@ TEST_CASE("UDP socket / server") {
     server_thread.join();
     watchdog_thread.join();
 }
+
+static std::string const group = "239.255.41.72";
+static uint16_t const multicast_port = 41973;
+
+// No multicast-capable interface or route (e.g. isolated container)
+static bool multicast_unavailable (pfs::io::error_code const & ec)
+{
+    return ec == std::errc::no_such_device
+        || ec == std::errc::network_unreachable
+        || ec == std::errc::address_not_available;
+}
+
+// Polls nonblocking socket until datagram arrives or timeout expires
+static ssize_t receive (pfs::io::udp_server & s, char * buf, size_t n
+    , std::chrono::milliseconds timeout)
+{
+    pfs::io::error_code ec;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto rc = s.read(buf, n, ec);
+
+        if (rc != 0)
+            return rc;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return 0;
+}
+
+TEST_CASE("UDP socket / multicast") {
+    auto receiver = pfs::io::make_udp_server("0.0.0.0", multicast_port, true);
+    auto ec = receiver.join_group(group);
+
+    if (multicast_unavailable(ec)) {
+        MESSAGE("Multicast is not available: " << ec.message());
+        return;
+    }
+
+    REQUIRE_FALSE(ec);
+
+    // Second consumer on the same host and port
+    auto receiver2 = pfs::io::make_udp_server("0.0.0.0", multicast_port, true);
+    REQUIRE_FALSE(receiver2.join_group(group));
+
+    auto sender = pfs::io::make_static_udp_socket(group, multicast_port, false);
+    CHECK_FALSE(sender.underlying().set_multicast_ttl(1));
+    CHECK_FALSE(sender.underlying().set_multicast_loop(true));
+
+    std::string hello {"tick"};
+    ec.clear();
+    auto n = sender.write(hello.data(), hello.size(), ec);
+
+    if (n < 0 && multicast_unavailable(ec)) {
+        MESSAGE("Multicast send is not available: " << ec.message());
+        return;
+    }
+
+    REQUIRE(n == static_cast<ssize_t>(hello.size()));
+
+    char buf[32];
+    CHECK(receive(receiver, buf, sizeof(buf), std::chrono::seconds{2}) == 4);
+    CHECK(std::string(buf, 4) == hello);
+    CHECK(receive(receiver2, buf, sizeof(buf), std::chrono::seconds{2}) == 4);
+
+    // Loopback disabled
+    CHECK_FALSE(sender.underlying().set_multicast_loop(false));
+    sender.write(hello.data(), hello.size(), ec);
+    CHECK(receive(receiver, buf, sizeof(buf), std::chrono::milliseconds{200}) == 0);
+
+    // Left group
+    CHECK_FALSE(sender.underlying().set_multicast_loop(true));
+    CHECK_FALSE(receiver.leave_group(group));
+    sender.write(hello.data(), hello.size(), ec);
+    CHECK(receive(receiver2, buf, sizeof(buf), std::chrono::seconds{2}) == 4);
+    CHECK(receive(receiver, buf, sizeof(buf), std::chrono::milliseconds{200}) == 0);
+}
+
+TEST_CASE("UDP socket / source-specific multicast") {
+    auto receiver = pfs::io::make_udp_server("0.0.0.0", multicast_port + 1, true);
+
+    // Source is not a local address, so own datagrams are filtered out
+    auto ec = receiver.join_source_group("232.1.2.3", "198.51.100.7");
+
+    if (multicast_unavailable(ec)) {
+        MESSAGE("Multicast is not available: " << ec.message());
+        return;
+    }
+
+    REQUIRE_FALSE(ec);
+
+    auto sender = pfs::io::make_udp_socket("232.1.2.3", multicast_port + 1, false);
+    std::string hello {"tick"};
+    auto n = sender.write(hello.data(), hello.size(), ec);
+
+    if (n < 0 && multicast_unavailable(ec)) {
+        MESSAGE("Multicast send is not available: " << ec.message());
+        return;
+    }
+
+    char buf[32];
+    CHECK(receive(receiver, buf, sizeof(buf), std::chrono::milliseconds{200}) == 0);
+    CHECK_FALSE(receiver.leave_source_group("232.1.2.3", "198.51.100.7"));
+}
+
+TEST_CASE("UDP socket / multicast arguments") {
+    auto s = pfs::io::make_udp_server("0.0.0.0", multicast_port + 2, false);
+
+    CHECK(s.join_group("not an address") == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    CHECK(s.join_source_group(group, "::1") == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    CHECK(s.join_group(group, "nosuchif0"));
+    CHECK(s.set_multicast_interface("nosuchif0"));
+    CHECK_FALSE(s.set_multicast_interface("lo"));
+    CHECK_FALSE(s.set_multicast_ttl(4));
+}
+
+TEST_CASE("UDP socket / broadcast") {
+    auto targets = pfs::io::broadcast_addresses();
+
+    for (auto const & t: targets) {
+        MESSAGE("Broadcast: " << t.interface << " " << t.address);
+        CHECK(pfs::io::netdevice{t.interface}.broadcast_address() == t.address);
+    }
+
+    CHECK(pfs::io::netdevice{"lo"}.broadcast_address().empty());
+
+    if (targets.empty()) {
+        MESSAGE("No broadcast capable interface");
+        return;
+    }
+
+    uint16_t const broadcast_port = 41976;
+    auto receiver = pfs::io::make_udp_server("0.0.0.0", broadcast_port, true);
+    auto sender = pfs::io::make_static_udp_socket(targets[0].address, broadcast_port, false);
+    std::string beacon {"beacon"};
+    pfs::io::error_code ec;
+
+    // Not allowed by default
+    CHECK(sender.write(beacon.data(), beacon.size(), ec) < 0);
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::permission_denied));
+
+    REQUIRE_FALSE(sender.underlying().enable_broadcast());
+    ec.clear();
+    CHECK(sender.write(beacon.data(), beacon.size(), ec) == static_cast<ssize_t>(beacon.size()));
+
+    // Broadcast is looped back to local sockets
+    char buf[32];
+    CHECK(receive(receiver, buf, sizeof(buf), std::chrono::seconds{2}) == 6);
+}
+
+TEST_CASE("UDP socket / segmentation offload") {
+    uint16_t const offload_port = 41977;
+    size_t const segment_size = 1000;
+    size_t const segment_count = 100;
+
+    // The last datagram is shorter
+    std::string data;
+
+    for (size_t i = 0; i < segment_count; i++) {
+        data.append(i + 1 < segment_count ? segment_size : segment_size / 2
+            , static_cast<char>('a' + i % 26));
+    }
+
+    for (bool gro: {false, true}) {
+        auto receiver = pfs::io::make_udp_server("127.0.0.1", offload_port, true);
+
+        if (gro) {
+            auto ec = receiver.enable_receive_offload();
+
+            if (ec) {
+                MESSAGE("UDP receive offload is not available: " << ec.message());
+                continue;
+            }
+        }
+
+        auto sender = pfs::io::make_static_udp_socket("127.0.0.1", offload_port, false);
+        pfs::io::error_code ec;
+
+        CHECK(sender.underlying().write_segments(data.data(), data.size(), 0, ec) < 0);
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+
+        ec.clear();
+        REQUIRE(sender.underlying().write_segments(data.data(), data.size(), segment_size, ec)
+            == static_cast<ssize_t>(data.size()));
+
+        if (!sender.underlying().segmentation_offload())
+            MESSAGE("UDP segmentation offload is not available, datagrams are sent one by one");
+
+        std::vector<char> buf(64 * 1024);
+        std::string received;
+        size_t segments = 0;
+        size_t reads = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{2};
+
+        while (received.size() < data.size() && std::chrono::steady_clock::now() < deadline) {
+            size_t size = 0;
+            auto n = receiver.read_segments(buf.data(), buf.size(), size, ec);
+            REQUIRE(n >= 0);
+
+            if (n == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                continue;
+            }
+
+            REQUIRE(size > 0);
+            CHECK((gro || size == static_cast<size_t>(n)));
+
+            for (ssize_t offset = 0; offset < n; offset += static_cast<ssize_t>(size)) {
+                auto len = std::min(size, static_cast<size_t>(n - offset));
+
+                // Datagram boundaries are preserved
+                CHECK((len == segment_size || len == segment_size / 2));
+                CHECK(buf[offset] == buf[offset + len - 1]);
+                segments++;
+            }
+
+            received.append(buf.data(), static_cast<size_t>(n));
+            reads++;
+        }
+
+        CHECK(received == data);
+        CHECK(segments == segment_count);
+
+        // read_segments() does not change destination address
+        CHECK(receiver.address() == pfs::io::udp_server::host_address{});
+        MESSAGE("Receive offload " << (gro ? "on" : "off") << ": "
+            << segments << " datagrams in " << reads << " reads");
+    }
+}
+
+TEST_CASE("UDP socket / connected mode") {
+    uint16_t const connected_port = 41978;
+    auto server = pfs::io::make_udp_server("127.0.0.1", connected_port, true);
+    auto peer = pfs::io::make_static_udp_socket("127.0.0.1", connected_port, true);
+    auto stranger = pfs::io::make_static_udp_socket("127.0.0.1", connected_port, true);
+    pfs::io::error_code ec;
+    char buf[32];
+
+    // Client side
+    REQUIRE_FALSE(peer.underlying().connect());
+    CHECK(peer.underlying().connected());
+    REQUIRE(peer.write("hello", 5, ec) == 5);
+    REQUIRE(receive(server, buf, sizeof(buf), std::chrono::seconds{2}) == 5);
+    CHECK(std::string(buf, 5) == "hello");
+
+    // Server side bound to the sender of the datagram
+    pfs::io::udp_server::host_address sender;
+    REQUIRE(peer.write("again", 5, ec) == 5);
+
+    for (int i = 0; i < 200 && server.read_from(buf, sizeof(buf), & sender, ec) == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    // read() does not change destination address
+    CHECK(server.address() == pfs::io::udp_server::host_address{});
+
+    REQUIRE_FALSE(server.connect(sender));
+    CHECK(server.address() == sender);
+    CHECK(stranger.write("noise", 5, ec) == 5);
+    CHECK(peer.write("world", 5, ec) == 5);
+    REQUIRE(receive(server, buf, sizeof(buf), std::chrono::seconds{2}) == 5);
+    CHECK(std::string(buf, 5) == "world");
+    CHECK(receive(server, buf, sizeof(buf), std::chrono::milliseconds{100}) == 0);
+
+    // Reply without address
+    REQUIRE(server.write("reply", 5, ec) == 5);
+    ssize_t n = 0;
+
+    for (int i = 0; i < 200 && n == 0; i++) {
+        n = peer.read(buf, sizeof(buf), ec);
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    REQUIRE(n == 5);
+    CHECK(std::string(buf, 5) == "reply");
+
+    // Other senders are accepted again
+    REQUIRE_FALSE(server.disconnect());
+    CHECK_FALSE(server.connected());
+    CHECK(stranger.write("again", 5, ec) == 5);
+    REQUIRE(receive(server, buf, sizeof(buf), std::chrono::seconds{2}) == 5);
+    CHECK(std::string(buf, 5) == "again");
+
+    // Nobody listens: ICMP port unreachable is reported to connected socket
+    server.close();
+    peer.write("lost", 4, ec);
+    ec.clear();
+
+    for (int i = 0; i < 200 && !ec; i++) {
+        if (peer.write("lost", 4, ec) < 0)
+            break;
+
+        peer.read(buf, sizeof(buf), ec);
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::connection_refused));
+}
+
+TEST_CASE("UDP socket / packet info") {
+    uint16_t const pktinfo_port = 41979;
+
+    // Single socket serves all local addresses
+    auto server = pfs::io::make_udp_server("0.0.0.0", pktinfo_port, true);
+    REQUIRE_FALSE(server.enable_packet_info());
+
+    for (std::string local: {"127.0.0.1", "127.0.0.2"}) {
+        // Connected client accepts replies from the address it sent to only
+        auto client = pfs::io::make_static_udp_socket(local, pktinfo_port, true);
+        REQUIRE_FALSE(client.underlying().connect());
+
+        pfs::io::error_code ec;
+        REQUIRE(client.write("ping", 4, ec) == 4);
+
+        char buf[32];
+        pfs::io::udp_server::host_address from;
+        pfs::io::udp_server::packet_info info;
+        ssize_t n = 0;
+
+        for (int i = 0; i < 200 && n == 0; i++) {
+            n = server.read_from(buf, sizeof(buf), & from, & info, ec);
+
+            if (n == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+
+        REQUIRE(n == 4);
+        CHECK(info.local.addr.addr4.sin_family == AF_INET);
+        CHECK(info.local.addr.addr4.sin_addr.s_addr == inet_addr(local.c_str()));
+        CHECK(info.interface == if_nametoindex("lo"));
+
+        REQUIRE(server.write_to("pong", 4, & from, & info, ec) == 4);
+        n = 0;
+
+        for (int i = 0; i < 200 && n == 0; i++) {
+            n = client.read(buf, sizeof(buf), ec);
+
+            if (n == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+
+        REQUIRE(n == 4);
+        CHECK(std::string(buf, 4) == "pong");
+    }
+}
+
+TEST_CASE("UDP socket / timestamping") {
+    uint16_t const timestamping_port = 41996;
+
+    auto server = pfs::io::make_udp_server("127.0.0.1", timestamping_port, true);
+    auto client = pfs::io::make_static_udp_socket("127.0.0.1", timestamping_port, false);
+    auto & s = client.underlying();
+
+    REQUIRE_FALSE(server.enable_timestamping(pfs::io::rx_software_timestamp));
+    REQUIRE_FALSE(s.enable_timestamping(pfs::io::tx_software_timestamp));
+
+    // Kernel starts taking receive timestamps asynchronously
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+    auto realtime = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+    };
+
+    pfs::io::error_code ec;
+    auto before = realtime();
+
+    for (int i = 0; i < 3; i++)
+        REQUIRE(s.write("ping", 4, ec) == 4);
+
+    // Transmit timestamps of datagrams 0, 1, 2 (loopback takes them on send)
+    std::vector<std::uint32_t> ids;
+    pfs::io::packet_timestamps tx;
+
+    for (int i = 0; i < 200 && ids.size() < 3; i++) {
+        std::uint32_t id = 0;
+
+        if (s.read_tx_timestamp(id, tx, ec)) {
+            CHECK(tx.software >= before);
+            CHECK(tx.software <= realtime());
+            ids.push_back(id);
+        } else {
+            REQUIRE_FALSE(ec);
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+
+    CHECK(ids == (std::vector<std::uint32_t>{0, 1, 2}));
+
+    char buf[32];
+
+    for (int i = 0; i < 3; i++) {
+        pfs::io::packet_timestamps rx;
+        ssize_t n = 0;
+
+        for (int j = 0; j < 200 && n == 0; j++) {
+            n = server.read(buf, sizeof(buf), rx, ec);
+
+            if (n == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+
+        REQUIRE(n == 4);
+
+        // One-way latency measured by the kernel
+        CHECK(rx.software >= tx.software - std::chrono::milliseconds{1});
+        CHECK(rx.software <= realtime());
+        CHECK(rx.hardware.count() == 0);
+    }
+
+    // read() does not change destination address
+    CHECK(server.address() == pfs::io::udp_server::host_address{});
+
+    // Sender of a timestamped datagram
+    pfs::io::udp_server::host_address sender;
+    REQUIRE(s.write("ping", 4, ec) == 4);
+    REQUIRE(server.wait_for_read(std::chrono::milliseconds{1000}, ec));
+
+    pfs::io::packet_timestamps rx;
+    CHECK(server.read_from(buf, sizeof(buf), & sender, rx, ec) == 4);
+    CHECK(rx.software.count() > 0);
+    CHECK(sender != pfs::io::udp_server::host_address{});
+    CHECK(server.address() == pfs::io::udp_server::host_address{});
+
+    // Timestamps are not taken when disabled
+    REQUIRE_FALSE(server.enable_timestamping(0));
+    REQUIRE(s.write("ping", 4, ec) == 4);
+    REQUIRE(server.wait_for_read(std::chrono::milliseconds{1000}, ec));
+
+    CHECK(server.read(buf, sizeof(buf), rx, ec) == 4);
+    CHECK(rx.software.count() == 0);
+}
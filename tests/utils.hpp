@@ -7,9 +7,12 @@
 //
 // Changelog:
 //      2019.??.?? Initial version
+//      2026.10.19 Added tmp_path() and read_all()
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/io/operationsystem.h"
+#include "pfs/io/file.hpp"
+#include <string>
 
 #if defined(PFS_OS_WIN)
     // TODO Implement using GetTempPath()
@@ -35,6 +38,24 @@
 #   error "Unsupported operation system"
 #endif
 
+inline std::string tmp_path (std::string const & name)
+{
+    return tmp_dir() + "/" + name;
+}
+
+inline std::string read_all (std::string const & path)
+{
+    auto d = pfs::io::make_file(path, pfs::io::read_only);
+    std::string result;
+    char buf[4096];
+    ssize_t n = 0;
+
+    while ((n = d.read(buf, sizeof(buf))) > 0)
+        result.append(buf, n);
+
+    return result;
+}
+
 static char loremipsum[] =
 "1.Lorem ipsum dolor sit amet, consectetuer adipiscing elit,    \n\
 2.sed diam nonummy nibh euismod tincidunt ut laoreet dolore     \n\
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/varint_bulk.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<pfs::io::simd_isa> const ISAS {
+      pfs::io::simd_isa::scalar
+    , pfs::io::simd_isa::sse41
+    , pfs::io::simd_isa::avx2
+};
+
+// Values of every encoded length, runs of small values in between
+static std::vector<std::uint64_t> sample_values ()
+{
+    std::mt19937_64 gen {42};
+    std::vector<std::uint64_t> values;
+
+    for (int run = 0; run < 50; run++) {
+        for (int i = 0; i < 40; i++)
+            values.push_back(gen() & 0x7F);
+
+        for (int bits = 1; bits <= 64; bits++)
+            values.push_back(bits == 64 ? gen() : gen() & ((std::uint64_t{1} << bits) - 1));
+
+        values.push_back(~std::uint64_t{0});
+        values.push_back(std::uint64_t{1} << 56);
+    }
+
+    return values;
+}
+
+static std::string encode_reference (std::vector<std::uint64_t> const & values)
+{
+    std::string result;
+    char buf[pfs::io::varint_max_size];
+
+    for (auto v: values)
+        result.append(buf, pfs::io::encode_varint(v, buf));
+
+    return result;
+}
+
+TEST_CASE("Varint bulk / encode") {
+    auto values = sample_values();
+    auto expected = encode_reference(values);
+
+    for (auto isa: ISAS) {
+        auto kernels = pfs::io::details::select_varint_kernels(isa);
+
+        for (size_t count: {size_t{0}, size_t{1}, size_t{17}, values.size()}) {
+            std::vector<std::uint64_t> part(values.begin(), values.begin() + count);
+            std::string out(count * pfs::io::varint_max_size, '\0');
+            auto n = kernels.encode(part.data(), part.size(), & out[0]);
+
+            CHECK(out.substr(0, n) == encode_reference(part));
+        }
+    }
+
+    std::string out(values.size() * pfs::io::varint_max_size, '\0');
+    auto n = pfs::io::encode_varints(values.data(), values.size(), & out[0]);
+    CHECK(out.substr(0, n) == expected);
+}
+
+TEST_CASE("Varint bulk / decode") {
+    auto values = sample_values();
+    auto encoded = encode_reference(values);
+
+    for (auto isa: ISAS) {
+        auto kernels = pfs::io::details::select_varint_kernels(isa);
+        pfs::io::error_code ec;
+
+        // Whole input
+        {
+            std::vector<std::uint64_t> out(values.size() + 1);
+            char const * first = encoded.data();
+            auto n = kernels.decode(first, encoded.data() + encoded.size(), out.data(), out.size(), ec);
+
+            CHECK_FALSE(ec);
+            CHECK(n == values.size());
+            CHECK(first == encoded.data() + encoded.size());
+            out.resize(n);
+            CHECK(out == values);
+        }
+
+        // Limited count
+        {
+            std::vector<std::uint64_t> out(33);
+            char const * first = encoded.data();
+            auto n = kernels.decode(first, encoded.data() + encoded.size(), out.data(), out.size(), ec);
+
+            CHECK(n == out.size());
+            CHECK(std::vector<std::uint64_t>(values.begin(), values.begin() + n) == out);
+            CHECK(static_cast<size_t>(first - encoded.data()) == encode_reference(out).size());
+        }
+
+        // Incomplete last value is left in input
+        {
+            std::string truncated = encoded.substr(0, encoded.size() - 1);
+            std::vector<std::uint64_t> out(values.size());
+            char const * first = truncated.data();
+            auto n = kernels.decode(first, truncated.data() + truncated.size(), out.data(), out.size(), ec);
+
+            CHECK_FALSE(ec);
+            CHECK(n == values.size() - 1);
+            CHECK(first == truncated.data() + encode_reference(
+                std::vector<std::uint64_t>(values.begin(), values.end() - 1)).size());
+        }
+
+        // Malformed value after valid ones
+        {
+            std::string bad = std::string(40, '\x01') + std::string(11, '\xFF') + std::string(40, '\x01');
+            std::vector<std::uint64_t> out(100);
+            char const * first = bad.data();
+            auto n = kernels.decode(first, bad.data() + bad.size(), out.data(), out.size(), ec);
+
+            CHECK(ec == pfs::io::make_error_code(pfs::io::errc::bad_message));
+            CHECK(n == 40);
+            CHECK(first == bad.data() + 40);
+            ec.clear();
+        }
+    }
+
+    // Span interface
+    pfs::io::bytes_view input {encoded};
+    std::vector<std::uint64_t> out(10);
+    pfs::io::error_code ec;
+    CHECK(pfs::io::decode_varints(input, out.data(), out.size(), ec) == 10);
+    CHECK(input.size() < encoded.size());
+    CHECK(pfs::io::decode_varints(input, out.data(), out.size(), ec) == 10);
+    CHECK(out[0] == values[10]);
+}
+
+TEST_CASE("Varint bulk / zigzag") {
+    std::vector<std::int64_t> values;
+    std::mt19937_64 gen {7};
+
+    for (int i = 0; i < 1000; i++)
+        values.push_back(static_cast<std::int64_t>(gen()) >> (i % 64));
+
+    values.push_back(INT64_MIN);
+    values.push_back(INT64_MAX);
+    values.push_back(-1);
+    values.push_back(0);
+
+    for (auto isa: ISAS) {
+        auto kernels = pfs::io::details::select_varint_kernels(isa);
+        std::vector<std::uint64_t> encoded(values.size());
+        std::vector<std::int64_t> decoded(values.size());
+
+        kernels.zigzag_encode(values.data(), values.size(), encoded.data());
+
+        for (size_t i = 0; i < values.size(); i++)
+            CHECK(encoded[i] == pfs::io::zigzag_encode(values[i]));
+
+        kernels.zigzag_decode(encoded.data(), encoded.size(), decoded.data());
+        CHECK(decoded == values);
+    }
+}
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of [io-lib](https://github.com/semenovf/io-lib) library.
+//
+// Changelog:
+//      2026.10.18 Initial version
+//      2026.10.18 Concurrent append test asserts batching
+//      2026.10.19 Torn record in a non-last segment
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/io/wal.hpp"
+#include "utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string wal_dir (char const * name)
+{
+    auto dir = tmp_dir() + "/" + name;
+    std::vector<std::string> names;
+
+    // Start from empty log
+    if (!pfs::io::platform::file::list_directory(dir, names)) {
+        for (auto const & n: names)
+            pfs::io::platform::file::remove_file(dir + "/" + n);
+    }
+
+    return dir;
+}
+
+static std::vector<std::string> read_records (std::string const & dir
+    , pfs::io::wal_position const & from = pfs::io::wal_position{})
+{
+    std::vector<std::string> result;
+    pfs::io::wal_reader reader {dir};
+
+    auto ec = reader.for_each([& result] (pfs::io::wal_position const &
+            , char const * data, size_t n) {
+        result.emplace_back(data, n);
+    }, from);
+
+    REQUIRE(!ec);
+    return result;
+}
+
+TEST_CASE("WAL / crc32c") {
+    // RFC 3720, B.4
+    std::string zeros(32, '\x00');
+    std::string ones(32, '\xFF');
+    CHECK(pfs::io::crc32c(zeros.data(), zeros.size()) == 0x8A9136AA);
+    CHECK(pfs::io::crc32c(ones.data(), ones.size()) == 0x62A8AB43);
+    CHECK(pfs::io::crc32c("123456789", 9) == 0xE3069283);
+
+    // Incremental calculation
+    CHECK(pfs::io::crc32c(pfs::io::crc32c("1234", 4), "56789", 5) == 0xE3069283);
+}
+
+TEST_CASE("WAL / append and read") {
+    auto dir = wal_dir("wal_basic");
+    pfs::io::wal_options options;
+    options.segment_size = 64 * 1024;
+
+    {
+        auto w = pfs::io::make_wal_writer(dir, options);
+
+        auto pos1 = w->append("hello", 5);
+        auto pos2 = w->append("", 0);
+        auto pos3 = w->append(loremipsum, sizeof(loremipsum) - 1);
+
+        CHECK(pos1.segment == 0);
+        CHECK(pos1.offset == 0);
+        CHECK(pos2.offset == 13);
+        CHECK(pos3.offset == 21);
+
+        pfs::io::error_code ec;
+        std::string huge(options.segment_size, 'x');
+        w->append(huge.data(), huge.size(), ec);
+        CHECK(ec == pfs::io::make_error_code(pfs::io::errc::invalid_argument));
+    }
+
+    auto records = read_records(dir);
+    REQUIRE(records.size() == 3);
+    CHECK(records[0] == "hello");
+    CHECK(records[1] == "");
+    CHECK(records[2] == std::string(loremipsum));
+
+    // Reopen and continue
+    {
+        auto w = pfs::io::make_wal_writer(dir, options);
+        auto pos = w->append("world", 5);
+        CHECK(pos.segment == 0);
+        CHECK(pos.offset == 21 + 8 + static_cast<pfs::io::offset_type>(sizeof(loremipsum) - 1));
+    }
+
+    records = read_records(dir);
+    REQUIRE(records.size() == 4);
+    CHECK(records[3] == "world");
+}
+
+TEST_CASE("WAL / rotation and truncation") {
+    auto dir = wal_dir("wal_rotation");
+    pfs::io::wal_options options;
+    options.segment_size = 4096;
+
+    std::string payload(1000, 'r');
+    std::vector<pfs::io::wal_position> positions;
+
+    auto w = pfs::io::make_wal_writer(dir, options);
+
+    for (int i = 0; i < 10; i++) {
+        payload[0] = static_cast<char>('0' + i);
+        positions.push_back(w->append(payload.data(), payload.size()));
+    }
+
+    // Four 1008-byte records per segment
+    CHECK(positions[3].segment == 0);
+    CHECK(positions[4].segment == 1);
+    CHECK(positions[4].offset == 0);
+    CHECK(positions[9].segment == 2);
+
+    auto records = read_records(dir);
+    REQUIRE(records.size() == 10);
+
+    for (int i = 0; i < 10; i++)
+        CHECK(records[i][0] == static_cast<char>('0' + i));
+
+    records = read_records(dir, positions[5]);
+    REQUIRE(records.size() == 5);
+    CHECK(records[0][0] == '5');
+
+    REQUIRE(!w->truncate_before(2));
+    records = read_records(dir);
+    REQUIRE(records.size() == 2);
+    CHECK(records[0][0] == '8');
+
+    // Current segment is never removed
+    REQUIRE(!w->truncate_before(100));
+    CHECK(read_records(dir).size() == 2);
+}
+
+TEST_CASE("WAL / torn tail recovery") {
+    auto dir = wal_dir("wal_torn");
+    pfs::io::wal_options options;
+    options.segment_size = 64 * 1024;
+    pfs::io::wal_position pos;
+
+    {
+        auto w = pfs::io::make_wal_writer(dir, options);
+        w->append("first", 5);
+        pos = w->append("second", 6);
+    }
+
+    // Corrupt payload of the last record
+    {
+        auto f = pfs::io::make_static_file(dir + "/0000000000000000.wal"
+            , pfs::io::read_write);
+        pfs::io::error_code ec;
+        REQUIRE(f.underlying().write_at("X", 1, pos.offset + 8, ec) == 1);
+    }
+
+    auto records = read_records(dir);
+    REQUIRE(records.size() == 1);
+    CHECK(records[0] == "first");
+
+    // Torn record is overwritten, a shorter record must not expose its tail
+    {
+        auto w = pfs::io::make_wal_writer(dir, options);
+        CHECK(w->tail() == pos);
+        w->append("3", 1);
+    }
+
+    records = read_records(dir);
+    REQUIRE(records.size() == 2);
+    CHECK(records[1] == "3");
+}
+
+TEST_CASE("WAL / corrupted segment") {
+    auto dir = wal_dir("wal_corrupted");
+    pfs::io::wal_options options;
+    options.segment_size = 4096;
+
+    std::string payload(1000, 'c');
+    std::vector<pfs::io::wal_position> positions;
+
+    {
+        auto w = pfs::io::make_wal_writer(dir, options);
+
+        for (int i = 0; i < 6; i++)
+            positions.push_back(w->append(payload.data(), payload.size()));
+    }
+
+    REQUIRE(positions[5].segment == 1);
+
+    // Corrupt payload of a record in the first (complete) segment
+    {
+        auto f = pfs::io::make_static_file(dir + "/0000000000000000.wal"
+            , pfs::io::read_write);
+        pfs::io::error_code ec;
+        REQUIRE(f.underlying().write_at("X", 1, positions[2].offset + 8, ec) == 1);
+    }
+
+    int count = 0;
+    pfs::io::wal_reader reader {dir};
+
+    auto ec = reader.for_each([& count] (pfs::io::wal_position const &
+            , char const *, size_t) {
+        count++;
+    });
+
+    CHECK(ec == pfs::io::make_error_code(pfs::io::errc::data_corruption));
+    CHECK(count == 2);
+}
+
+TEST_CASE("WAL / concurrent append") {
+    auto dir = wal_dir("wal_concurrent");
+    pfs::io::wal_options options;
+    options.segment_size = 64 * 1024;
+
+    // Slow commits: appenders pile up while the leader waits
+    options.commit_delay = std::chrono::milliseconds{1};
+
+    int const thread_count = 8;
+    int const record_count = 200;
+
+    auto w = pfs::io::make_wal_writer(dir, options);
+    std::vector<std::thread> threads;
+    std::atomic<int> failures {0};
+
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([& w, & failures, t, record_count] {
+            pfs::io::error_code ec;
+
+            for (int i = 0; i < record_count; i++) {
+                auto rec = std::to_string(t) + ":" + std::to_string(i);
+                w->append(rec.data(), rec.size(), ec);
+
+                if (ec)
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto & th: threads)
+        th.join();
+
+    REQUIRE(failures == 0);
+
+    // Writers are batched, so there are less flushes than records
+    CHECK(w->commit_count() < static_cast<std::uint64_t>(thread_count * record_count));
+
+    // All records present, order of each writer preserved
+    std::map<int, int> next;
+
+    for (auto const & rec: read_records(dir)) {
+        auto colon = rec.find(':');
+        REQUIRE(colon != std::string::npos);
+        auto t = std::stoi(rec.substr(0, colon));
+        auto i = std::stoi(rec.substr(colon + 1));
+        CHECK(next[t] == i);
+        next[t] = i + 1;
+    }
+
+    REQUIRE(next.size() == static_cast<size_t>(thread_count));
+
+    for (auto const & item: next)
+        CHECK(item.second == record_count);
+}